@@ -5,6 +5,7 @@
 #include <QCoreApplication>
 #include <QMessageBox>
 #include <stack>
+#include <unordered_map>
 
 using namespace FlowShopVis::DD;
 using namespace fms::dd;
@@ -19,14 +20,37 @@ GraphWidget::GraphWidget(QWidget *parent) : BasicGraphWidget(parent) {}
 
 void GraphWidget::setDDData(std::shared_ptr<fms::solvers::dd::DDSolverData> data) {
     this->data = std::move(data);
+    m_history = nullptr;
     clear();
 
     if (!this->data) {
         return;
     }
 
+    // The states are not discarded, so their records are created when needed
+    setStates(this->data->allStates.size(), [data = this->data](std::size_t position) {
+        return HistoryRecord::create(*data->allStates.at(position), data->dg, StateFate::QUEUED);
+    });
+}
+
+void GraphWidget::setHistory(std::shared_ptr<fms::dd::HistoryReader> history) {
+    m_history = std::move(history);
+    data = nullptr;
+    clear();
+
+    if (!m_history) {
+        return;
+    }
+
+    setStates(m_history->size(),
+              [history = m_history](std::size_t position) { return history->at(position); });
+}
+
+void GraphWidget::setStates(std::size_t nrStates, StateLookup lookup) {
+    m_lookup = std::move(lookup);
+
     m_positionsWorker = new PositionsWorker(this);
-    m_positionsWorker->setData(this->data);
+    m_positionsWorker->setStates(nrStates, m_lookup);
     m_positionsWorker->setNodeXSpace(kNodeHorizontalSpacing);
     m_positionsWorker->setNodeYSpace(kNodeVerticalPadding);
     connect(m_positionsWorker,
@@ -36,7 +60,7 @@ void GraphWidget::setDDData(std::shared_ptr<fms::solvers::dd::DDSolverData> data
     connect(m_positionsWorker, &PositionsWorker::error, this, &GraphWidget::error);
 
     m_progressDialog = new QProgressDialog(
-            "Calculating positions...", {}, 0, 2 * this->data->allStates.size(), this);
+            "Calculating positions...", {}, 0, static_cast<int>(2 * nrStates), this);
     m_progressDialog->setWindowModality(Qt::WindowModal);
     connect(m_positionsWorker,
             &PositionsWorker::progress,
@@ -50,8 +74,7 @@ void GraphWidget::setDDData(std::shared_ptr<fms::solvers::dd::DDSolverData> data
 void GraphWidget::clear() {
     BasicGraphWidget::clear();
 
-    m_edges.clear();
-    m_rootId = std::nullopt;
+    m_tree = {};
 }
 
 Node *GraphWidget::addNode(VertexId id, QPointF pos, QRectF &boundingBox) {
@@ -68,8 +91,7 @@ void GraphWidget::positionsCalculated() {
     }
 
     auto positions = std::move(m_positionsWorker->positions());
-    m_edges = std::move(m_positionsWorker->edges());
-    m_rootId = m_positionsWorker->rootId();
+    m_tree = std::move(m_positionsWorker->tree());
 
     m_positionsWorker->deleteLater();
     m_positionsWorker = nullptr;
@@ -80,11 +102,12 @@ void GraphWidget::positionsCalculated() {
     QCoreApplication::processEvents();
 
     QRectF boundingBox;
-    std::vector<Node *> nodes(positions.size(), nullptr);
+    std::unordered_map<VertexId, Node *> nodes;
+    nodes.reserve(positions.size());
     std::size_t i = 0;
     for (const auto &[id, pos] : positions) {
         auto *const node = addNode(id, pos, boundingBox);
-        nodes.at(id) = node;
+        nodes.emplace(id, node);
 
         if (i % 10 == 0) {
             m_progressDialog->setValue(i + 1);
@@ -94,26 +117,24 @@ void GraphWidget::positionsCalculated() {
     }
 
     std::size_t totalEdges = 0;
-    for (const auto &edges : m_edges) {
-        totalEdges += edges.size();
+    for (const auto &[_, children] : m_tree.children) {
+        totalEdges += children.size();
     }
 
     m_progressDialog->setLabelText("Adding edges to graph");
     m_progressDialog->setMaximum(totalEdges);
 
     i = 0;
-    for (std::size_t vFrom = 0; vFrom < m_edges.size(); ++vFrom) {
+    for (const auto &[vFrom, children] : m_tree.children) {
         auto *const nodeFrom = nodes.at(vFrom);
-        for (const auto &vTo : m_edges.at(vFrom)) {
+        for (const auto &vTo : children) {
             auto *const nodeTo = nodes.at(vTo);
 
-            const auto stateTo = data->allStates.at(vTo);
-            const auto dgVId = stateTo->getLastScheduledOperation();
+            const auto lastOperation = m_lookup(m_tree.positions.at(vTo)).lastOperation;
 
             QString edgeLabel;
-            if (dgVId.has_value() && data->dg.isVisible(*dgVId)) {
-                const auto op = data->dg.getOperation(dgVId.value());
-                edgeLabel = QString::fromStdString(fmt::to_string(op));
+            if (lastOperation.has_value()) {
+                edgeLabel = QString::fromStdString(fmt::to_string(*lastOperation));
             }
 
             auto *edge = new FlowShopVis::Edge(nodeFrom, nodeTo, edgeLabel);
@@ -129,7 +150,7 @@ void GraphWidget::positionsCalculated() {
 
     setSceneRect(adjustMargin(boundingBox));
 
-    auto *const rootNode = nodes.at(m_rootId.value());
+    auto *const rootNode = nodes.at(m_tree.roots.front());
     centerOn(rootNode);
 
     m_progressDialog->deleteLater();
@@ -22,16 +22,22 @@ public:
 
     void setDDData(std::shared_ptr<fms::solvers::dd::DDSolverData> data);
 
+    /// @brief Plots the states of a history file, which are read when they are needed
+    void setHistory(std::shared_ptr<fms::dd::HistoryReader> history);
+
     void clear() override;
 
 private:
     Node *addNode(fms::dd::VertexId id, QPointF pos, QRectF &boundingBox);
 
+    void setStates(std::size_t nrStates, StateLookup lookup);
+
     std::shared_ptr<fms::solvers::dd::DDSolverData> data;
+    std::shared_ptr<fms::dd::HistoryReader> m_history;
+    StateLookup m_lookup;
 
-    // std::unordered_map<fms::DD::VertexId, std::deque<fms::DD::VertexId>> m_edges;
-    std::vector<std::vector<fms::dd::VertexId>> m_edges;
-    std::optional<fms::dd::VertexId> m_rootId;
+    /// Positions of the records and children of the plotted states
+    fms::dd::HistoryTree m_tree;
 
     PositionsWorker *m_positionsWorker = nullptr;
     QProgressDialog *m_progressDialog = nullptr;
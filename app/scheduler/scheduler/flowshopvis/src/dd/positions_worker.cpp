@@ -14,52 +14,37 @@ using namespace FlowShopVis::DD;
 using namespace fms::dd;
 
 void PositionsWorker::run() {
-    std::optional<VertexId> maxId = std::nullopt;
-
-    std::unordered_map<std::size_t, std::vector<fms::dd::VertexId>> depthLevels;
-    std::optional<fms::dd::VertexId> rootId;
-    m_edges.resize(m_data->allStates.size());
-
-    for (const auto &vertex : m_data->allStates) {
-        depthLevels[vertex->vertexDepth()].push_back(vertex->id());
-        maxId = std::max(maxId.value_or(0), vertex->id());
-        if (vertex->id() != vertex->parentId()) {
-            m_edges.at(vertex->parentId()).push_back(vertex->id());
-        } else {
-            rootId = vertex->id();
-        }
-    }
+    m_tree = HistoryTree::build(m_nrStates, m_lookup);
 
-    if (!rootId.has_value()) {
+    if (m_tree.roots.empty()) {
         emit error("No root node found");
         return;
     }
 
-    if (maxId.value() != m_data->allStates.size() - 1) {
-        emit error("Not all nodes are present");
-        return;
+    // A resumed history has a tree for each state of the checkpoint, placed side by side
+    NodesSize nodesWidth;
+    qreal xMin = 0;
+    for (const auto rootId : m_tree.roots) {
+        computeNodesWidth(rootId, nodesWidth);
+        calculatePositions(rootId, xMin, nodesWidth);
+        const auto itWidth = nodesWidth.find(rootId);
+        xMin += static_cast<qreal>(itWidth == nodesWidth.end() ? 1 : itWidth->second)
+                * m_nodeXSpace;
     }
-
-    auto nodesWidth = computeNodesWidth(*rootId);
-    calculatePositions(*rootId, nodesWidth);
-    m_rootId = rootId;
     emit positionsCalculated();
 }
 
-PositionsWorker::NodesSize PositionsWorker::computeNodesWidth(VertexId rootId) const {
+void PositionsWorker::computeNodesWidth(VertexId rootId, NodesSize &nodesWidth) const {
     // Non-recursive post-order traversal of the tree
     std::stack<std::tuple<VertexId, bool>> stack;
-    std::unordered_map<VertexId, std::size_t> nodesWidth;
-    qlonglong count = 1;
+    // The nodes of the previous trees are already placed
+    auto count = static_cast<qlonglong>(m_positions.size()) + 1;
 
     stack.emplace(rootId, false);
     while (!stack.empty()) {
         auto &[id, visited] = stack.top();
 
-        // const auto itChild = m_edges.find(id);
-
-        const auto &children = m_edges.at(id);
-        // if (!visited && itChild != m_edges.end()) {
+        const auto &children = m_tree.childrenOf(id);
         if (!visited && !children.empty()) {
             visited = true;
             for (const auto &child : children) {
@@ -68,6 +53,7 @@ PositionsWorker::NodesSize PositionsWorker::computeNodesWidth(VertexId rootId) c
 
             continue;
         }
+        const auto nodeId = id;
         stack.pop();
         emit progress(count);
         count++;
@@ -87,15 +73,15 @@ PositionsWorker::NodesSize PositionsWorker::computeNodesWidth(VertexId rootId) c
                 width += itChildWidth->second;
             }
         }
-        nodesWidth.emplace(id, width);
+        nodesWidth.emplace(nodeId, width);
     }
-
-    return nodesWidth;
 }
 
-void PositionsWorker::calculatePositions(VertexId rootId, NodesSize nodesWidth) {
+void PositionsWorker::calculatePositions(VertexId rootId,
+                                         qreal xMin,
+                                         const NodesSize &nodesWidth) {
     std::stack<std::tuple<VertexId, qreal>> stack;
-    stack.emplace(rootId, 0);
+    stack.emplace(rootId, xMin);
 
     const auto computeWidth = [&nodesWidth, this](VertexId id) {
         const auto itWidth = nodesWidth.find(id);
@@ -104,28 +90,26 @@ void PositionsWorker::calculatePositions(VertexId rootId, NodesSize nodesWidth)
     };
 
     while (!stack.empty()) {
-        auto &[id, xMin] = stack.top();
+        const auto [id, xStart] = stack.top();
         stack.pop();
 
-        const auto node = m_data->allStates.at(id);
+        const auto node = m_lookup(m_tree.positions.at(id));
 
         const qreal xWidth = computeWidth(id);
-        const qreal xPos = xMin + xWidth / 2.;
-        const qreal yPos = static_cast<qreal>(node->vertexDepth()) * m_nodeYSpace;
+        const qreal xPos = xStart + xWidth / 2.;
+        const qreal yPos = static_cast<qreal>(node.depth) * m_nodeYSpace;
 
         m_positions.emplace(id, QPointF(xPos, yPos));
-        emit progress(m_data->allStates.size() + static_cast<qlonglong>(m_positions.size()));
+        emit progress(static_cast<qlonglong>(m_nrStates + m_positions.size()));
 
-        // const auto itChilds = m_edges.find(id);
-        const auto children = m_edges.at(id);
-        // if (itChilds == m_edges.end()) {
+        const auto &children = m_tree.childrenOf(id);
         if (children.empty()) {
             // Node is a leaf
             continue;
         }
 
         // Node has children
-        qreal xOffset = xMin;
+        qreal xOffset = xStart;
         for (const auto &child : children) {
             const auto width = computeWidth(child);
             stack.emplace(child, xOffset);
@@ -1,21 +1,29 @@
 #ifndef FLOWSHOPVIS_DD_POSITIONS_WORKER_HPP
 #define FLOWSHOPVIS_DD_POSITIONS_WORKER_HPP
 
+#include <fms/dd/state_history.hpp>
 #include <fms/dd/vertex.hpp>
-#include <fms/solvers/dd.hpp>
 
 #include <QPointF>
 #include <QThread>
 
+#include <functional>
+
 namespace FlowShopVis::DD {
+
+/// @brief Returns the record at the given position. The positions go from 0 to the number of
+/// states minus one, the ids of the states may have gaps.
+using StateLookup = fms::dd::HistoryTree::RecordLookup;
+
 /// @brief Worker class to calculate the positions of the nodes in the DD
 class PositionsWorker : public QThread {
     Q_OBJECT
 public:
     PositionsWorker(QObject *parent = nullptr) : QThread(parent) {}
 
-    void setData(std::shared_ptr<fms::solvers::dd::DDSolverData> data) noexcept {
-        m_data = std::move(data);
+    void setStates(std::size_t nrStates, StateLookup lookup) noexcept {
+        m_nrStates = nrStates;
+        m_lookup = std::move(lookup);
     }
 
     /// @brief Horizontal space that a node takes
@@ -30,13 +38,8 @@ public:
         return m_positions;
     }
 
-    [[nodiscard]] inline std::vector<std::vector<fms::dd::VertexId>> &edges() noexcept {
-        return m_edges;
-    }
-
-    [[nodiscard]] inline std::optional<fms::dd::VertexId> rootId() const noexcept {
-        return m_rootId;
-    }
+    /// @brief Positions of the records and children of the states
+    [[nodiscard]] inline fms::dd::HistoryTree &tree() noexcept { return m_tree; }
 
     void run() override;
 
@@ -51,18 +54,18 @@ private:
     qreal m_nodeXSpace = 0;
     qreal m_nodeYSpace = 0;
 
-    std::shared_ptr<fms::solvers::dd::DDSolverData> m_data;
+    std::size_t m_nrStates = 0;
+    StateLookup m_lookup;
 
-    // std::unordered_map<fms::DD::VertexId, std::deque<fms::DD::VertexId>> m_edges;
-    std::vector<std::vector<fms::dd::VertexId>> m_edges;
+    fms::dd::HistoryTree m_tree;
 
     std::unordered_map<fms::dd::VertexId, QPointF> m_positions;
 
-    std::optional<fms::dd::VertexId> m_rootId;
-
-    [[nodiscard]] NodesSize computeNodesWidth(fms::dd::VertexId rootId) const;
+    /// @brief Adds the width of the nodes of the tree of @p rootId to @p nodesWidth
+    void computeNodesWidth(fms::dd::VertexId rootId, NodesSize &nodesWidth) const;
 
-    void calculatePositions(fms::dd::VertexId rootId, NodesSize nodesWidth);
+    /// @brief Places the tree of @p rootId from @p xMin
+    void calculatePositions(fms::dd::VertexId rootId, qreal xMin, const NodesSize &nodesWidth);
 };
 } // namespace FlowShopVis::DD
 
@@ -24,3 +24,9 @@ void Window::setData(std::shared_ptr<fms::solvers::dd::DDSolverData> data,
     m_instance = std::move(instance);
     m_graphWidget->setDDData(std::move(data));
 }
+
+void Window::setHistory(std::shared_ptr<fms::dd::HistoryReader> history) {
+    m_data = nullptr;
+    m_instance = nullptr;
+    m_graphWidget->setHistory(std::move(history));
+}
@@ -5,6 +5,8 @@
 #include <QVBoxLayout>
 #include <QWidget>
 
+#include <memory>
+
 namespace fms::solvers::dd {
 struct DDSolverData;
 } // namespace algorithms::DDSolver
@@ -13,6 +15,10 @@ namespace fms::problem {
 class Instance;
 } // namespace fms::problem
 
+namespace fms::dd {
+class HistoryReader;
+} // namespace fms::dd
+
 namespace FlowShopVis::DD {
 
 class GraphWidget;
@@ -28,6 +34,8 @@ public:
     void setData(std::shared_ptr<fms::solvers::dd::DDSolverData> data,
                  std::shared_ptr<fms::problem::Instance> instance);
 
+    void setHistory(std::shared_ptr<fms::dd::HistoryReader> history);
+
 private:
     GraphWidget *m_graphWidget;
 
@@ -1,11 +1,13 @@
 #include "flowshopvismainwindow.hpp"
 #include "ui_flowshopvismainwindow.h"
 
+#include "dd/window.hpp"
 #include "flowshopwidget.hpp"
 #include "graph/dot_parser.hpp"
 #include "production_line/production_line_widget.hpp"
 
 #include <fms/cg/builder.hpp>
+#include <fms/dd/state_history.hpp>
 #include <fms/problem/xml_parser.hpp>
 #include <fms/solvers/dd.hpp>
 
@@ -120,6 +122,19 @@ void FlowshopVisMainWindow::openDotGraph(const QString &fileName) {
     ui->tabWidget->setCurrentIndex(ui->tabWidget->addTab(w, QFileInfo(fileName).fileName()));
 }
 
+void FlowshopVisMainWindow::openDDHistory(const QString &fileName) {
+    if (fileName == QString()) {
+        return;
+    }
+
+    auto history = std::make_shared<fms::dd::HistoryReader>(fileName.toStdString());
+    auto *ddWindow = new FlowShopVis::DD::Window(this);
+    ddWindow->setAttribute(Qt::WA_DeleteOnClose);
+    ddWindow->setWindowTitle(QFileInfo(fileName).fileName());
+    ddWindow->setHistory(std::move(history));
+    ddWindow->show();
+}
+
 void FlowshopVisMainWindow::on_tabWidget_tabCloseRequested(int index) {
     ui->tabWidget->removeTab(index);
 
@@ -146,11 +161,12 @@ void FlowshopVisMainWindow::on_tabWidget_tabBarClicked(int index) {
 }
 
 void FlowshopVisMainWindow::on_actionOpen_triggered() {
-    const QString filterSupported = tr("Supported files (*.xml, *.dot)");
+    const QString filterSupported = tr("Supported files (*.xml, *.dot, *.ddh)");
     const QString filterFlowShop = tr("Flowshop definitions (*.xml)");
     const QString filterDotGraph = tr("Dot Graphs (*.dot)");
+    const QString filterDDHistory = tr("DD state histories (*.ddh)");
     QStringList filters;
-    filters << filterSupported << filterFlowShop << filterDotGraph;
+    filters << filterSupported << filterFlowShop << filterDotGraph << filterDDHistory;
 
     QString selectedFilter;
     QString fileName = QFileDialog::getOpenFileName(
@@ -167,6 +183,8 @@ void FlowshopVisMainWindow::on_actionOpen_triggered() {
             openFlowShop(fileName, false, 0);
         } else if (fileExtension == "dot") {
             openDotGraph(fileName);
+        } else if (fileExtension == "ddh") {
+            openDDHistory(fileName);
         } else {
             QMessageBox::critical(nullptr, "Error", "Unknown file type");
         }
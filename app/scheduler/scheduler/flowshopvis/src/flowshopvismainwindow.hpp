@@ -30,6 +30,9 @@ public:
 
     void openDotGraph(const QString &fileName);
 
+    /// @brief Plots a state history written by the DD solver (see --history-file)
+    void openDDHistory(const QString &fileName);
+
 private slots:
     void showOperation(fms::problem::ModuleId moduleId, fms::problem::Operation operation, fms::cg::VertexId vertexId) {
         statusBar()->showMessage(QString::fromStdString(
@@ -15,6 +15,8 @@
 
 #include <fmt/chrono.h>
 
+#include <algorithm>
+
 using namespace FlowShopVis;
 
 // NOLINTBEGIN(cppcoreguidelines-owning-memory): Qt has a memory management system
@@ -87,7 +89,15 @@ void FlowshopWidget::openPartialSequence(const fms::dd::VertexId nodeId) {
         return;
     }
 
-    const auto vertex = ddData->states.at(nodeId);
+    const auto &states = ddData->allStates;
+    const auto it = std::find_if(states.begin(), states.end(), [nodeId](const auto &state) {
+        return state->id() == nodeId;
+    });
+    if (it == states.end()) {
+        QMessageBox::critical(nullptr, "Error", "Decision diagram state not found");
+        return;
+    }
+    const auto &vertex = *it;
 
     try {
         graphWidget->setSequences(vertex->getMachinesSequences(), *m_instance);
@@ -2,10 +2,14 @@
 #define FMS_ALGORITHMS_LONGEST_PATH_HPP
 
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
 #include "fms/cg/edge.hpp"
+#include "fms/cg/graph_overlay.hpp"
 #include "fms/delay.hpp"
 
+#include <cstdint>
 #include <limits>
+#include <span>
 #include <utility>
 
 /*
@@ -42,6 +46,64 @@ struct LongestPathResultWithTimes {
 
 using PathFunction = LongestPathResult (&)(const cg::ConstraintGraph &, PathTimes &);
 
+/**
+ * @brief Algorithm used to compute the longest paths
+ * @details All the engines give the same times and report the same positive cycles.
+ */
+enum class LongestPathEngine {
+    /// Full Bellman-Ford sweeps over all the vertices, @f$O(VE)@f$
+    BELLMAN_FORD,
+    /// Label-correcting worklist (SPFA) that only revisits the vertices whose time changed. Close
+    /// to linear on graphs that are almost acyclic, e.g. with a few backward deadline edges.
+    WORKLIST,
+    /// Sweeps in the topological order of the forward subgraph (see @ref ForwardOrder), the
+    /// backward edges only need as many extra sweeps as they are chained in a longest path.
+    TWO_PHASE
+};
+
+/// @brief What the longest path computations report when the graph has a positive cycle
+enum class CycleReport {
+    /// The edges that can still be relaxed once the sweeps are over, which are on a positive cycle
+    /// or reachable from one
+    VIOLATED_EDGES,
+    /// The edges of one positive cycle, from its last edge back to the first one. The predecessor
+    /// of each vertex is recorded during the sweeps, which stop as soon as they form a cycle.
+    CYCLE
+};
+
+/**
+ * @brief Topological order of the forward subgraph of a constraint graph
+ * @details The graphs created by @ref cg::Builder have (almost) all their non-negative edges
+ * pointing forward in the job order while the due dates are negative edges pointing backward.
+ * The vertices are ordered topologically over the non-negative edges, so a single sweep in this
+ * order propagates all the forward edges. Every edge that goes against the order is a backward
+ * edge, and a longest path can use each backward edge at most once. Thus, for a graph without
+ * positive cycles, the times converge after at most one sweep per backward edge.
+ *
+ * The order only depends on the structure of the graph, so it can be computed once and reused
+ * for every evaluation on the same graph (also with extra edges on top of it).
+ */
+class ForwardOrder {
+public:
+    explicit ForwardOrder(const cg::ConstraintGraph &dg);
+
+    explicit ForwardOrder(const cg::CSRGraph &g);
+
+    /// @brief Vertices in topological order of the forward subgraph
+    [[nodiscard]] inline const cg::VerticesIds &getOrder() const noexcept { return m_order; }
+
+    /// @brief Number of edges of the graph that go against @ref getOrder
+    [[nodiscard]] inline std::size_t getNumberOfBackwardEdges() const noexcept {
+        return m_nrBackwardEdges;
+    }
+
+private:
+    template <typename G> void build(const G &g);
+
+    cg::VerticesIds m_order;
+    std::size_t m_nrBackwardEdges{};
+};
+
 /// Starting value of ASAP computation. Equivalent to @f$-\infty@f$
 constexpr delay kASAPStartValue = std::numeric_limits<delay>::min();
 
@@ -86,6 +148,17 @@ void initializeASAPST(const cg::ConstraintGraph &dg,
                       const cg::VerticesIds &sources = {},
                       bool graphSources = true);
 
+/// @copydoc initializeASAPST(const cg::ConstraintGraph&, const cg::VerticesIds&, bool)
+PathTimes initializeASAPST(const cg::CSRGraph &g,
+                           const cg::VerticesIds &sources = {},
+                           bool graphSources = true);
+
+/// @copydoc initializeASAPST(const cg::ConstraintGraph&, PathTimes&, const cg::VerticesIds&, bool)
+void initializeASAPST(const cg::CSRGraph &g,
+                      PathTimes &ASAPST,
+                      const cg::VerticesIds &sources = {},
+                      bool graphSources = true);
+
 /**
  * @brief Compute earliest start times
  *
@@ -99,21 +172,99 @@ void initializeASAPST(const cg::ConstraintGraph &dg,
  */
 LongestPathResult computeASAPST(const cg::ConstraintGraph &dg, PathTimes &ASAPST);
 
+/**
+ * @brief Overload of @ref computeASAPST for a graph with temporary edits
+ * @details The edges added or overridden in @p g are relaxed as if they were part of its base
+ * graph, which is not modified.
+ * @param g Overlay of the graph to evaluate
+ * @param ASAPST Initialized starting times that will be updated with the ASAP.
+ */
+LongestPathResult computeASAPST(const cg::GraphOverlay &g, PathTimes &ASAPST);
+
+/**
+ * @brief Overload of @ref computeASAPST that selects the algorithm
+ * @param dg Graph to evaluate
+ * @param ASAPST Initialized starting times that will be updated with the ASAP.
+ * @param engine Algorithm used to compute the longest paths
+ */
+LongestPathResult
+computeASAPST(const cg::ConstraintGraph &dg, PathTimes &ASAPST, LongestPathEngine engine);
+
+/// @copydoc computeASAPST(const cg::ConstraintGraph&, PathTimes&, LongestPathEngine)
+LongestPathResult
+computeASAPST(const cg::GraphOverlay &g, PathTimes &ASAPST, LongestPathEngine engine);
+
+/**
+ * @brief Overload of @ref computeASAPST that selects how a positive cycle is reported
+ * @details With @ref CycleReport::CYCLE an infeasible graph is usually detected in fewer sweeps
+ * and the result directly contains the cycle, so @ref getPositiveCycle is not needed anymore.
+ * The times are the same as with @ref computeASAPST when the graph is feasible.
+ * @param dg Graph to evaluate
+ * @param ASAPST Initialized starting times that will be updated with the ASAP.
+ * @param report Content of the result when the graph is infeasible
+ */
+LongestPathResult
+computeASAPST(const cg::ConstraintGraph &dg, PathTimes &ASAPST, CycleReport report);
+
+/// @copydoc computeASAPST(const cg::ConstraintGraph&, PathTimes&, CycleReport)
+LongestPathResult computeASAPST(const cg::GraphOverlay &g, PathTimes &ASAPST, CycleReport report);
+
+/**
+ * @brief Multi-threaded variant of @ref computeASAPST for very large graphs
+ * @details The vertices are split in ranges of consecutive jobs that are relaxed by different
+ * threads until no time changes. The times and the reported cycle are identical to the ones of
+ * @ref computeASAPST . Graphs that are too small to share between the threads are computed on
+ * the calling thread.
+ * @param dg Graph to evaluate
+ * @param ASAPST Initialized starting times that will be updated with the ASAP.
+ * @param nrThreads Maximum number of threads to use, including the calling one
+ */
+LongestPathResult
+computeASAPSTParallel(const cg::ConstraintGraph &dg, PathTimes &ASAPST, std::size_t nrThreads);
+
+/// @copydoc computeASAPSTParallel(const cg::ConstraintGraph&, PathTimes&, std::size_t)
+LongestPathResult
+computeASAPSTParallel(const cg::GraphOverlay &g, PathTimes &ASAPST, std::size_t nrThreads);
+
+/// @copydoc computeASAPSTParallel(const cg::ConstraintGraph&, PathTimes&, std::size_t)
+/// @param extra Side list of edges to consider in addition to the ones of @p g
+LongestPathResult computeASAPSTParallel(const cg::CSRGraph &g,
+                                        PathTimes &ASAPST,
+                                        std::size_t nrThreads,
+                                        const cg::ExtraEdges &extra = {});
+
+/**
+ * @brief Two-phase overload of @ref computeASAPST
+ * @details Alternates sweeps over the forward subgraph in the precomputed @p order with the
+ * relaxation of the backward edges until no time changes. If the times still change after the
+ * number of rounds allowed by the backward edges, the graph contains a positive cycle, which is
+ * reported exactly as the Bellman-Ford sweeps would.
+ * @param dg Graph to evaluate
+ * @param ASAPST Initialized starting times that will be updated with the ASAP.
+ * @param order Order of the vertices of @p dg
+ */
+LongestPathResult
+computeASAPST(const cg::ConstraintGraph &dg, PathTimes &ASAPST, const ForwardOrder &order);
+
+/// @copydoc computeASAPST(const cg::ConstraintGraph&, PathTimes&, const ForwardOrder&)
+/// @note @p order is the order of the base graph of @p g
+LongestPathResult
+computeASAPST(const cg::GraphOverlay &g, PathTimes &ASAPST, const ForwardOrder &order);
+
 /**
  * @brief Overload of @ref computeASAPST
- * @details This overload adds the @p inputEdges to the
- * graph before computing the ASAP times and removes them after it finishes.
+ * @details This overload computes the ASAP times as if the @p inputEdges were added to the
+ * graph. The edges are kept in a @ref cg::GraphOverlay so @p dg is not modified.
  * @param dg Graph to evaluate
  * @param ASAPST Initialized starting times that will be updated with the ASAP.
  * @param inputEdges Edges to be added to the graph before computing ASAPST
  */
-inline LongestPathResult
-computeASAPST(cg::ConstraintGraph &dg, PathTimes &ASAPST, const cg::Edges &inputEdges) {
-    cg::Edges edges = dg.addEdges(inputEdges);
-    auto result = paths::computeASAPST(dg, ASAPST);
-    dg.removeEdges(edges);
-    return result;
-}
+LongestPathResult
+computeASAPST(const cg::ConstraintGraph &dg, PathTimes &ASAPST, const cg::Edges &inputEdges);
+
+/// @copydoc computeASAPST(const cg::ConstraintGraph&, PathTimes&, const cg::Edges&)
+LongestPathResult
+computeASAPST(const cg::GraphOverlay &g, PathTimes &ASAPST, const cg::Edges &inputEdges);
 
 /**
  * @brief Overload of @ref computeASAPST
@@ -127,11 +278,21 @@ computeASAPST(cg::ConstraintGraph &dg, PathTimes &ASAPST, const cg::Edges &input
  * @param ASAPST Initialized starting times that will be updated with the ASAP.
  * @param sources Subset of vertices to consider of the graph for longest-path computation.
  * @param window Window of the graph to consider for longest-path computation.
+ * @param report Content of the result when the graph is infeasible. An edge towards a job before
+ * the window is always reported on its own.
  */
 LongestPathResult computeASAPST(const cg::ConstraintGraph &dg,
                                 PathTimes &ASAPST,
                                 const cg::VerticesCRef &sources,
-                                const cg::VerticesCRef &window);
+                                const cg::VerticesCRef &window,
+                                CycleReport report = CycleReport::VIOLATED_EDGES);
+
+/// @copydoc computeASAPST(const cg::ConstraintGraph&, PathTimes&, const cg::VerticesCRef&, const cg::VerticesCRef&, CycleReport)
+LongestPathResult computeASAPST(const cg::GraphOverlay &g,
+                                PathTimes &ASAPST,
+                                const cg::VerticesCRef &sources,
+                                const cg::VerticesCRef &window,
+                                CycleReport report = CycleReport::VIOLATED_EDGES);
 
 /**
  * @brief Overload of @ref computeASAPST
@@ -165,7 +326,7 @@ LongestPathResult computeASAPST(const cg::ConstraintGraph &dg,
  * path times
  * @return
  */
-[[nodiscard]] inline LongestPathResultWithTimes computeASAPST(cg::ConstraintGraph &dg,
+[[nodiscard]] inline LongestPathResultWithTimes computeASAPST(const cg::ConstraintGraph &dg,
                                                               const cg::Edges &edges,
                                                               const cg::VerticesIds &sources = {},
                                                               bool graphSources = true) {
@@ -174,6 +335,21 @@ LongestPathResult computeASAPST(const cg::ConstraintGraph &dg,
     return {std::move(result), std::move(ASAPST)};
 }
 
+/**
+ * @brief Overload of @ref computeASAPST from the graph sources with the extra @p edges
+ * @param dg Graph
+ * @param edges Extra edges to be added to the graph before computing the longest path
+ * @param report Content of the result when the graph is infeasible
+ */
+[[nodiscard]] inline LongestPathResultWithTimes
+computeASAPST(const cg::ConstraintGraph &dg, const cg::Edges &edges, CycleReport report) {
+    auto ASAPST = initializeASAPST(dg);
+    cg::GraphOverlay overlay(dg);
+    overlay.addEdges(edges);
+    auto result = computeASAPST(overlay, ASAPST, report);
+    return {std::move(result), std::move(ASAPST)};
+}
+
 /**
  * @brief Computes the longest path from a single node
  * @details Computes the distance from the node @p source to all the other nodes in the
@@ -185,13 +361,112 @@ LongestPathResult computeASAPST(const cg::ConstraintGraph &dg,
  * the length is equal to @ref kASAPStartValue it means that the node is not reachable from
  * @p source.
  */
-[[nodiscard]] inline PathTimes
-computeASAPSTFromNode(cg::ConstraintGraph &dg, cg::VertexId source, const cg::Edges &edges = {}) {
+[[nodiscard]] inline PathTimes computeASAPSTFromNode(const cg::ConstraintGraph &dg,
+                                                     cg::VertexId source,
+                                                     const cg::Edges &edges = {}) {
     auto ASAPST = initializeASAPST(dg, {source}, false);
     computeASAPST(dg, ASAPST, edges);
     return ASAPST;
 }
 
+/**
+ * @brief Overload of @ref computeASAPST for a frozen @ref cg::CSRGraph snapshot
+ * @details The @p extra edges are relaxed right after the edges of the snapshot leaving the
+ * same vertex, so the result is identical to adding them to the original graph with
+ * @ref cg::Graph::addEdges and running @ref computeASAPST on it, without modifying anything.
+ * @param g Snapshot of the graph to evaluate
+ * @param ASAPST Initialized starting times that will be updated with the ASAP.
+ * @param extra Side list of edges to consider in addition to the ones of @p g
+ */
+LongestPathResult
+computeASAPST(const cg::CSRGraph &g, PathTimes &ASAPST, const cg::ExtraEdges &extra = {});
+
+/// @copydoc computeASAPST(const cg::ConstraintGraph&, PathTimes&, LongestPathEngine)
+/// @param extra Side list of edges to consider in addition to the ones of @p g
+LongestPathResult computeASAPST(const cg::CSRGraph &g,
+                                PathTimes &ASAPST,
+                                const cg::ExtraEdges &extra,
+                                LongestPathEngine engine);
+
+/**
+ * @brief Overload of @ref computeASAPST for a frozen @ref cg::CSRGraph snapshot
+ * @param g Snapshot of the graph to evaluate
+ * @param ASAPST Initialized starting times that will be updated with the ASAP.
+ * @param inputEdges Edges to consider in addition to the ones of @p g
+ */
+inline LongestPathResult
+computeASAPST(const cg::CSRGraph &g, PathTimes &ASAPST, const cg::Edges &inputEdges) {
+    return computeASAPST(g, ASAPST, cg::ExtraEdges(g, inputEdges));
+}
+
+/// @copydoc computeASAPST(const cg::ConstraintGraph&, PathTimes&, const cg::VerticesCRef&, const cg::VerticesCRef&, CycleReport)
+/// @param extra Side list of edges to consider in addition to the ones of @p g
+LongestPathResult computeASAPST(const cg::CSRGraph &g,
+                                PathTimes &ASAPST,
+                                const cg::VerticesCRef &sources,
+                                const cg::VerticesCRef &window,
+                                const cg::ExtraEdges &extra = {});
+
+/// @copydoc computeASAPST(const cg::ConstraintGraph&, const cg::VerticesIds&, bool)
+[[nodiscard]] inline LongestPathResultWithTimes computeASAPST(const cg::CSRGraph &g,
+                                                              const cg::VerticesIds &sources = {},
+                                                              bool graphSources = true) {
+    auto ASAPST = initializeASAPST(g, sources, graphSources);
+    auto result = computeASAPST(g, ASAPST);
+    return {std::move(result), std::move(ASAPST)};
+}
+
+/// @copydoc computeASAPST(const cg::ConstraintGraph&, const cg::Edges&, const cg::VerticesIds&, bool)
+[[nodiscard]] inline LongestPathResultWithTimes computeASAPST(const cg::CSRGraph &g,
+                                                              const cg::Edges &edges,
+                                                              const cg::VerticesIds &sources = {},
+                                                              bool graphSources = true) {
+    auto ASAPST = initializeASAPST(g, sources, graphSources);
+    auto result = computeASAPST(g, ASAPST, edges);
+    return {std::move(result), std::move(ASAPST)};
+}
+
+/// @copydoc computeASAPSTFromNode(const cg::ConstraintGraph&, cg::VertexId, const cg::Edges&)
+[[nodiscard]] inline PathTimes computeASAPSTFromNode(const cg::CSRGraph &g,
+                                                     cg::VertexId source,
+                                                     const cg::ExtraEdges &extra = {}) {
+    auto ASAPST = initializeASAPST(g, {source}, false);
+    computeASAPST(g, ASAPST, extra);
+    return ASAPST;
+}
+
+/**
+ * @brief Longest paths from several sources, stored with one lane per source for each vertex
+ * @details The times of a vertex are contiguous so that one relaxation of an edge updates all the
+ * sources together.
+ */
+struct MultiSourcePathTimes {
+    std::size_t nrSources{};
+    PathTimes times;
+
+    /// @brief Length of the longest path from the source in lane @p lane to @p v
+    [[nodiscard]] inline delay get(cg::VertexId v, std::size_t lane) const {
+        return times[v * nrSources + lane];
+    }
+
+    /// @brief Longest paths from the source in lane @p lane to all the vertices
+    [[nodiscard]] PathTimes getSource(std::size_t lane) const;
+};
+
+/**
+ * @brief Computes the longest paths from multiple nodes at once
+ * @details Equivalent to calling @ref computeASAPSTFromNode for each of @p sources, but every
+ * sweep over the edges relaxes all the sources, which amortises the traversal of the graph. Each
+ * lane follows exactly the same relaxations as the single source computation, including when
+ * there is a positive cycle, so the times are identical.
+ * @param g Snapshot of the graph
+ * @param sources Source nodes, one lane each
+ * @param extra Side list of edges to consider in addition to the ones of @p g
+ */
+[[nodiscard]] MultiSourcePathTimes computeASAPSTFromNodes(const cg::CSRGraph &g,
+                                                          std::span<const cg::VertexId> sources,
+                                                          const cg::ExtraEdges &extra = {});
+
 std::tuple<bool, std::optional<cg::Edge>> relaxVerticesASAPST(const cg::VerticesCRef &allVertices,
                                                               const cg::ConstraintGraph &dg,
                                                               problem::JobId firstJobId,
@@ -224,27 +499,122 @@ bool addOneEdgeIncrementalASAPST(const cg::ConstraintGraph &dg,
                                  const cg::Edge &e,
                                  PathTimes &ASAPST);
 
+/// @copydoc addOneEdgeIncrementalASAPST(const cg::ConstraintGraph&, const cg::Edge&, PathTimes&)
+/// @param extra Side list of edges of the graph in addition to the ones of @p g
+bool addOneEdgeIncrementalASAPST(const cg::GraphOverlay &g,
+                                 const cg::Edge &e,
+                                 PathTimes &ASAPST,
+                                 const cg::ExtraEdges &extra = {});
+
 /**
  * @brief Incremental check of positive cycles with multiple edges
  *
  * This function checks if adding the edges @p edges to the graph @p dg would create positive
- * cycles in an incremental way.
+ * cycles in an incremental way. The edges are accumulated in a @ref cg::GraphOverlay so
+ * @p dg is not modified. Edges that already exist in the graph, or that appear earlier in
+ * @p edges, are ignored, as in @ref computeASAPST.
  * @param dg Graph
  * @param edges Edges to add to the graph
  * @param ASAPST Known longest path times of @p dg
  * @return _true_ If adding the edges @p edges to the graph would create a positive cycle,
  * otherwise _false_.
  */
-bool addEdgesIncrementalASAPST(cg::ConstraintGraph &dg, const cg::Edges &edges, PathTimes &ASAPST);
+bool addEdgesIncrementalASAPST(const cg::ConstraintGraph &dg,
+                               const cg::Edges &edges,
+                               PathTimes &ASAPST);
+
+/// @copydoc addEdgesIncrementalASAPST(const cg::ConstraintGraph&, const cg::Edges&, PathTimes&)
+bool addEdgesIncrementalASAPST(const cg::GraphOverlay &g,
+                               const cg::Edges &edges,
+                               PathTimes &ASAPST);
 
 /**
- * @copydoc addEdgesIncrementalASAPST(cg::ConstraintGraph&, const cg::Edges&,
- * PathTimes&)
- * @note This version does not modify the original graph but uses a copy of it.
+ * @brief Reusable buffers of the incremental ASAP updates
+ * @details The buffers are sized to the graph on first use and only the vertices recorded by an
+ * update are reset afterwards, so repeated updates on the same graph do not pay for its size. One
+ * scratch must not be shared by updates that run concurrently.
  */
-bool addEdgesIncrementalASAPSTConst(cg::ConstraintGraph dg,
-                                    const cg::Edges &edges,
-                                    PathTimes &ASAPST);
+class IncrementalASAPScratch {
+public:
+    /// @brief Grows the buffers to @p nrVertices if needed
+    void reserve(std::size_t nrVertices);
+
+    /// @brief Records @p v , returns true if it was not recorded since the last @ref clear
+    bool markTouched(cg::VertexId v);
+
+    /// @brief Number of distinct vertices recorded since the last @ref clear
+    [[nodiscard]] inline std::size_t getNumberOfTouched() const noexcept {
+        return m_touched.size();
+    }
+
+    /// @brief Appends @p e after the edges with the same source added since the last @ref clear
+    void addEdge(const cg::Edge &e);
+
+    [[nodiscard]] bool hasAddedEdge(cg::VertexId src, cg::VertexId dst) const noexcept;
+
+    /// @brief Calls @p f for each added edge leaving @p v , in insertion order, until it returns
+    /// true
+    template <typename F> bool anyAddedOutgoing(cg::VertexId v, F &&f) const {
+        for (auto i = m_firstOut[v]; i != kNoEdge; i = m_added[i].nextOut) {
+            if (f(m_added[i].edge.dst, m_added[i].edge.weight)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Resets the vertices and the edges recorded since the last call
+    void clear();
+
+private:
+    static constexpr std::uint32_t kNoEdge = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief Added edge chained to the next ones with the same source and the same destination
+    struct AddedEdge {
+        cg::Edge edge;
+        std::uint32_t nextOut;
+        std::uint32_t nextIn;
+    };
+
+    std::vector<std::uint8_t> m_isTouched;
+    cg::VerticesIds m_touched;
+
+    // Added edges are chained instead of sorted so that adding one does not move the others. The
+    // lookups walk the destination chain: the edges of an update usually share a few sources.
+    std::vector<std::uint32_t> m_firstOut;
+    std::vector<std::uint32_t> m_lastOut;
+    std::vector<std::uint32_t> m_firstIn;
+    std::vector<AddedEdge> m_added;
+};
+
+/// @brief Outcome of @ref computeIncrementalASAPST
+struct IncrementalPathResult {
+    /// The edges create a positive cycle, the times are then only partially updated
+    bool positiveCycle = false;
+
+    /// Number of distinct vertices whose time was increased
+    std::size_t touchedVertices = 0;
+};
+
+/**
+ * @brief Incremental counterpart of @ref computeASAPST with extra edges
+ * @details Starting from @p ASAPST , which must be consistent with @p g , only the vertices whose
+ * times increase because of @p edges are revisited, so the cost depends on the part of the graph
+ * downstream of the edges instead of on the whole graph. Edges that already exist in @p g are
+ * ignored, like @ref computeASAPST does, so both give the same times. The graph is not modified.
+ * @param g Graph
+ * @param edges Edges to add to the graph
+ * @param ASAPST Longest path times of @p g that will be updated
+ */
+IncrementalPathResult
+computeIncrementalASAPST(const cg::GraphOverlay &g, const cg::Edges &edges, PathTimes &ASAPST);
+
+/// @copydoc computeIncrementalASAPST(const cg::GraphOverlay&, const cg::Edges&, PathTimes&)
+/// @param scratch Buffers reused between calls
+IncrementalPathResult computeIncrementalASAPST(const cg::GraphOverlay &g,
+                                               const cg::Edges &edges,
+                                               PathTimes &ASAPST,
+                                               IncrementalASAPScratch &scratch);
 
 /**
  * @brief Checks whether adding the edges is successful and doesn't add a positive cycle.
@@ -255,10 +625,22 @@ bool addEdgesIncrementalASAPSTConst(cg::ConstraintGraph dg,
  * @return true Adding the edges does not cause a positive cycle
  * @return false Adding the edges causes a positive cycle
  */
-inline bool addEdgesSuccessful(cg::ConstraintGraph &dg, const cg::Edges &edges, PathTimes &ASAPST) {
+inline bool
+addEdgesSuccessful(const cg::ConstraintGraph &dg, const cg::Edges &edges, PathTimes &ASAPST) {
     return !computeASAPST(dg, ASAPST, edges).hasPositiveCycle();
 }
 
+/// @copydoc addEdgesSuccessful(const cg::ConstraintGraph&, const cg::Edges&, PathTimes&)
+inline bool
+addEdgesSuccessful(const cg::GraphOverlay &g, const cg::Edges &edges, PathTimes &ASAPST) {
+    return !computeASAPST(g, ASAPST, edges).hasPositiveCycle();
+}
+
+/// @copydoc addEdgesSuccessful(const cg::ConstraintGraph&, const cg::Edges&, PathTimes&)
+inline bool addEdgesSuccessful(const cg::CSRGraph &g, const cg::Edges &edges, PathTimes &ASAPST) {
+    return !computeASAPST(g, ASAPST, edges).hasPositiveCycle();
+}
+
 ////////////////////
 // ALAP FUNCTIONS //
 ////////////////////
@@ -267,6 +649,14 @@ PathTimes initializeALAPST(const cg::ConstraintGraph &dg,
                            const cg::VerticesIds &sources = {},
                            bool graphSources = true);
 
+/**
+ * @brief Computes the latest start times that respect the times already in @p ALAPST
+ * @details The times of @p sources are never changed. The edges that would require one of them
+ * to start earlier are reported in the result, together with the edges of positive cycles.
+ * @param dg Graph to evaluate
+ * @param ALAPST Initialized latest start times that will be updated
+ * @param sources Vertices whose times cannot be changed by the relaxation
+ */
 [[nodiscard]] LongestPathResult computeALAPST(const cg::ConstraintGraph &dg,
                                               PathTimes &ALAPST,
                                               const cg::VerticesIds &sources = {});
@@ -277,10 +667,144 @@ PathTimes initializeALAPST(const cg::ConstraintGraph &dg,
     return {computeALAPST(dg, ALAPST, sources), std::move(ALAPST)};
 }
 
+/**
+ * @brief Overload of @ref computeALAPST for a graph with temporary edits
+ * @param g Overlay of the graph to evaluate. Its base graph is not modified.
+ * @param ALAPST Initialized latest start times that will be updated
+ * @param sources Vertices whose times cannot be changed by the relaxation
+ */
+[[nodiscard]] LongestPathResult computeALAPST(const cg::GraphOverlay &g,
+                                              PathTimes &ALAPST,
+                                              const cg::VerticesIds &sources = {});
+
+PathTimes initializeALAPST(const cg::CSRGraph &g,
+                           const cg::VerticesIds &sources = {},
+                           bool graphSources = true);
+
+/**
+ * @brief Overload of @ref computeALAPST for a frozen @ref cg::CSRGraph snapshot
+ * @param g Snapshot of the graph to evaluate
+ * @param ALAPST Initialized latest start times that will be updated
+ * @param sources Vertices whose times cannot be changed by the relaxation
+ * @param extra Side list of edges to consider in addition to the ones of @p g
+ */
+[[nodiscard]] LongestPathResult computeALAPST(const cg::CSRGraph &g,
+                                              PathTimes &ALAPST,
+                                              const cg::VerticesIds &sources = {},
+                                              const cg::ExtraEdges &extra = {});
+
+[[nodiscard]] std::tuple<LongestPathResult, PathTimes> inline computeALAPST(
+        const cg::CSRGraph &g, const cg::VerticesIds &sources = {}) {
+    auto ALAPST = initializeALAPST(g, sources);
+    return {computeALAPST(g, ALAPST, sources), std::move(ALAPST)};
+}
+
 std::tuple<bool, std::optional<cg::Edge>> relaxVerticesALAPST(const cg::ConstraintGraph &dg,
                                                               PathTimes &ALAPST,
                                                               const cg::VerticesIds &sources);
 
+/**
+ * @brief Relaxes one edge backwards and returns by how much the ALAP time of its source decreased
+ *
+ * @param e Edge to relax
+ * @param ALAPST Latest start times for each vertex
+ * @return delay Amount that the source vertex was relaxed. If no relaxation the result is 0.
+ */
+delay relaxOneEdgeALAPST(const cg::Edge &e, PathTimes &ALAPST);
+
+/**
+ * @brief Reusable buffers of the incremental ALAP updates
+ * @details The buffers are sized to the graph on first use and only the entries written by an
+ * update are reset afterwards, so repeated updates on the same graph do not pay for its size. One
+ * scratch must not be shared by updates that run concurrently.
+ */
+class IncrementalALAPScratch {
+public:
+    /// @brief Flags @p sources as fixed, growing the buffers to @p nrVertices if needed
+    void markSources(std::size_t nrVertices, const cg::VerticesIds &sources);
+
+    [[nodiscard]] inline bool isSource(cg::VertexId v) const { return m_isSource[v] != 0U; }
+
+    /// @brief Number of edges of the path that last decreased the time of @p v , 0 if none
+    [[nodiscard]] inline std::size_t getPathLength(cg::VertexId v) const {
+        return m_pathLength[v];
+    }
+
+    void setPathLength(cg::VertexId v, std::size_t length);
+
+    /// @brief Resets the path lengths set since the last call
+    void clearPathLengths();
+
+    /// @brief Resets every entry written since @ref markSources
+    void clear();
+
+private:
+    std::vector<std::uint8_t> m_isSource;
+    std::vector<std::size_t> m_pathLength;
+    cg::VerticesIds m_sources;
+    cg::VerticesIds m_touched;
+};
+
+/**
+ * @brief Incremental update of the ALAP times when adding edges
+ *
+ * Backward counterpart of @ref addEdgesIncrementalASAPST. Starting from the known ALAP times
+ * @p ALAPST of @p dg, only the vertices whose time decreases are revisited, following the
+ * incoming edges in order of largest decrease. Edges that already exist in @p dg are ignored,
+ * like @ref computeALAPST does on a graph with the edges added. The graph is not modified.
+ * As in @ref computeALAPST , the times of @p sources are never changed, so the result is the same
+ * as running it from @p ALAPST on the graph with the edges.
+ *
+ * @param dg Graph
+ * @param edges Edges to add to the graph
+ * @param ALAPST Known latest start times of @p dg that will be updated
+ * @param sources Vertices whose times cannot be changed by the relaxation
+ * @return _true_ If adding the edges creates a positive cycle or one of @p sources would need to
+ * start earlier, otherwise _false_.
+ */
+bool addEdgesIncrementalALAPST(const cg::ConstraintGraph &dg,
+                               const cg::Edges &edges,
+                               PathTimes &ALAPST,
+                               const cg::VerticesIds &sources = {});
+
+/// @copydoc addEdgesIncrementalALAPST(const cg::ConstraintGraph&, const cg::Edges&, PathTimes&, const cg::VerticesIds&)
+bool addEdgesIncrementalALAPST(const cg::GraphOverlay &g,
+                               const cg::Edges &edges,
+                               PathTimes &ALAPST,
+                               const cg::VerticesIds &sources = {});
+
+/// @copydoc addEdgesIncrementalALAPST(const cg::ConstraintGraph&, const cg::Edges&, PathTimes&, const cg::VerticesIds&)
+/// @param scratch Buffers reused between calls
+bool addEdgesIncrementalALAPST(const cg::GraphOverlay &g,
+                               const cg::Edges &edges,
+                               PathTimes &ALAPST,
+                               const cg::VerticesIds &sources,
+                               IncrementalALAPScratch &scratch);
+
+/**
+ * @brief Propagates the decrease of the ALAP times of some vertices
+ * @details Used when the times of @p decreased have been lowered directly, e.g. when fixing
+ * them to their ASAP times. Only the vertices affected by the change are revisited.
+ * @param g Graph
+ * @param decreased Vertices whose times were decreased
+ * @param ALAPST Latest start times that are up to date except for @p decreased
+ * @param sources Vertices whose times cannot be changed by the relaxation
+ * @return _true_ If one of @p sources would need to start earlier or there is a positive cycle,
+ * otherwise _false_.
+ */
+bool updateIncrementalALAPST(const cg::GraphOverlay &g,
+                             const cg::VerticesIds &decreased,
+                             PathTimes &ALAPST,
+                             const cg::VerticesIds &sources = {});
+
+/// @copydoc updateIncrementalALAPST(const cg::GraphOverlay&, const cg::VerticesIds&, PathTimes&, const cg::VerticesIds&)
+/// @param scratch Buffers reused between calls
+bool updateIncrementalALAPST(const cg::GraphOverlay &g,
+                             const cg::VerticesIds &decreased,
+                             PathTimes &ALAPST,
+                             const cg::VerticesIds &sources,
+                             IncrementalALAPScratch &scratch);
+
 /////////////////////
 // OTHER FUNCTIONS //
 /////////////////////
@@ -293,17 +817,28 @@ void dumpToFile(const cg::ConstraintGraph &dg,
 
 /**
  * @brief Finds the positive cycle in the given delay graph.
+ * @details Same as @ref computeASAPST with @ref CycleReport::CYCLE from the graph sources.
  *
  * @param dg The delay graph to search for the positive cycle.
  * @return The positive cycle found in the delay graph, if any.
  */
 [[nodiscard]] std::vector<cg::Edge> getPositiveCycle(const cg::ConstraintGraph &dg);
 
-[[nodiscard]] inline auto getPositiveCycle(cg::ConstraintGraph &dg, const cg::Edges &edges) {
-    const auto addedEdges = dg.addEdges(edges);
-    auto result = getPositiveCycle(dg);
-    dg.removeEdges(addedEdges);
-    return result;
+[[nodiscard]] cg::Edges getPositiveCycle(const cg::ConstraintGraph &dg, const cg::Edges &edges);
+
+/// @copydoc getPositiveCycle(const cg::ConstraintGraph&)
+[[nodiscard]] cg::Edges getPositiveCycle(const cg::GraphOverlay &g);
+
+/**
+ * @brief Finds the positive cycle in a frozen @ref cg::CSRGraph snapshot
+ * @param g Snapshot of the graph to search for the positive cycle.
+ * @param extra Side list of edges to consider in addition to the ones of @p g
+ * @return The positive cycle found in the graph, if any.
+ */
+[[nodiscard]] cg::Edges getPositiveCycle(const cg::CSRGraph &g, const cg::ExtraEdges &extra = {});
+
+[[nodiscard]] inline cg::Edges getPositiveCycle(const cg::CSRGraph &g, const cg::Edges &edges) {
+    return getPositiveCycle(g, cg::ExtraEdges(g, edges));
 }
 } // namespace fms::algorithms::paths
 
@@ -7,6 +7,7 @@
 #define FMS_CG_CONSTRAINT_GRAPH_HPP
 
 #include "edge.hpp"
+#include "operation_index.hpp"
 #include "vertex.hpp"
 
 #include "fms/delay.hpp"
@@ -163,13 +164,7 @@ public:
     }
 
     [[nodiscard]] const Vertex &getVertex(const problem::Operation &op) const {
-        auto it = identifierToVertex.find(op);
-        if (it == identifierToVertex.end()) {
-            throw FmsSchedulerException(fmt::format(
-                    "Error, unable to find the vertex for the given operation ({}) in the graph",
-                    op));
-        }
-        return vertices.at(it->second);
+        return vertices[getVertexId(op)];
     }
 
     [[nodiscard]] static inline const Vertex &getVertex(const Vertex &v) { return v; }
@@ -192,13 +187,13 @@ public:
     }
 
     [[nodiscard]] inline VertexId getVertexId(const problem::Operation &op) const {
-        auto it = identifierToVertex.find(op);
-        if (it == identifierToVertex.end()) {
+        const auto id = identifierToVertex.find(op);
+        if (id == OperationIndex::kNoVertex) {
             throw FmsSchedulerException(fmt::format(
                     "Error, unable to find the vertex for the given operation ({}) in the graph",
                     op));
         }
-        return it->second;
+        return id;
     }
 
     [[nodiscard]] static inline VertexId getVertexId(const Vertex &v) { return v.id; }
@@ -216,7 +211,7 @@ public:
     }
 
     [[nodiscard]] inline bool hasVertex(const problem::Operation &op) const {
-        return identifierToVertex.find(op) != identifierToVertex.end();
+        return identifierToVertex.contains(op);
     }
 
     template <typename T,
@@ -246,7 +241,7 @@ public:
 
     template <typename T1, typename T2>
     [[nodiscard]] decltype(Edge::weight) getWeight(const T1 &src, const T2 &dst) const {
-        return getVertex(src).get_weight(getVertexId(dst));
+        return getVertex(src).getWeight(getVertexId(dst));
     }
 
     [[nodiscard]] inline const Vertices &getVertices() const { return vertices; }
@@ -282,7 +277,7 @@ private:
     std::vector<Vertex> vertices;
 
     /// Maps the custom identifier to its respective vertex
-    utils::containers::Map<problem::Operation, VertexId> identifierToVertex;
+    OperationIndex identifierToVertex;
 
     utils::containers::Map<problem::JobId, std::vector<VertexId>> jobToVertex;
 };
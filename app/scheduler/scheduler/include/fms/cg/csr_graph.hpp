@@ -0,0 +1,179 @@
+#ifndef FMS_CG_CSR_GRAPH_HPP
+#define FMS_CG_CSR_GRAPH_HPP
+
+#include "constraint_graph.hpp"
+#include "edge.hpp"
+
+#include "fms/delay.hpp"
+#include "fms/problem/indices.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fms::cg {
+
+/**
+ * @brief Frozen compressed-sparse-row snapshot of a @ref ConstraintGraph
+ * @details The outgoing and incoming edges of every vertex are stored in contiguous offset,
+ * destination and weight arrays so that the longest-path sweeps walk linear memory instead of
+ * the per-vertex hash maps of the original graph. The edges of each vertex keep the iteration
+ * order of the graph they were taken from, therefore any algorithm run on the snapshot visits
+ * the edges in exactly the same order as it would on the @ref ConstraintGraph.
+ *
+ * The snapshot is immutable. Edges that change between evaluations (e.g. sequence edges) are
+ * passed separately as @ref ExtraEdges so the base arrays never need to be rebuilt.
+ */
+class CSRGraph {
+public:
+    CSRGraph() = default;
+
+    /**
+     * @brief Creates a snapshot of the current state of @p dg
+     * @param dg Graph to freeze. Later modifications of @p dg are not reflected in the snapshot.
+     */
+    explicit CSRGraph(const ConstraintGraph &dg);
+
+    [[nodiscard]] inline std::size_t getNumberOfVertices() const noexcept {
+        return m_jobIds.size();
+    }
+
+    [[nodiscard]] inline std::size_t getNumberOfEdges() const noexcept { return m_outDst.size(); }
+
+    /// @brief Returns the destinations of the outgoing edges of @p v
+    [[nodiscard]] inline std::span<const VertexId> getOutgoingDst(VertexId v) const noexcept {
+        return {m_outDst.data() + m_outOffsets[v], m_outDst.data() + m_outOffsets[v + 1]};
+    }
+
+    /// @brief Returns the weights of the outgoing edges of @p v, aligned with @ref getOutgoingDst
+    [[nodiscard]] inline std::span<const delay> getOutgoingWeights(VertexId v) const noexcept {
+        return {m_outWeight.data() + m_outOffsets[v], m_outWeight.data() + m_outOffsets[v + 1]};
+    }
+
+    /// @brief Returns the sources of the incoming edges of @p v
+    [[nodiscard]] inline std::span<const VertexId> getIncomingSrc(VertexId v) const noexcept {
+        return {m_inSrc.data() + m_inOffsets[v], m_inSrc.data() + m_inOffsets[v + 1]};
+    }
+
+    /// @brief Returns the weights of the incoming edges of @p v, aligned with @ref getIncomingSrc
+    [[nodiscard]] inline std::span<const delay> getIncomingWeights(VertexId v) const noexcept {
+        return {m_inWeight.data() + m_inOffsets[v], m_inWeight.data() + m_inOffsets[v + 1]};
+    }
+
+    [[nodiscard]] bool hasEdge(VertexId src, VertexId dst) const noexcept {
+        const auto dsts = getOutgoingDst(src);
+        return std::find(dsts.begin(), dsts.end(), dst) != dsts.end();
+    }
+
+    [[nodiscard]] inline bool isSource(VertexId v) const noexcept { return m_isSource[v] != 0U; }
+
+    /// @brief Vertex ids of the graph sources (see @ref ConstraintGraph::addSource)
+    [[nodiscard]] inline const VerticesIds &getSources() const noexcept { return m_sources; }
+
+    [[nodiscard]] inline problem::JobId getJobId(VertexId v) const noexcept { return m_jobIds[v]; }
+
+private:
+    std::vector<std::size_t> m_outOffsets;
+    std::vector<VertexId> m_outDst;
+    std::vector<delay> m_outWeight;
+
+    std::vector<std::size_t> m_inOffsets;
+    std::vector<VertexId> m_inSrc;
+    std::vector<delay> m_inWeight;
+
+    std::vector<problem::JobId> m_jobIds;
+    std::vector<std::uint8_t> m_isSource;
+    VerticesIds m_sources;
+};
+
+/**
+ * @brief Small side list of edges evaluated on top of a base graph without modifying it
+ * @details The edges are kept grouped by source and by destination (preserving their relative
+ * order) so that they can be relaxed right after the edges of the base graph of the same vertex.
+ * This reproduces the traversal order of the base graph after a call to @ref Graph::addEdges:
+ * edges that already exist in the base graph, or that appear twice in the list, are ignored.
+ */
+class ExtraEdges {
+public:
+    ExtraEdges() = default;
+
+    /**
+     * @brief Builds the side list of @p edges for the graph @p base
+     * @tparam G Any graph type providing `hasEdge(VertexId, VertexId)`
+     * @param base Graph on top of which the edges are applied
+     * @param edges Edges to add. Edges already present in @p base are discarded.
+     */
+    template <typename G> ExtraEdges(const G &base, const Edges &edges) {
+        m_bySrc.reserve(edges.size());
+        for (const auto &e : edges) {
+            if (!base.hasEdge(e.src, e.dst)) {
+                m_bySrc.push_back(e);
+            }
+        }
+        group();
+    }
+
+    [[nodiscard]] inline bool empty() const noexcept { return m_bySrc.empty(); }
+
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_bySrc.size(); }
+
+    /// @brief Extra edges leaving @p v in insertion order
+    [[nodiscard]] std::span<const Edge> getOutgoingEdges(VertexId v) const noexcept {
+        if (m_bySrc.empty()) {
+            return {};
+        }
+        const auto [first, last] = std::equal_range(
+                m_bySrc.begin(), m_bySrc.end(), v, CompareSrc{});
+        return {first, last};
+    }
+
+    /// @brief Extra edges entering @p v in insertion order
+    [[nodiscard]] std::span<const Edge> getIncomingEdges(VertexId v) const noexcept {
+        if (m_byDst.empty()) {
+            return {};
+        }
+        const auto [first, last] = std::equal_range(
+                m_byDst.begin(), m_byDst.end(), v, CompareDst{});
+        return {first, last};
+    }
+
+    /// @brief All the extra edges, grouped by source vertex
+    [[nodiscard]] inline const Edges &getEdges() const noexcept { return m_bySrc; }
+
+    [[nodiscard]] bool hasEdge(VertexId src, VertexId dst) const noexcept {
+        const auto outgoing = getOutgoingEdges(src);
+        return std::any_of(
+                outgoing.begin(), outgoing.end(), [dst](const Edge &e) { return e.dst == dst; });
+    }
+
+    /**
+     * @brief Appends @p e after the extra edges with the same source and the same destination
+     * @details Lets a list be built edge by edge while it is traversed between insertions. The
+     * caller must check that @p e is neither in the base graph nor already in the list.
+     */
+    void add(const Edge &e);
+
+private:
+    struct CompareSrc {
+        bool operator()(const Edge &e, VertexId v) const noexcept { return e.src < v; }
+        bool operator()(VertexId v, const Edge &e) const noexcept { return v < e.src; }
+        bool operator()(const Edge &l, const Edge &r) const noexcept { return l.src < r.src; }
+    };
+
+    struct CompareDst {
+        bool operator()(const Edge &e, VertexId v) const noexcept { return e.dst < v; }
+        bool operator()(VertexId v, const Edge &e) const noexcept { return v < e.dst; }
+        bool operator()(const Edge &l, const Edge &r) const noexcept { return l.dst < r.dst; }
+    };
+
+    /// @brief Groups the edges by source and destination and drops repeated pairs
+    void group();
+
+    Edges m_bySrc;
+    Edges m_byDst;
+};
+
+} // namespace fms::cg
+
+#endif // FMS_CG_CSR_GRAPH_HPP
@@ -0,0 +1,209 @@
+#ifndef FMS_CG_GRAPH_OVERLAY_HPP
+#define FMS_CG_GRAPH_OVERLAY_HPP
+
+#include "constraint_graph.hpp"
+#include "csr_graph.hpp"
+#include "edge.hpp"
+
+#include "fms/delay.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace fms::cg {
+
+/**
+ * @brief Copy-on-write layer of edges on top of an unchanged @ref ConstraintGraph
+ * @details Temporary edits of the graph (e.g. evaluating the edges of a scheduling option) are
+ * recorded in the overlay instead of inserting and erasing them in the adjacency maps of the
+ * shared graph. An edit either adds an edge that does not exist in the base graph or overrides
+ * the weight of an existing one. The overlay can be traversed with the same edge order as the
+ * base graph would have after applying the edits with @ref Graph::addEdges, so the path
+ * algorithms give the same results on both.
+ *
+ * The base graph must outlive the overlay and must not be modified while the overlay is in use.
+ * Since the base graph is only read, several overlays can be evaluated concurrently on it.
+ */
+class GraphOverlay {
+public:
+    explicit GraphOverlay(const ConstraintGraph &base) : m_base(&base) {}
+
+    /**
+     * @brief Overlay whose base edges are traversed through a snapshot of @p base
+     * @param base Graph on which the edits are applied
+     * @param csr Snapshot of @p base taken after its last modification. It must outlive the
+     * overlay, like @p base .
+     */
+    GraphOverlay(const ConstraintGraph &base, const CSRGraph &csr) : m_base(&base), m_csr(&csr) {}
+
+    [[nodiscard]] inline const ConstraintGraph &getBase() const noexcept { return *m_base; }
+
+    [[nodiscard]] inline std::size_t getNumberOfVertices() const noexcept {
+        return m_base->getNumberOfVertices();
+    }
+
+    /// @brief Returns true if no edge has been added or overridden
+    [[nodiscard]] inline bool empty() const noexcept { return m_edges.empty(); }
+
+    /// @brief Edges added or overridden in the overlay in the order they were first edited
+    [[nodiscard]] inline const Edges &getEdges() const noexcept { return m_edges; }
+
+    /**
+     * @brief Adds multiple edges to the overlay
+     * @details Same semantics as @ref Graph::addEdges : edges that already exist, either in
+     * the base graph or in the overlay, are ignored.
+     * @param edges The edges to add
+     * @return The edges that were added
+     */
+    Edges addEdges(const Edges &edges);
+
+    /**
+     * @brief Adds an edge to the overlay
+     * @details Adds the edge @p e and, if it already exists, updates its weight. The base graph
+     * is not modified, the weight is only overridden in the overlay.
+     * @param e The edge to add
+     */
+    void addEdges(const Edge &e);
+
+    /**
+     * @brief Overload of @ref addEdges(const Edge&) that resolves the vertices in the base graph
+     * @tparam T1 Type of the source vertex. Can be any that handles @ref Graph::getVertexId.
+     * @tparam T2 Type of the destination vertex. Can be any that handles @ref Graph::getVertexId.
+     * @return Edge Newly added edge.
+     */
+    template <typename T1, typename T2> Edge addEdge(const T1 &from, const T2 &to, delay weight) {
+        Edge e(m_base->getVertexId(from), m_base->getVertexId(to), weight);
+        addEdges(e);
+        return e;
+    }
+
+    /// @brief Drops all the edits
+    void clear();
+
+    [[nodiscard]] bool hasEdge(VertexId src, VertexId dst) const;
+
+    [[nodiscard]] inline bool hasEdge(const Edge &e) const { return hasEdge(e.src, e.dst); }
+
+    /**
+     * @brief Retrieves the weight of the edge from @p src to @p dst including the overrides
+     * @throws FmsSchedulerException if the edge exists neither in the overlay nor in the base
+     * graph.
+     */
+    [[nodiscard]] delay getWeight(VertexId src, VertexId dst) const;
+
+    /**
+     * @brief Calls @p f with the destination and weight of each outgoing edge of @p v until it
+     * returns true. Edges of the base graph come first, followed by the edges added in the overlay.
+     * @return true if @p f returned true for one of the edges
+     */
+    template <typename F> bool anyOutgoing(VertexId v, F &&f) const {
+        if (m_csr != nullptr) {
+            return any(anyOf(m_csr->getOutgoingDst(v), m_csr->getOutgoingWeights(v)),
+                       m_outSlot,
+                       m_out,
+                       v,
+                       f);
+        }
+        return any(anyOf(m_base->getVertices()[v].getOutgoingEdges()), m_outSlot, m_out, v, f);
+    }
+
+    /// @brief Same as @ref anyOutgoing for the incoming edges, @p f receives the source vertex
+    template <typename F> bool anyIncoming(VertexId v, F &&f) const {
+        if (m_csr != nullptr) {
+            return any(anyOf(m_csr->getIncomingSrc(v), m_csr->getIncomingWeights(v)),
+                       m_inSlot,
+                       m_in,
+                       v,
+                       f);
+        }
+        return any(anyOf(m_base->getVertices()[v].getIncomingEdges()), m_inSlot, m_in, v, f);
+    }
+
+private:
+    using Adjacency = std::vector<std::pair<VertexId, delay>>;
+
+    /// @brief Edits of the edges leaving (or entering) one vertex
+    struct Layer {
+        Adjacency added;
+        Adjacency overridden;
+    };
+
+    static constexpr std::uint32_t kNoLayer = std::numeric_limits<std::uint32_t>::max();
+
+    [[nodiscard]] static const std::pair<VertexId, delay> *find(const Adjacency &adjacency,
+                                                                VertexId v) noexcept {
+        for (const auto &entry : adjacency) {
+            if (entry.first == v) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Traversal of the edges of one vertex in the adjacency maps of the base graph
+    template <typename M> static auto anyOf(const M &edges) {
+        return [&edges](auto &&f) {
+            for (const auto &[other, weight] : edges) {
+                if (f(other, weight)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+    }
+
+    /// @brief Traversal of the edges of one vertex in the snapshot of the base graph
+    static auto anyOf(std::span<const VertexId> others, std::span<const delay> weights) {
+        return [others, weights](auto &&f) {
+            for (std::size_t i = 0; i < others.size(); ++i) {
+                if (f(others[i], weights[i])) {
+                    return true;
+                }
+            }
+            return false;
+        };
+    }
+
+    template <typename B, typename F>
+    static bool any(const B &anyBase,
+                    const std::vector<std::uint32_t> &layerSlot,
+                    const std::vector<Layer> &layers,
+                    VertexId v,
+                    F &f) {
+        if (layerSlot.empty() || layerSlot[v] == kNoLayer) {
+            return anyBase(f);
+        }
+
+        const auto &layer = layers[layerSlot[v]];
+        if (anyBase([&layer, &f](VertexId other, delay weight) {
+                const auto *overridden = find(layer.overridden, other);
+                return f(other, overridden != nullptr ? overridden->second : weight);
+            })) {
+            return true;
+        }
+        for (const auto &[other, weight] : layer.added) {
+            if (f(other, weight)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Layer &layerOf(std::vector<std::uint32_t> &layerSlot, std::vector<Layer> &layers, VertexId v);
+
+    const ConstraintGraph *m_base;
+    const CSRGraph *m_csr = nullptr;
+    Edges m_edges;
+
+    std::vector<std::uint32_t> m_outSlot;
+    std::vector<std::uint32_t> m_inSlot;
+    std::vector<Layer> m_out;
+    std::vector<Layer> m_in;
+};
+
+} // namespace fms::cg
+
+#endif // FMS_CG_GRAPH_OVERLAY_HPP
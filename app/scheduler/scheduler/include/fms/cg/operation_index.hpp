@@ -0,0 +1,95 @@
+#ifndef FMS_CG_OPERATION_INDEX_HPP
+#define FMS_CG_OPERATION_INDEX_HPP
+
+#include "edge.hpp"
+
+#include "fms/problem/indices.hpp"
+#include "fms/problem/operation.hpp"
+#include "fms/utils/containers.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace fms::cg {
+
+/**
+ * @brief Maps operations to the vertex that represents them in a graph
+ * @details Job ids and operation ids of the instances are small dense integers, so the vertex of
+ * an operation is stored in a table indexed by (job id, operation id) and a lookup is a couple of
+ * array loads. The special job ids reserved at the top of the @ref problem::JobId range (machine
+ * sources, terminus, maintenance operations) get their own rows indexed by operation id.
+ *
+ * Operations whose ids are too large to be stored densely fall back to a hash map.
+ */
+class OperationIndex {
+public:
+    /// @brief Returned by @ref find when the operation is not in the index
+    static constexpr VertexId kNoVertex = std::numeric_limits<VertexId>::max();
+
+    /// @brief Job ids from this value on are kept in the hash map
+    static constexpr std::uint32_t kMaxDenseJobId = 1U << 16U;
+
+    /// @brief Operation ids from this value on are kept in the hash map
+    static constexpr problem::OperationId kMaxDenseOperationId = 1U << 12U;
+
+    /// @brief Number of job ids below @ref problem::JobId::max() that are stored in their own row
+    static constexpr std::uint32_t kReservedJobIds = 16;
+
+    /**
+     * @brief Stores @p v as the vertex of @p op . If @p op was already in the index, it is
+     * updated.
+     */
+    void insert(const problem::Operation &op, VertexId v);
+
+    /**
+     * @brief Retrieves the vertex of @p op
+     * @return The vertex of @p op or @ref kNoVertex if it is not in the index
+     */
+    [[nodiscard]] inline VertexId find(const problem::Operation &op) const {
+        const auto *row = denseRow(op);
+        if (row == nullptr) {
+            const auto it = m_sparse.find(op);
+            return it == m_sparse.end() ? kNoVertex : it->second;
+        }
+        return op.operationId < row->size() ? (*row)[op.operationId] : kNoVertex;
+    }
+
+    [[nodiscard]] inline bool contains(const problem::Operation &op) const {
+        return find(op) != kNoVertex;
+    }
+
+private:
+    using Row = std::vector<VertexId>;
+
+    [[nodiscard]] inline const Row *denseRow(const problem::Operation &op) const noexcept {
+        if (op.operationId >= kMaxDenseOperationId) {
+            return nullptr;
+        }
+
+        const auto jobId = op.jobId.value;
+        if (jobId < kMaxDenseJobId) {
+            return jobId < m_jobs.size() ? &m_jobs[jobId] : &m_empty;
+        }
+
+        const auto reserved = problem::JobId::max().value - jobId;
+        return reserved < kReservedJobIds ? &m_reserved[reserved] : nullptr;
+    }
+
+    /// @brief Rows of the regular jobs indexed by job id
+    std::vector<Row> m_jobs;
+
+    /// @brief Rows of the reserved job ids indexed by their distance to @ref problem::JobId::max()
+    std::array<Row, kReservedJobIds> m_reserved;
+
+    /// @brief Fallback for the operations that cannot be stored in the dense rows
+    utils::containers::Map<problem::Operation, VertexId> m_sparse;
+
+    /// @brief Row returned for the jobs that have not been inserted
+    Row m_empty;
+};
+
+} // namespace fms::cg
+
+#endif // FMS_CG_OPERATION_INDEX_HPP
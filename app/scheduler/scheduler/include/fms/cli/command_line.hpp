@@ -9,6 +9,7 @@
 #include "dd_exploration_type.hpp"
 #include "modular_algorithm_type.hpp"
 #include "multi_algorithm_behaviour.hpp"
+#include "node_selection_type.hpp"
 #include "schedule_output_format.hpp"
 #include "shop_type.hpp"
 
@@ -30,6 +31,15 @@ struct CLIArgs {
     std::chrono::milliseconds timeOut{5000};
     std::uint64_t maxIterations = std::numeric_limits<std::uint64_t>::max();
     std::uint32_t maxPartialSolutions = 5;
+    std::uint32_t pathThreads = 1;
+    std::uint32_t threads = 1;
+    std::uint32_t maxWidth = 100;
+    std::string checkpointFile = "";
+    std::chrono::milliseconds checkpointInterval{0};
+    std::string resumeFile = "";
+    std::string historyFile = "";
+    std::uint32_t transpositionMemory = 0;
+    std::uint32_t nodeMemory = 1024;
     AlgorithmType algorithm = AlgorithmType::BHCS;
     std::vector<AlgorithmType> algorithms = {AlgorithmType::BHCS};
     std::vector<std::string> algorithmOptions;
@@ -37,6 +47,7 @@ struct CLIArgs {
     ScheduleOutputFormat outputFormat = ScheduleOutputFormat::JSON;
     ShopType shopType = ShopType::FIXEDORDERSHOP;
     DDExplorationType explorationType = DDExplorationType::STATIC;
+    NodeSelectionType nodeSelection = NodeSelectionType::DEPTH;
     MultiAlgorithmBehaviour multiAlgorithmBehaviour = MultiAlgorithmBehaviour::DIVIDE;
 
     struct {
@@ -4,7 +4,7 @@
 namespace fms::cli {
 class DDExplorationType {
 public:
-    enum Value { BREADTH, DEPTH, BEST, STATIC, ADAPTIVE };
+    enum Value { BREADTH, DEPTH, BEST, STATIC, ADAPTIVE, RESTRICTED, RELAXED };
 
     DDExplorationType() = default;
 
@@ -20,6 +20,11 @@ public:
 
     [[nodiscard]] std::string_view shortName() const;
 
+    /// @brief Whether the decision diagram is built layer by layer with a maximum width
+    [[nodiscard]] inline bool isWidthBounded() const noexcept {
+        return m_value == RESTRICTED || m_value == RELAXED;
+    }
+
 private:
     Value m_value;
 };
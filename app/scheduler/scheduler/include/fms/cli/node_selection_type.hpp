@@ -0,0 +1,28 @@
+#ifndef FMS_CLI_NODE_SELECTION_TYPE_HPP
+#define FMS_CLI_NODE_SELECTION_TYPE_HPP
+
+namespace fms::cli {
+class NodeSelectionType {
+public:
+    enum Value { DEPTH, BEST, HYBRID };
+
+    NodeSelectionType() = default;
+
+    // NOLINTNEXTLINE: Allow implicit conversion from Value so we can use it as an enum
+    constexpr NodeSelectionType(Value selectionType) : m_value(selectionType) {}
+
+    // NOLINTNEXTLINE: Allow implicit conversion to Value so we can use it in a switch
+    operator Value() const { return m_value; }
+
+    explicit operator bool() = delete;
+
+    [[nodiscard]] static NodeSelectionType parse(const std::string &name);
+
+    [[nodiscard]] std::string_view shortName() const;
+
+private:
+    Value m_value;
+};
+} // namespace fms::cli
+
+#endif // FMS_CLI_NODE_SELECTION_TYPE_HPP
@@ -3,6 +3,7 @@
 
 #include "fms/dd/dd_solution.hpp"
 #include "fms/dd/vertex.hpp"
+#include "fms/dd/vertex_pool.hpp"
 
 namespace fms::dd {
 
@@ -33,14 +34,8 @@ public:
      * @return True if the rank of the first vertex is greater than the second
      */
     bool operator()(const SharedVertex &a, const SharedVertex &b) const {
-        auto flTotalOps = static_cast<float>(totalOps);
-        auto flBestUpperBound = static_cast<float>(bestUpperBound);
-        auto aRank =
-                rankFactor * (static_cast<float>(totalOps - a->vertexDepth()) / flTotalOps)
-                + (1.0 - rankFactor) * (static_cast<float>(a->lowerBound()) / flBestUpperBound);
-        auto bRank =
-                rankFactor * (static_cast<float>(totalOps - b->vertexDepth()) / flTotalOps)
-                + (1.0 - rankFactor) * (static_cast<float>(b->lowerBound()) / flBestUpperBound);
+        auto aRank = rank(a->vertexDepth(), a->lowerBound());
+        auto bRank = rank(b->vertexDepth(), b->lowerBound());
         // auto aRank =
         //         0.5 * (static_cast<float>(totalOps - a->vertexDepth()) / flTotalOps)
         //         + 0.3 * (static_cast<float>(a->lowerBound()) / flBestUpperBound)
@@ -51,6 +46,20 @@ public:
         //         + 0.2 * ((float) rand() / (RAND_MAX));
         return aRank > bRank;
     }
+
+    /**
+     * @brief Rank of a vertex, lower is better
+     * @details It only depends on the depth and the lower bound of the vertex, so all the vertices
+     * with the same depth and lower bound have the same rank.
+     * @param depth Depth of the vertex
+     * @param lowerBound Lower bound of the vertex
+     */
+    [[nodiscard]] inline double rank(std::uint64_t depth, delay lowerBound) const {
+        auto flTotalOps = static_cast<float>(totalOps);
+        auto flBestUpperBound = static_cast<float>(bestUpperBound);
+        return rankFactor * (static_cast<float>(totalOps - depth) / flTotalOps)
+               + (1.0 - rankFactor) * (static_cast<float>(lowerBound) / flBestUpperBound);
+    }
 };
 
 /**
@@ -64,7 +73,7 @@ public:
      * @param b Second vertex to compare
      * @return True if the lower bound of the first vertex is greater than the second
      */
-    bool operator()(const std::shared_ptr<Vertex> &a, const std::shared_ptr<Vertex> &b) const {
+    bool operator()(const SharedVertex &a, const SharedVertex &b) const {
         if (a->lowerBound() == b->lowerBound()) {
             return a->vertexDepth() < b->vertexDepth();
         }
@@ -83,7 +92,7 @@ public:
      * @param b Second vertex to compare
      * @return True if the lower bound of the first vertex is less than the second
      */
-    bool operator()(const std::shared_ptr<Vertex> &a, const std::shared_ptr<Vertex> &b) const {
+    bool operator()(const SharedVertex &a, const SharedVertex &b) const {
         return a->lowerBound() < b->lowerBound();
     }
 };
@@ -19,7 +19,8 @@ class DDSolution {
 public:
     /**
      * @brief Construct a new DDSolution object
-     * @param solveStart Start time of solve
+     * @param solveStart Start time of solve, on the wall clock so that the time-out does not
+     * shrink with the number of threads
      * @param rankFactor Ranking factor
      * @param totalOps Total operations
      * @param statesTerminated List of all solutions found in the search
@@ -28,7 +29,7 @@ public:
      * @param solveData Solving data
      * @param optimal Optimality status
      */
-    DDSolution(std::chrono::milliseconds solveStart,
+    DDSolution(std::chrono::steady_clock::time_point solveStart,
                float rankFactor,
                std::uint32_t totalOps,
                std::vector<Vertex> statesTerminated = {},
@@ -59,7 +60,7 @@ private:
     nlohmann::json m_solveData;
 
     /// Start time of solve
-    std::chrono::milliseconds m_solveStart;
+    std::chrono::steady_clock::time_point m_solveStart;
 
     /// Optimality status
     bool m_optimal;
@@ -77,6 +78,11 @@ public:
      */
     [[nodiscard]] inline auto start() const noexcept { return m_solveStart; }
 
+    /// @brief Wall time since the start of the solve
+    [[nodiscard]] inline std::chrono::steady_clock::duration elapsed() const {
+        return std::chrono::steady_clock::now() - m_solveStart;
+    }
+
     /**
      * @brief Get the list of all solutions found in the search
      * @return List of all solutions found in the search
@@ -108,12 +114,9 @@ public:
         if (newSolution.lowerBound() < m_bestUpperBound) {
             m_statesTerminated.emplace_back(newSolution);
             m_bestUpperBound = newSolution.lowerBound();
-            m_solveData["anytime-solutions"].push_back(
-                    {std::chrono::duration<float>(utils::time::getCpuTime() - m_solveStart).count(),
-                     newSolution.lowerBound()});
-            m_solveData["anytime-bounds"].push_back(
-                    {std::chrono::duration<float>(utils::time::getCpuTime() - m_solveStart).count(),
-                     m_bestLowerBound});
+            const auto time = std::chrono::duration<float>(elapsed()).count();
+            m_solveData["anytime-solutions"].push_back({time, newSolution.lowerBound()});
+            m_solveData["anytime-bounds"].push_back({time, m_bestLowerBound});
         }
         if (newSolution.lowerBound() <= m_bestLowerBound) {
             m_optimal = true;
@@ -0,0 +1,140 @@
+#ifndef FMS_DD_DOMINANCE_STORE_HPP
+#define FMS_DD_DOMINANCE_STORE_HPP
+
+#include "fms/dd/vertex.hpp"
+#include "fms/dd/vertex_pool.hpp"
+#include "fms/delay.hpp"
+#include "fms/problem/flow_shop.hpp"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace fms::dd {
+
+/**
+ * @brief Data of a state that is needed for the dominance checks, computed once per state
+ * @details Besides the scheduled and ready operations as bitsets, the summary keeps the minimum
+ * and maximum slack and earliest start time of the unscheduled operations over a few blocks of
+ * consecutive vertices. A state can only dominate another state with the same scheduled and
+ * ready operations if each of its block minimums and maximums is on the dominating side, which
+ * discards most pairs without looking at the times of the vertices.
+ */
+class DominanceSummary {
+public:
+    /// @brief Number of blocks of vertices in the summary
+    static constexpr std::size_t kBlocks = 16;
+
+    DominanceSummary(const Vertex &vertex, const problem::Instance &problem);
+
+    [[nodiscard]] inline std::uint64_t completionHash() const noexcept { return m_completionHash; }
+
+    [[nodiscard]] inline bool isScheduled(cg::VertexId vId) const noexcept {
+        return test(m_scheduled, vId);
+    }
+
+    [[nodiscard]] inline bool isReady(cg::VertexId vId) const noexcept {
+        return test(m_ready, vId);
+    }
+
+    /**
+     * @brief Cheap necessary condition for the state to be dominated by @p other
+     * @return false if the state cannot be dominated by @p other , true if the exact check is
+     * needed.
+     */
+    [[nodiscard]] bool mayBeDominatedBy(const DominanceSummary &other) const noexcept;
+
+    /// @brief Number of bytes used by the summary
+    [[nodiscard]] inline std::size_t memoryUsage() const noexcept {
+        return sizeof(DominanceSummary)
+               + (m_scheduled.capacity() + m_ready.capacity()) * sizeof(std::uint64_t);
+    }
+
+private:
+    using Bitset = std::vector<std::uint64_t>;
+
+    [[nodiscard]] static inline bool test(const Bitset &bits, cg::VertexId vId) noexcept {
+        return ((bits[vId / 64] >> (vId % 64)) & 1U) != 0;
+    }
+
+    std::uint64_t m_completionHash;
+
+    /// Hash of the scheduled and ready operations, to quickly tell that they differ
+    std::uint64_t m_opsHash = 0;
+
+    Bitset m_scheduled;
+
+    Bitset m_ready;
+
+    std::size_t m_blockSize;
+
+    std::array<delay, kBlocks> m_minSlack{};
+    std::array<delay, kBlocks> m_maxSlack{};
+
+    /// Only the unscheduled operations that are not ready are used for the earliest start times
+    std::array<delay, kBlocks> m_minASAPST{};
+    std::array<delay, kBlocks> m_maxASAPST{};
+};
+
+/**
+ * @brief Checks if @p newVertex is dominated by @p oldVertex using their precomputed summaries
+ * @details The summaries must have been computed from the given vertices.
+ */
+[[nodiscard]] bool isDominated(const Vertex &newVertex,
+                               const DominanceSummary &newSummary,
+                               const Vertex &oldVertex,
+                               const DominanceSummary &oldSummary,
+                               const problem::Instance &problem);
+
+/**
+ * @brief Active states of the DD indexed by their job completion
+ * @details Only states with the same job completion can dominate each other. The states are
+ * grouped by a 64-bit hash of their job completion and keep their @ref DominanceSummary so that
+ * it is only computed once per state.
+ */
+class DominanceStore {
+public:
+    /**
+     * @brief Adds @p newVertex unless it is dominated by a stored state
+     * @details The stored states that are dominated by @p newVertex are removed.
+     * @return true if @p newVertex is dominated and it was not added.
+     */
+    [[nodiscard]] bool addIfNotDominated(const SharedVertex &newVertex,
+                                         const problem::Instance &problem);
+
+    /// @brief Removes @p vertex if it is stored
+    void erase(const Vertex &vertex);
+
+    /**
+     * @brief Adds @p vertex without checking its dominance
+     * @details Used to restore the states of a store that was saved with @ref forEach .
+     */
+    void insert(const SharedVertex &vertex, const problem::Instance &problem);
+
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_size; }
+
+    /// @brief Calls @p f with every stored state. The states of a job completion are visited in
+    /// the order in which they are compared.
+    template <typename F> void forEach(F &&f) const {
+        for (const auto &[_, bucket] : m_buckets) {
+            for (const auto &entry : bucket) {
+                f(entry.vertex);
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        SharedVertex vertex;
+        DominanceSummary summary;
+    };
+
+    std::unordered_map<std::uint64_t, std::vector<Entry>> m_buckets;
+
+    std::size_t m_size = 0;
+};
+
+} // namespace fms::dd
+
+#endif // FMS_DD_DOMINANCE_STORE_HPP
@@ -0,0 +1,115 @@
+#ifndef FMS_DD_STATE_HISTORY_HPP
+#define FMS_DD_STATE_HISTORY_HPP
+
+#include "fms/cg/constraint_graph.hpp"
+#include "fms/dd/vertex.hpp"
+#include "fms/delay.hpp"
+#include "fms/problem/operation.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace fms::dd {
+
+/// @brief What the search did with a state when it was created
+enum class StateFate : std::uint8_t {
+    QUEUED,    ///< Added to the queue of states to explore
+    PRUNED,    ///< Discarded because its lower bound is above the best upper bound
+    DOMINATED, ///< Discarded because another state dominates it
+};
+
+/// @brief Compact description of a state of the DD search
+struct HistoryRecord {
+    VertexId id{};
+    VertexId parentId{};
+    std::uint64_t depth{};
+    delay lowerBound{};
+
+    /// Operation scheduled last to reach the state, none for the root
+    std::optional<problem::Operation> lastOperation;
+
+    StateFate fate = StateFate::QUEUED;
+
+    [[nodiscard]] static HistoryRecord
+    create(const Vertex &vertex, const cg::ConstraintGraph &dg, StateFate fate);
+};
+
+/**
+ * @brief Streams a @ref HistoryRecord of every created state to a file
+ * @details The records have a fixed size and are written in the order in which the states are
+ * created, so by increasing id. Only the buffer of the stream is kept in memory.
+ */
+class HistoryWriter {
+public:
+    /// @throw FmsSchedulerException if the file cannot be created
+    explicit HistoryWriter(const std::filesystem::path &file);
+
+    void write(const HistoryRecord &record);
+
+    void flush();
+
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_size; }
+
+private:
+    std::ofstream m_out;
+    std::size_t m_size = 0;
+};
+
+/**
+ * @brief Reads the records of a file written by @ref HistoryWriter on demand
+ * @details Records are read from the file when they are accessed, so histories larger than the
+ * memory can be browsed. The reader is not thread safe.
+ */
+class HistoryReader {
+public:
+    /// @throw FmsSchedulerException if the file cannot be opened or is not a state history
+    explicit HistoryReader(const std::filesystem::path &file);
+
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_size; }
+
+    /// @brief Record at position @p index of the file
+    [[nodiscard]] HistoryRecord at(std::size_t index);
+
+    /// @brief Record of the state @p id , found by bisection because the ids are increasing
+    [[nodiscard]] std::optional<HistoryRecord> find(VertexId id);
+
+private:
+    std::filesystem::path m_file;
+    std::ifstream m_in;
+    std::size_t m_size = 0;
+};
+
+/**
+ * @brief Parent-child structure of the records of a history
+ * @details The ids of the records are increasing but not contiguous: a RELAXED search takes an id
+ * for every pairwise merge but only records the final merged state, and a resumed search only
+ * records the states created after the checkpoint. The states whose parent is not recorded are
+ * roots, like the root of the search.
+ */
+struct HistoryTree {
+    /// Returns the record at a position, from 0 to the number of records minus one
+    using RecordLookup = std::function<HistoryRecord(std::size_t)>;
+
+    /// Position of the record of each state
+    std::unordered_map<VertexId, std::size_t> positions;
+
+    /// Children of the states that have any, in the order of their records
+    std::unordered_map<VertexId, std::vector<VertexId>> children;
+
+    /// States whose parent is not recorded, by increasing id
+    std::vector<VertexId> roots;
+
+    [[nodiscard]] static HistoryTree build(std::size_t nrRecords, const RecordLookup &lookup);
+
+    /// @brief Children of @p id , empty if it has none
+    [[nodiscard]] const std::vector<VertexId> &childrenOf(VertexId id) const;
+};
+
+} // namespace fms::dd
+
+#endif // FMS_DD_STATE_HISTORY_HPP
@@ -0,0 +1,101 @@
+#ifndef FMS_DD_STATE_QUEUE_HPP
+#define FMS_DD_STATE_QUEUE_HPP
+
+#include "fms/cli/dd_exploration_type.hpp"
+#include "fms/dd/dd_solution.hpp"
+#include "fms/dd/vertex.hpp"
+#include "fms/dd/vertex_pool.hpp"
+#include "fms/delay.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace fms::dd {
+
+/**
+ * @brief Queue of the states that are still to be explored by the DD solver
+ * @details The order in which the states are popped depends on the exploration type:
+ *  - Depth: last in, first out.
+ *  - Breadth, restricted and relaxed: first in, first out.
+ *  - Best: lowest lower bound first, the deepest state if tied.
+ *  - Static and adaptive: best rank first (see @ref CompareVerticesRanking), the deepest state if
+ *    tied.
+ *
+ * The rank of a state only depends on its depth and lower bound, so the ranked states are kept in
+ * buckets of equal depth and lower bound. Popping only compares the best bucket of each depth and
+ * the ranks are computed with the current bounds, so nothing needs to be re-ordered when the
+ * bounds change. The states of a bucket are popped last in, first out.
+ *
+ * The lower bounds of all the states are counted so that the lowest one is always known.
+ */
+class StateQueue {
+public:
+    explicit StateQueue(cli::DDExplorationType explorationType);
+
+    void push(SharedVertex vertex);
+
+    /**
+     * @brief Removes the next state to explore
+     * @param solution Current bounds of the search, used to rank the states
+     * @return The removed state. The queue must not be empty.
+     */
+    [[nodiscard]] SharedVertex pop(const DDSolution &solution);
+
+    /// @brief Removes all the states and returns them in no particular order
+    [[nodiscard]] std::vector<SharedVertex> takeAll();
+
+    /// @brief Lowest lower bound of the states in the queue. The queue must not be empty.
+    [[nodiscard]] inline delay minLowerBound() const { return m_lowerBounds.begin()->first; }
+
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_size; }
+
+    [[nodiscard]] inline bool empty() const noexcept { return m_size == 0; }
+
+    /// @brief Calls @p f with every state in the queue, in no particular order
+    template <typename F> void forEach(F &&f) const {
+        for (const auto &vertex : m_ordered) {
+            f(vertex);
+        }
+        for (const auto &buckets : m_ranked) {
+            for (const auto &[_, bucket] : buckets) {
+                for (const auto &vertex : bucket) {
+                    f(vertex);
+                }
+            }
+        }
+    }
+
+private:
+    /// States of one depth by lower bound
+    using Buckets = std::map<delay, std::vector<SharedVertex>>;
+
+    [[nodiscard]] bool isRanked() const noexcept;
+
+    /// @brief Depth of the bucket to pop from in the best first exploration
+    [[nodiscard]] std::size_t bestDepth() const;
+
+    /// @brief Depth of the bucket to pop from in the static and adaptive explorations
+    [[nodiscard]] std::size_t bestRankDepth(const DDSolution &solution) const;
+
+    void removeLowerBound(delay lowerBound);
+
+    cli::DDExplorationType m_explorationType;
+
+    /// States of the depth, breadth, restricted and relaxed explorations in insertion order
+    std::deque<SharedVertex> m_ordered;
+
+    /// Buckets of the ranked explorations indexed by depth
+    std::vector<Buckets> m_ranked;
+
+    /// Number of states for each lower bound
+    std::map<delay, std::size_t> m_lowerBounds;
+
+    std::size_t m_size = 0;
+};
+
+} // namespace fms::dd
+
+#endif // FMS_DD_STATE_QUEUE_HPP
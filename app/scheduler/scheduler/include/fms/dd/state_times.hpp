@@ -0,0 +1,105 @@
+#ifndef FMS_DD_STATE_TIMES_HPP
+#define FMS_DD_STATE_TIMES_HPP
+
+#include "fms/algorithms/longest_path.hpp"
+#include "fms/cg/edge.hpp"
+#include "fms/delay.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fms::dd {
+
+/**
+ * @brief Earliest and latest start times of a DD state.
+ * @details Most scheduling decisions only change the times of a small part of the constraint
+ * graph, so the times are stored as the entries that differ from the times of a parent state.
+ * The changes are grouped in runs of consecutive vertices that moved by the same amount, which
+ * keeps the delta small when all the remaining operations of a job are delayed.
+ * Full copies are only kept for the root, for states whose times changed in a large part of the
+ * graph, and every @ref kMaxChainLength levels to bound the number of deltas applied when the
+ * times are decoded. The decoded times of the most recently used states are kept in a small
+ * per-thread cache.
+ */
+class StateTimes {
+public:
+    using Ptr = std::shared_ptr<const StateTimes>;
+
+    struct Decoded {
+        algorithms::paths::PathTimes ASAPST;
+        algorithms::paths::PathTimes ALAPST;
+    };
+    using DecodedPtr = std::shared_ptr<const Decoded>;
+
+    /// @brief Maximum number of deltas between a state and the full copy it is decoded from
+    static constexpr std::uint32_t kMaxChainLength = 32;
+
+    /// @brief Number of decoded times kept by the cache of each thread
+    static constexpr std::size_t kCacheSize = 32;
+
+    /// @brief Stores the full times, used for the root state
+    [[nodiscard]] static Ptr create(algorithms::paths::PathTimes ASAPST,
+                                    algorithms::paths::PathTimes ALAPST);
+
+    /**
+     * @brief Stores the times as the entries that differ from the times of @p parent
+     * @details Falls back to a full copy when the delta would not save at least half the memory
+     * or when the chain of deltas becomes too long. The times are added to the cache because
+     * new states are usually compared with other states right after their creation.
+     */
+    [[nodiscard]] static Ptr create(const Ptr &parent,
+                                    algorithms::paths::PathTimes ASAPST,
+                                    algorithms::paths::PathTimes ALAPST);
+
+    StateTimes(const StateTimes &) = delete;
+    StateTimes(StateTimes &&) = delete;
+    StateTimes &operator=(const StateTimes &) = delete;
+    StateTimes &operator=(StateTimes &&) = delete;
+    ~StateTimes() = default;
+
+    /// @brief Rebuilds the full times, or returns them from the cache
+    [[nodiscard]] DecodedPtr decode() const;
+
+    /// @brief Earliest start time of the terminus, kept so that ranking states does not decode
+    [[nodiscard]] inline delay lowerBound() const noexcept { return m_lowerBound; }
+
+    /// @brief State whose times are used as the base of the delta, nullptr for a full copy
+    [[nodiscard]] inline const Ptr &parent() const noexcept { return m_parent; }
+
+    [[nodiscard]] inline bool isFull() const noexcept { return m_full != nullptr; }
+
+    /// @brief Number of bytes owned by these times, excluding the ones of @ref parent
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+private:
+    /// @brief The vertices [first, first + count) changed by diff
+    struct Run {
+        std::uint32_t first;
+        std::uint32_t count;
+        /// Difference modulo 2^64, so that the change from the ASAP start value does not overflow
+        std::uint64_t diff;
+    };
+
+    StateTimes() = default;
+
+    /// @brief Unique key of the times in the cache
+    std::uint64_t m_key{};
+
+    Ptr m_parent;
+
+    /// Number of deltas to apply to the closest full copy, 0 for a full copy
+    std::uint32_t m_chainLength = 0;
+
+    delay m_lowerBound{};
+
+    DecodedPtr m_full;
+
+    std::vector<Run> m_ASAPSTDelta;
+
+    std::vector<Run> m_ALAPSTDelta;
+};
+
+} // namespace fms::dd
+
+#endif // FMS_DD_STATE_TIMES_HPP
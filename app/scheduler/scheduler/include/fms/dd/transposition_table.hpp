@@ -0,0 +1,117 @@
+#ifndef FMS_DD_TRANSPOSITION_TABLE_HPP
+#define FMS_DD_TRANSPOSITION_TABLE_HPP
+
+#include "fms/cg/constraint_graph.hpp"
+#include "fms/dd/dominance_store.hpp"
+#include "fms/dd/vertex.hpp"
+#include "fms/dd/vertex_pool.hpp"
+#include "fms/problem/flow_shop.hpp"
+#include "fms/problem/indices.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+namespace fms::dd {
+
+/**
+ * @brief Zobrist keys of the parts of a state
+ * @details The transposition hash of a state is the exclusive or of the key of the completion of
+ * each job, of the last operation of each machine and of each job at its position in the job
+ * order. A child only changes a few of them, so its hash is computed from the hash of its parent
+ * by removing the keys that changed and adding the new ones. The keys are derived from their
+ * arguments with a mixing function instead of being stored in tables.
+ */
+namespace zobrist {
+
+/// @brief splitmix64 finalizer, which turns consecutive values into unrelated keys
+[[nodiscard]] inline constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    x += 0x9e3779b97f4a7c15U;
+    x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9U;
+    x = (x ^ (x >> 27U)) * 0x94d049bb133111ebU;
+    return x ^ (x >> 31U);
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+}
+
+/// @brief Key of the job at position @p jobIdx of the output having done @p opIdx operations
+[[nodiscard]] inline constexpr std::uint64_t completionKey(std::size_t jobIdx,
+                                                           std::size_t opIdx) noexcept {
+    return mix(mix(jobIdx) ^ opIdx);
+}
+
+/// @brief Key of the operation @p vId being the last one of its machine
+[[nodiscard]] inline constexpr std::uint64_t lastOperationKey(cg::VertexId vId) noexcept {
+    return mix(~vId);
+}
+
+/// @brief Key of the job @p jobId being at @p position in the job order
+[[nodiscard]] inline constexpr std::uint64_t jobOrderKey(std::size_t position,
+                                                         problem::JobId jobId) noexcept {
+    return mix(mix(~position) ^ jobId.value);
+}
+
+/// @brief Transposition hash of @p vertex computed from scratch
+[[nodiscard]] std::uint64_t hash(const Vertex &vertex) noexcept;
+
+} // namespace zobrist
+
+/**
+ * @brief Expanded states of the DD indexed by their transposition hash
+ * @details Different scheduling orders often reach states with the same job completion, last
+ * operation per machine and job order. The table keeps the last expanded state of each hash with
+ * its @ref DominanceSummary , so a state reached again through another path is dropped if the
+ * expanded state dominates it, even after the expanded state left the @ref DominanceStore .
+ *
+ * The memory used by the stored states is estimated with @ref Vertex::memoryUsage and only the
+ * times that the state does not share with its parent are counted. When it exceeds the budget the
+ * oldest entries are removed. Relaxed states are never stored because their times are only a
+ * bound of the states that were merged into them.
+ */
+class TranspositionTable {
+public:
+    /// @param budget Maximum number of bytes used by the stored states
+    explicit TranspositionTable(std::size_t budget) : m_budget(budget) {}
+
+    /**
+     * @brief Checks if an expanded state with the same hash dominates @p vertex
+     * @details Every check of a state that is not relaxed counts as a hit or as a miss.
+     */
+    [[nodiscard]] bool isDominated(const Vertex &vertex, const problem::Instance &problem);
+
+    /// @brief Stores the expanded state @p vertex , replacing the state with the same hash
+    void insert(const SharedVertex &vertex, const problem::Instance &problem);
+
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_entries.size(); }
+
+    [[nodiscard]] inline std::size_t bytes() const noexcept { return m_bytes; }
+
+    [[nodiscard]] inline std::uint64_t hits() const noexcept { return m_hits; }
+
+    [[nodiscard]] inline std::uint64_t misses() const noexcept { return m_misses; }
+
+    [[nodiscard]] inline std::uint64_t evictions() const noexcept { return m_evictions; }
+
+private:
+    struct Entry {
+        SharedVertex vertex;
+        DominanceSummary summary;
+        std::size_t bytes;
+    };
+
+    std::size_t m_budget;
+    std::size_t m_bytes = 0;
+
+    std::unordered_map<std::uint64_t, Entry> m_entries;
+
+    /// Hashes of the entries from the oldest to the newest
+    std::deque<std::uint64_t> m_order;
+
+    std::uint64_t m_hits = 0;
+    std::uint64_t m_misses = 0;
+    std::uint64_t m_evictions = 0;
+};
+
+} // namespace fms::dd
+
+#endif // FMS_DD_TRANSPOSITION_TABLE_HPP
@@ -4,6 +4,7 @@
 #include "fms/algorithms/hash.hpp"
 #include "fms/algorithms/longest_path.hpp"
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/dd/state_times.hpp"
 #include "fms/problem/flow_shop.hpp"
 #include "fms/problem/indices.hpp"
 
@@ -26,20 +27,19 @@ public:
      * @param id The unique identifier of the vertex.
      * @param parentId The unique identifier of the parent vertex.
      * @param sequences The sequences of machines associated with the vertex
-     * @param ASAPST The earliest start time of each path from source to this vertex.
-     * @param ALAPST The latest start time of each path from source to this vertex.
+     * @param times The earliest and latest start time of each operation in this vertex.
      * @param jobsCompletion Mapping of job index to operation index representing job completions.
      * @param jobOrder Order of jobs associated with the vertex.
      * @param lastOperation Mapping of machine to vertex representing the last operation.
      * @param scheduledOps Vertices IDs of operations scheduled.
      * @param vertexDepth Depth of the vertex in the delay graph.
-     * @param encounteredOps Vertices IDs of encountered operations.
+     * @param encounteredOps Vertices IDs of encountered operations. Empty if they are the same as
+     * @p scheduledOps .
      */
     Vertex(VertexId id,
            VertexId parentId,
            MachinesSequences sequences,
-           algorithms::paths::PathTimes ASAPST,
-           algorithms::paths::PathTimes ALAPST,
+           StateTimes::Ptr times,
            JobIdxToOpIdx jobsCompletion,
            std::vector<problem::JobId> jobOrder,
            MachineToVertex lastOperation,
@@ -49,8 +49,7 @@ public:
         m_id(id),
         m_parentId(parentId),
         m_machinesSequences(std::move(sequences)),
-        m_ASAPST(std::move(ASAPST)),
-        m_ALAPST(std::move(ALAPST)),
+        m_times(std::move(times)),
         m_jobsCompletion(std::move(jobsCompletion)),
         m_jobOrder(std::move(jobOrder)),
         m_lastOperation(std::move(lastOperation)),
@@ -81,11 +80,13 @@ public:
 
     [[nodiscard]] inline VertexId parentId() const noexcept { return m_parentId; }
 
-    [[nodiscard]] inline delay lowerBound() const noexcept { return m_ASAPST.back(); }
+    [[nodiscard]] inline delay lowerBound() const noexcept { return m_times->lowerBound(); }
 
     [[nodiscard]] inline std::uint64_t vertexDepth() const noexcept { return m_vertexDepth; }
 
-    [[nodiscard]] inline problem::JobOperations readyOps() const noexcept { return m_readyOps; }
+    [[nodiscard]] inline const problem::JobOperations &readyOps() const noexcept {
+        return m_readyOps;
+    }
 
     /**
      * @brief Retrieves the vector of immediately ready operations associated with the vertex.
@@ -109,10 +110,12 @@ public:
         return allImmediateOps;
     }
 
-    [[nodiscard]] inline cg::VerticesIds scheduledOps() const noexcept { return m_scheduledOps; }
+    [[nodiscard]] inline const cg::VerticesIds &scheduledOps() const noexcept {
+        return m_scheduledOps;
+    }
 
-    [[nodiscard]] inline cg::VerticesIds encounteredOps() const noexcept {
-        return m_encounteredOps;
+    [[nodiscard]] inline const cg::VerticesIds &encounteredOps() const noexcept {
+        return m_encounteredOps.empty() ? m_scheduledOps : m_encounteredOps;
     }
 
     [[nodiscard]] inline const auto &getMachinesSequences() const noexcept { return m_machinesSequences; }
@@ -132,22 +135,32 @@ public:
      * @return Vector associating @ref cg::VertexID to its ALAPST. This in turn can be used
      * to determine the latest start time of each operation.
      */
-    [[nodiscard]] inline const auto &getALAPST() const noexcept { return m_ALAPST; }
-
-    inline void setALAPST(algorithms::paths::PathTimes newALAPST) { m_ALAPST = std::move(newALAPST); }
+    [[nodiscard]] inline algorithms::paths::PathTimes getALAPST() const {
+        return m_times->decode()->ALAPST;
+    }
 
     /**
      * @brief Retrieves the As Soon as Possible Start Time.
      * @return Vector associating @ref cg::VertexID to its ASAPST. This in turn can be used
      * to determine the earliest start time of each operation.
      */
-    [[nodiscard]] inline const auto &getASAPST() const noexcept { return m_ASAPST; }
+    [[nodiscard]] inline algorithms::paths::PathTimes getASAPST() const {
+        return m_times->decode()->ASAPST;
+    }
 
-    /// @details This is an overloaded function. It differs from @ref getASAPST() in that it returns
-    /// a mutable reference to the ASAPST.
-    [[nodiscard]] inline auto getASAPST() noexcept { return m_ASAPST; }
+    /**
+     * @brief Retrieves the encoded start times
+     * @details Use `getTimes()->decode()` to read the times without copying them.
+     */
+    [[nodiscard]] inline const StateTimes::Ptr &getTimes() const noexcept { return m_times; }
 
-    inline void setASAPST(algorithms::paths::PathTimes newASAPST) { m_ASAPST = std::move(newASAPST); }
+    /**
+     * @brief Estimates the memory used by the vertex
+     * @details The times are not included because they can be shared with other vertices, see
+     * @ref StateTimes::memoryUsage .
+     * @return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
 
     [[nodiscard]] inline const auto &getJobsCompletion() const noexcept { return m_jobsCompletion; }
 
@@ -160,6 +173,22 @@ public:
 
     inline void setTerminal(bool value) noexcept { m_terminal = value; }
 
+    /// @brief Check whether the vertex comes from a merge of vertices.
+    /// @details The times of a relaxed vertex are a lower bound of the times of the merged
+    /// vertices and of their children, so a relaxed terminal vertex is not a valid solution.
+    /// @return `true` if the vertex or one of its ancestors was merged, `false` otherwise.
+    [[nodiscard]] inline bool isRelaxed() const noexcept { return m_relaxed; }
+
+    inline void setRelaxed(bool value) noexcept { m_relaxed = value; }
+
+    /// @brief Zobrist hash of the job completion, last operation per machine and job order (see
+    /// @ref zobrist::hash )
+    [[nodiscard]] inline std::uint64_t transpositionHash() const noexcept {
+        return m_transpositionHash;
+    }
+
+    inline void setTranspositionHash(std::uint64_t value) noexcept { m_transpositionHash = value; }
+
     [[nodiscard]] inline const auto &getJobOrder() const noexcept { return m_jobOrder; }
 
     inline void setJobOrder(std::vector<problem::JobId> newJobOrder) {
@@ -246,11 +275,8 @@ private:
     /// Sequences of operations per machine
     MachinesSequences m_machinesSequences;
 
-    /// Current known earliest start times
-    algorithms::paths::PathTimes m_ASAPST;
-
-    /// Current known latest start times
-    algorithms::paths::PathTimes m_ALAPST;
+    /// Current known earliest and latest start times
+    StateTimes::Ptr m_times;
 
     /// Index of the next operation to do for each job. The index is not an OperationId but an index
     /// in the vector of operations of the job.
@@ -259,6 +285,12 @@ private:
     // True if state is a terminal state i.e. all operations of all jobs have been scheduled
     bool m_terminal = false;
 
+    /// True if the state or one of its ancestors was created by merging states
+    bool m_relaxed = false;
+
+    /// Kept up to date by the solver when the state is created
+    std::uint64_t m_transpositionHash = 0;
+
     /// Index of the job ordering, used in state expansion when no overtaking is allowed
     /// Job order inferred and filled from the relationship between initial operations of jobs in
     /// that state Immaterial for job shops unless no overtaking specified (case currently not
@@ -277,22 +309,21 @@ private:
     /// @brief Operations already scheduled in this state
     /// @details In the full decision diagram, they are exactly equal to m_scheduledOps. It takes on
     /// meaning in the relaxed decision diagram when we merge. It is the union of scheduled ops of
-    /// all states that were merged to create new state
+    /// all states that were merged to create new state. It is only stored when it differs from
+    /// m_scheduledOps.
     cg::VerticesIds m_encounteredOps;
 
     /// Vertex depth to use for node selection
     std::uint64_t m_vertexDepth;
 };
 
-using SharedVertex = std::shared_ptr<dd::Vertex>;
-
 } // namespace fms::dd
 
 template <> struct std::hash<fms::dd::JobIdxToOpIdx> {
     std::size_t operator()(const fms::dd::JobIdxToOpIdx &k) const {
         std::size_t result = 0;
         for (const auto &i : k) {
-            fms::algorithms::hash_combine(result, i);
+            result = fms::algorithms::hash_combine(result, i);
         }
         return result;
     }
@@ -0,0 +1,170 @@
+#ifndef FMS_DD_VERTEX_POOL_HPP
+#define FMS_DD_VERTEX_POOL_HPP
+
+#include "fms/dd/vertex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace fms::dd {
+
+class VertexPool;
+
+namespace detail {
+
+/// @brief Storage of a pooled vertex together with its reference count
+struct VertexSlot {
+    alignas(Vertex) std::byte storage[sizeof(Vertex)];
+    VertexPool *pool;
+    VertexSlot *nextFree;
+    std::uint32_t refs;
+    std::uint32_t level;
+
+    [[nodiscard]] inline Vertex *vertex() noexcept {
+        return std::launder(reinterpret_cast<Vertex *>(storage));
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Handle to a vertex allocated by a @ref VertexPool
+ * @details Behaves like a `std::shared_ptr<Vertex>` but the reference count is stored next to the
+ * vertex and is not atomic, so a handle and its copies must only be used by one thread at a time.
+ */
+class VertexPtr {
+public:
+    VertexPtr() noexcept = default;
+    VertexPtr(std::nullptr_t) noexcept {} // NOLINT(google-explicit-constructor)
+
+    VertexPtr(const VertexPtr &other) noexcept : m_slot(other.m_slot) {
+        if (m_slot != nullptr) {
+            ++m_slot->refs;
+        }
+    }
+
+    VertexPtr(VertexPtr &&other) noexcept : m_slot(std::exchange(other.m_slot, nullptr)) {}
+
+    ~VertexPtr() { reset(); }
+
+    VertexPtr &operator=(const VertexPtr &other) noexcept {
+        VertexPtr(other).swap(*this);
+        return *this;
+    }
+
+    VertexPtr &operator=(VertexPtr &&other) noexcept {
+        VertexPtr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    inline void swap(VertexPtr &other) noexcept { std::swap(m_slot, other.m_slot); }
+
+    void reset() noexcept;
+
+    [[nodiscard]] inline Vertex *get() const noexcept {
+        return m_slot == nullptr ? nullptr : m_slot->vertex();
+    }
+
+    [[nodiscard]] inline Vertex &operator*() const noexcept { return *m_slot->vertex(); }
+
+    [[nodiscard]] inline Vertex *operator->() const noexcept { return m_slot->vertex(); }
+
+    [[nodiscard]] inline explicit operator bool() const noexcept { return m_slot != nullptr; }
+
+    [[nodiscard]] inline std::uint32_t useCount() const noexcept {
+        return m_slot == nullptr ? 0 : m_slot->refs;
+    }
+
+    [[nodiscard]] inline bool operator==(const VertexPtr &rhs) const noexcept {
+        return m_slot == rhs.m_slot;
+    }
+
+    [[nodiscard]] inline bool operator==(std::nullptr_t) const noexcept {
+        return m_slot == nullptr;
+    }
+
+private:
+    friend class VertexPool;
+
+    explicit VertexPtr(detail::VertexSlot *slot) noexcept : m_slot(slot) {}
+
+    detail::VertexSlot *m_slot = nullptr;
+};
+
+/**
+ * @brief Allocates the vertices of the DD solver in slabs, one set of slabs per vertex depth
+ * @details Vertices of the same depth are created and discarded together during the search, so
+ * each depth gets its own slabs. Freed vertices are reused by the next vertex of the same depth
+ * and the slabs of a depth are returned to the heap as soon as its last vertex is released.
+ *
+ * The pool is owned through a `std::shared_ptr`. It stays alive until both the last owner and
+ * the last vertex are gone, so vertices can safely outlive the solver data that created them.
+ */
+class VertexPool {
+public:
+    /// @brief Number of vertices in the first slab of a depth
+    static constexpr std::size_t kMinSlabSize = 16;
+
+    /// @brief The slabs double in size up to this number of vertices
+    static constexpr std::size_t kMaxSlabSize = 1024;
+
+    [[nodiscard]] static std::shared_ptr<VertexPool> create();
+
+    VertexPool(const VertexPool &) = delete;
+    VertexPool(VertexPool &&) = delete;
+    VertexPool &operator=(const VertexPool &) = delete;
+    VertexPool &operator=(VertexPool &&) = delete;
+
+    /**
+     * @brief Moves @p vertex into the slabs of its depth
+     * @return Handle to the pooled vertex
+     */
+    [[nodiscard]] VertexPtr make(Vertex &&vertex);
+
+    /// @brief Number of vertices that are still referenced
+    [[nodiscard]] inline std::size_t liveVertices() const noexcept { return m_live; }
+
+    /// @brief Number of bytes currently held in slabs
+    [[nodiscard]] std::size_t reservedBytes() const noexcept;
+
+private:
+    struct Level {
+        std::vector<std::unique_ptr<detail::VertexSlot[]>> slabs;
+        std::size_t lastSlabSize = 0;
+        std::size_t lastSlabUsed = 0;
+        detail::VertexSlot *freeList = nullptr;
+        std::size_t live = 0;
+    };
+
+    friend class VertexPtr;
+
+    VertexPool() = default;
+    ~VertexPool() = default;
+
+    /// @brief Destroys the vertex of @p slot and frees its depth if it was the last one
+    void release(detail::VertexSlot *slot) noexcept;
+
+    void deleteIfUnused() noexcept;
+
+    std::vector<Level> m_levels;
+
+    std::size_t m_live = 0;
+    bool m_orphaned = false;
+};
+
+inline void VertexPtr::reset() noexcept {
+    auto *slot = std::exchange(m_slot, nullptr);
+    if (slot != nullptr && --slot->refs == 0) {
+        slot->pool->release(slot);
+    }
+}
+
+using SharedVertex = VertexPtr;
+
+} // namespace fms::dd
+
+#endif // FMS_DD_VERTEX_POOL_HPP
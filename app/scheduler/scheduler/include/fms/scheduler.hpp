@@ -27,11 +27,13 @@ public:
     /**
      * @brief Checks that the flow shop is consistent
      * @param flowshop Flowshop whose consistency to check
+     * @param nrThreads Number of threads used to compute the longest paths
      * @return std::pair<bool, std::vector<delay>> The first element is true when the initial graph
      * is consistent, false otherwise. The second element is a vector of the earliest possible
      * starting times of operations given the initial constraints.
      */
-    static std::pair<bool, std::vector<delay>> checkConsistency(const problem::Instance &flowshop);
+    static std::pair<bool, std::vector<delay>> checkConsistency(const problem::Instance &flowshop,
+                                                                std::size_t nrThreads = 1);
 
     /**
      * @brief Runs the selected algorithm as provided by CLIArgs::algorithm.
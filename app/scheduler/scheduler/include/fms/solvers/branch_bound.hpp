@@ -3,22 +3,65 @@
 
 #include "fms/algorithms/longest_path.hpp"
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
 #include "fms/problem/flow_shop.hpp"
 #include "fms/problem/indices.hpp"
 #include "fms/solvers/solver.hpp"
 
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 namespace fms::solvers::branch_bound {
 
+/**
+ * @brief Node of the search tree
+ * @details The times are evaluated on the constraint graph of the search, whose edges are
+ * traversed through a snapshot taken once per search (the `csr` parameters).
+ */
 class BranchBoundNode {
 public:
+    /// @brief Evaluates the earliest start times of @p solution from scratch
     BranchBoundNode(const problem::Instance &problem,
-                    cg::ConstraintGraph &dg,
+                    const cg::ConstraintGraph &dg,
+                    const cg::CSRGraph &csr,
                     const PartialSolution &solution,
                     delay trivialLowerBound);
 
+    /**
+     * @brief Evaluates @p solution , a child of @p parent , from the times of its parent
+     * @details Only the edges that @p solution adds to the sequences of @p parent are
+     * propagated, so the cost depends on the vertices whose times change. The node keeps these
+     * edges and @p parentASAPST instead of its own times, which are rebuilt the same way by
+     * @ref getASAPST . The times are evaluated from scratch if the child removes an edge of its
+     * parent that the added edges do not imply, because the times of the parent are then not a
+     * lower bound of its own.
+     * @param parentASAPST Earliest start times of @p parent , see @ref getASAPST
+     */
+    BranchBoundNode(const problem::Instance &problem,
+                    const cg::ConstraintGraph &dg,
+                    const cg::CSRGraph &csr,
+                    const BranchBoundNode &parent,
+                    std::shared_ptr<const algorithms::paths::PathTimes> parentASAPST,
+                    const PartialSolution &solution,
+                    delay trivialLowerBound);
+
+    /**
+     * @brief Restores a node that was evaluated before from its bounds
+     * @details Nothing is evaluated, the times are rebuilt by @ref getASAPST .
+     * @param parentASAPST Times of the parent that @p addedEdges are added to, or nothing if the
+     * times are evaluated from scratch
+     */
+    BranchBoundNode(const problem::Instance &problem,
+                    PartialSolution solution,
+                    delay lowerbound,
+                    delay makespan,
+                    std::shared_ptr<const algorithms::paths::PathTimes> parentASAPST,
+                    cg::Edges addedEdges);
+
     [[nodiscard]] const PartialSolution &getSolution() const { return solution; }
 
     [[nodiscard]] delay getLowerbound() const { return lowerbound; }
@@ -29,30 +72,81 @@ public:
         return lastInsertedOperation;
     }
 
+    /// @brief Edges added to the times of the parent, empty if the node is evaluated from scratch
+    [[nodiscard]] const cg::Edges &getAddedEdges() const { return addedEdges; }
+
+    /// @brief Vertices whose times changed from the parent, if the node was evaluated from it
+    [[nodiscard]] std::optional<std::size_t> getTouchedVertices() const { return touchedVertices; }
+
     algorithms::paths::PathTimes getASAPST(const problem::Instance &problem,
-                                           cg::ConstraintGraph &dg) const;
+                                           const cg::ConstraintGraph &dg,
+                                           const cg::CSRGraph &csr) const;
 
 private:
+    void setBounds(const problem::Instance &problem,
+                   const algorithms::paths::PathTimes &ASAPST,
+                   delay trivialLowerBound);
+
+    /// @brief Computes the times over the whole graph, ignoring the parent
+    algorithms::paths::PathTimes computeASAPST(const problem::Instance &problem,
+                                               const cg::ConstraintGraph &dg,
+                                               const cg::CSRGraph &csr) const;
+
+    /**
+     * @brief Adds @ref addedEdges to @p ASAPST , the times of the parent
+     * @return Number of vertices whose times changed, or nothing if the edges create a positive
+     * cycle
+     */
+    std::optional<std::size_t> propagateAddedEdges(const problem::Instance &problem,
+                                                   const cg::ConstraintGraph &dg,
+                                                   const cg::CSRGraph &csr,
+                                                   algorithms::paths::PathTimes &ASAPST) const;
+
     PartialSolution solution;
     delay lowerbound;
     delay makespan;
     problem::Operation lastInsertedOperation;
+
+    /// Times of the parent and edges that the node adds to them, empty if the node is evaluated
+    /// from scratch
+    std::shared_ptr<const algorithms::paths::PathTimes> parentASAPST;
+    cg::Edges addedEdges;
+    std::optional<std::size_t> touchedVertices;
 };
 
 bool operator>(const BranchBoundNode &lhs, const BranchBoundNode &rhs);
 
-PartialSolution solve(problem::Instance &problemInstance, const cli::CLIArgs &args);
+/**
+ * @brief Solves the instance with a branch and bound seeded with BHCS and MD-BHCS
+ * @details The open nodes are expanded depth-first, best-first or with the hybrid of both
+ * (`--node-selection`), and are stored in a @ref NodeTree that is bounded by `--node-memory`.
+ * With more than one thread (`--threads`) every thread keeps its own depth-first stack of open
+ * nodes instead and steals the oldest node of another thread when its stack is empty, so it does
+ * not support another node selection nor a memory budget. The makespan of the best solution is
+ * shared by all threads to prune their nodes. The search ends when every stack is empty and no
+ * thread is expanding a node, or when the time limit (wall clock time in the parallel search) is
+ * exceeded.
+ * @return The best solution found and the statistics of the search: the number of expanded,
+ * pruned, complete and stolen nodes, the vertices whose times changed in the nodes evaluated from
+ * their parent, the memory used by the open nodes, and the time until the best solution was
+ * found and until the search ended
+ * @throws FmsSchedulerException If a node selection other than depth-first or a node memory
+ * budget is combined with more than one thread
+ */
+std::tuple<PartialSolution, nlohmann::json> solve(problem::Instance &problemInstance,
+                                                  const cli::CLIArgs &args);
 cg::Edges create_initial_sequence(const problem::Instance &problemInstance,
                                   unsigned int reentrant_machine);
 
 delay createTrivialCompletionLowerBound(const problem::Instance &problem);
 Solutions
-ranked(cg::ConstraintGraph &dg,
+ranked(const cg::ConstraintGraph &dg,
        const problem::Instance &problem,
        const std::vector<std::pair<PartialSolution, SchedulingOption>> &generationOfSolutions,
        const std::vector<delay> &ASAPTimes);
 
-Solutions scheduleOneOperation(cg::ConstraintGraph &dg,
+Solutions scheduleOneOperation(const cg::ConstraintGraph &dg,
+                               const cg::CSRGraph &csr,
                                const problem::Instance &,
                                const PartialSolution &current_solution,
                                const cg::Vertex &);
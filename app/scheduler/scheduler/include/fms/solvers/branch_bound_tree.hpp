@@ -0,0 +1,179 @@
+#ifndef FMS_SOLVERS_BRANCH_BOUND_TREE_HPP
+#define FMS_SOLVERS_BRANCH_BOUND_TREE_HPP
+
+#include "fms/algorithms/longest_path.hpp"
+#include "fms/cg/edge.hpp"
+#include "fms/cli/node_selection_type.hpp"
+#include "fms/problem/flow_shop.hpp"
+#include "fms/problem/indices.hpp"
+#include "fms/problem/operation.hpp"
+#include "fms/solvers/branch_bound.hpp"
+#include "fms/solvers/partial_solution.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace fms::solvers::branch_bound {
+
+/**
+ * @brief Open nodes of the branch and bound and the expanded nodes that they descend from
+ * @details A node is stored as the operation that it inserts in the sequence of the re-entrant
+ * machine of its parent, the index of its parent and the edges that it adds to the times of its
+ * parent (see @ref BranchBoundNode::getAddedEdges ). Its solution is rebuilt from the root when
+ * it is expanded. An expanded node keeps its times while its children need them; when the
+ * estimated memory exceeds the budget the oldest times are dropped and the children of these
+ * nodes are evaluated from scratch. A node is removed once it was expanded and none of its
+ * descendants is open.
+ *
+ * The next node is chosen by the selection policy:
+ *  - depth: the newest open node, the most likely optimal child of the last expansion;
+ *  - best: the open node with the smallest lower bound, the deepest one on ties;
+ *  - hybrid: dives depth-first until it reaches a complete schedule or prunes the whole dive, and
+ *    then selects best-first while the memory stays within the budget, diving again when it does
+ *    not.
+ */
+class NodeTree {
+public:
+    using Index = std::size_t;
+
+    /// @param budget Maximum number of bytes used by the nodes, see @ref bytes
+    NodeTree(const problem::Instance &problem,
+             const BranchBoundNode &root,
+             cli::NodeSelectionType selection,
+             std::size_t budget);
+
+    /// @brief Takes the next open node according to the selection policy
+    /// @return The index of the node, or nothing if no node is open
+    [[nodiscard]] std::optional<Index> pop();
+
+    /// @brief Rebuilds the node @p index , which must not have been released
+    [[nodiscard]] BranchBoundNode restore(Index index) const;
+
+    /// @brief Keeps the times of the node @p index being expanded for its children
+    void setTimes(Index index, std::shared_ptr<const algorithms::paths::PathTimes> times);
+
+    /**
+     * @brief Adds the open node @p child to the children of @p parent
+     * @param parentSolution Solution of @p parent , which @p child inserts one operation in
+     */
+    void
+    addChild(Index parent, const PartialSolution &parentSolution, const BranchBoundNode &child);
+
+    /// @brief Marks the node @p index as processed, removing it once it has no open descendants
+    void release(Index index);
+
+    /// @brief Smallest lower bound of the open nodes, if any
+    [[nodiscard]] std::optional<delay> lowerBound() const;
+
+    [[nodiscard]] inline std::size_t openNodes() const noexcept { return m_open; }
+
+    /// @brief Estimated number of bytes used by the live nodes, their times and the open lists
+    /// @details The capacity of the containers is not counted because it never shrinks, so the
+    /// hybrid selection could not go back to best-first once the budget was exceeded.
+    [[nodiscard]] std::size_t bytes() const noexcept;
+
+    [[nodiscard]] inline std::size_t peakBytes() const noexcept { return m_peakBytes; }
+
+    [[nodiscard]] inline std::size_t peakOpenNodes() const noexcept { return m_peakOpen; }
+
+    /// @brief Number of expanded nodes whose times were dropped to stay within the budget
+    [[nodiscard]] inline std::uint64_t evictions() const noexcept { return m_evictions; }
+
+    /// @brief Number of times that the hybrid selection started to dive
+    [[nodiscard]] inline std::uint64_t dives() const noexcept { return m_dives; }
+
+private:
+    static constexpr Index kNoParent = std::numeric_limits<Index>::max();
+
+    struct Record {
+        Index parent;
+        /// Creation number, which identifies the node in the open lists after its slot is reused
+        std::uint64_t order;
+        problem::Operation operation;
+        std::uint32_t position;
+        std::uint32_t firstFeasible;
+        std::uint32_t depth;
+        /// Open descendants that are children of this node, plus one while it is open or expanded
+        std::uint32_t references;
+        delay lowerbound;
+        delay makespan;
+        bool open;
+        /// Whether the times are computed from the ones of the parent
+        bool incremental;
+        cg::Edges addedEdges;
+        std::shared_ptr<const algorithms::paths::PathTimes> times;
+    };
+
+    struct OpenEntry {
+        delay lowerbound;
+        std::uint32_t depth;
+        std::uint64_t order;
+        Index index;
+
+        /// @brief Order of the best-first heap, whose top is the smallest lower bound
+        friend bool operator<(const OpenEntry &lhs, const OpenEntry &rhs) {
+            return std::tie(rhs.lowerbound, lhs.depth, lhs.order)
+                   < std::tie(lhs.lowerbound, rhs.depth, rhs.order);
+        }
+    };
+
+    Index add(Record record);
+
+    [[nodiscard]] bool isOpen(const OpenEntry &entry) const;
+
+    [[nodiscard]] std::optional<Index> popNewest();
+
+    [[nodiscard]] std::optional<Index> popBest();
+
+    /// @brief Removes the entries of the nodes that are no longer open once they outnumber the
+    /// open nodes, which are all in each open list
+    void compactOpenLists();
+
+    /// @brief Drops the oldest times until the nodes fit in the budget
+    void evictTimes();
+
+    void dropTimes(Record &record);
+
+    void updatePeak();
+
+    const problem::Instance &m_problem;
+    problem::MachineId m_machine;
+    PartialSolution m_root;
+    cli::NodeSelectionType m_selection;
+    std::size_t m_budget;
+
+    std::vector<Record> m_records;
+    std::vector<Index> m_free;
+    std::uint64_t m_order = 0;
+
+    /// Open nodes, the newest last, for the depth-first selection
+    std::vector<OpenEntry> m_newest;
+    /// Open nodes for the best-first selection, a heap ordered by OpenEntry::operator<
+    std::vector<OpenEntry> m_best;
+    /// Number of open nodes per lower bound
+    std::map<delay, std::size_t> m_openBounds;
+    std::size_t m_open = 0;
+
+    /// Nodes that keep their times, the oldest first
+    std::deque<std::pair<Index, std::uint64_t>> m_timesOrder;
+
+    std::size_t m_edgeBytes = 0;
+    std::size_t m_timeBytes = 0;
+    std::size_t m_peakBytes = 0;
+    std::size_t m_peakOpen = 0;
+    std::uint64_t m_evictions = 0;
+
+    bool m_diving;
+    std::size_t m_childrenSinceLastPop;
+    std::uint64_t m_dives;
+};
+
+} // namespace fms::solvers::branch_bound
+
+#endif // FMS_SOLVERS_BRANCH_BOUND_TREE_HPP
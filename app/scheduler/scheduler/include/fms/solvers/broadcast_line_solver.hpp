@@ -22,6 +22,7 @@ class ErrorStrings {
 public:
     static constexpr auto kNoConvergence = "no-convergence";
     static constexpr auto kLocalScheduler = "local-scheduler";
+    static constexpr auto kNoLocalSolution = "no-local-solution";
     static constexpr auto kTimeOut = "time-out";
 };
 
@@ -75,10 +76,12 @@ translateBounds(const problem::ProductionLine &problemInstance,
  *
  * @param problemInstance Global problem instance.
  * @param solutions Vector of feasible solutions from each module.
+ * @param nrThreads Number of threads used to check the merged solution of each module.
  * @return fms::ProductionLineSolution Feasible solution to the global problem.
  */
 ProductionLineSolution mergeSolutions(const problem::ProductionLine &problemInstance,
-                                      ModulesSolutions &solutions);
+                                      ModulesSolutions &solutions,
+                                      std::size_t nrThreads = 1);
 
 /**
  * @brief Compare two sets of intervals and check if they are converged.
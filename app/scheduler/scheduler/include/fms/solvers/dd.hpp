@@ -5,13 +5,21 @@
 #include "solver_data.hpp"
 
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
 #include "fms/cg/edge.hpp"
+#include "fms/cg/graph_overlay.hpp"
 #include "fms/dd/dd_solution.hpp"
+#include "fms/dd/dominance_store.hpp"
+#include "fms/dd/state_history.hpp"
+#include "fms/dd/state_queue.hpp"
+#include "fms/dd/transposition_table.hpp"
 #include "fms/dd/vertex.hpp"
+#include "fms/dd/vertex_pool.hpp"
 #include "fms/problem/flow_shop.hpp"
 
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <vector>
 
 namespace fms::solvers {
@@ -22,16 +30,14 @@ namespace fms::solvers {
  */
 namespace dd {
 using namespace fms::dd;
-using JobIdxToVertices =
-        std::unordered_map<JobIdxToOpIdx,
-                           std::unordered_map<std::uint64_t, std::shared_ptr<Vertex>>>;
-using IdToVertex = std::unordered_map<std::uint64_t, std::shared_ptr<Vertex>>;
-using StatesT = std::deque<SharedVertex>;
+using IdToVertex = std::unordered_map<std::uint64_t, SharedVertex>;
 
 struct TerminationStrings {
     static constexpr auto kTimeOut = "time-out";
     static constexpr auto kNoSolution = "no-solution";
     static constexpr auto kOptimal = "optimal";
+    /// The restricted or relaxed diagram was explored completely without proving optimality
+    static constexpr auto kCompleted = "completed";
 };
 
 constexpr auto kStoreHistory = "store-history";
@@ -41,40 +47,68 @@ constexpr auto kStoreHistory = "store-history";
  * @tparam T Queue type used by the solver.
  */
 struct DDSolverData : public SolverData {
+    /// Allocator of the states. It is shared by the copies of the data because their states are
+    /// shared too.
+    std::shared_ptr<VertexPool> pool;
+
     /// Queue of states to be explored by the algorithm
-    StatesT states;
+    StateQueue states;
 
     /// All states that have been explored
     std::deque<SharedVertex> allStates;
 
+    /// Sink of the records of the created states, if they are streamed to a file
+    std::shared_ptr<HistoryWriter> history;
+
+    /// Expanded states that a state reached through another path is compared to, if enabled
+    std::shared_ptr<TranspositionTable> transpositions;
+
     /// Next vertex id to be used
     std::uint64_t nextVertexId;
 
     DDSolution solution;
     cg::ConstraintGraph dg;
 
+    /// Snapshot of @ref dg through which the expansions traverse its edges
+    cg::CSRGraph csr;
+
     cli::DDExplorationType explorationType;
     bool keepActiveVerticesSparse;
     bool storeAllStates;
 
     // To check for possible merging we keep track the current "active" vertices in a searchable
-    // data structure. The active vertices are the ones still inside the queue. The weak_ptr
-    // tells us if the vertex is still alive.
-    dd::JobIdxToVertices activeVertices;
+    // data structure. The active vertices are the ones still inside the queue.
+    dd::DominanceStore activeVertices;
+
+    /// Maximum number of states per layer of the restricted and relaxed diagrams
+    std::size_t maxWidth = std::numeric_limits<std::size_t>::max();
+
+    /// States of the current layer that are still in the queue (restricted and relaxed diagrams)
+    std::size_t layerStatesLeft = 0;
+
+    /// Children whose earliest start times were propagated from the times of their parent, and
+    /// total number of vertices that the propagations changed
+    std::uint64_t incrementalChildren = 0;
+    std::uint64_t touchedVertices = 0;
+
+    /// Lowest bound of the states that left the search without being expanded or becoming a
+    /// solution: the states dropped by the restricted diagram and the relaxed terminal states
+    delay discardedLowerBound = std::numeric_limits<delay>::max();
 
     DDSolverData(cli::DDExplorationType explorationType,
                  DDSolution solution,
                  cg::ConstraintGraph dg,
                  bool keepActiveVerticesSparse,
                  bool storeAllStates = false,
-                 StatesT states = {},
                  std::deque<SharedVertex> allStates = {},
                  std::uint64_t nextVertexId = 0) :
-        states(std::move(states)),
+        pool(VertexPool::create()),
+        states(explorationType),
         allStates(std::move(allStates)),
         nextVertexId(nextVertexId),
         solution(std::move(solution)),
         dg(std::move(dg)),
+        csr(this->dg),
         explorationType(explorationType),
         keepActiveVerticesSparse(keepActiveVerticesSparse),
         storeAllStates(storeAllStates) {}
@@ -86,7 +120,16 @@ struct DDSolverData : public SolverData {
     DDSolverData &operator=(DDSolverData &&) = default;
     DDSolverData &operator=(const DDSolverData &) = default;
 
-    void storeState(const SharedVertex &newVertex);
+    /// @brief Records a new state in the history, if it is kept in memory or streamed to a file
+    void storeState(const SharedVertex &newVertex, StateFate fate = StateFate::QUEUED);
+
+    /**
+     * @brief Checks if a state that dominates @p state was already expanded, and records @p state
+     * as expanded otherwise
+     * @return true if @p state does not need to be expanded
+     */
+    [[nodiscard]] bool isTransposition(const SharedVertex &state,
+                                       const problem::Instance &problemInstance);
 };
 
 using DDSolverDataPtr = std::unique_ptr<DDSolverData>;
@@ -117,9 +160,10 @@ solveWrap(problem::Instance &problemInstance, const cli::CLIArgs &args, DDSolver
 
 [[nodiscard]] Solutions extractSolutions(const std::vector<Vertex> &statesTerminated);
 
-void removeActiveVertex(dd::JobIdxToVertices &activeVertices, const Vertex &v);
+void removeActiveVertex(dd::DominanceStore &activeVertices, const Vertex &v);
 
-[[nodiscard]] SharedVertex createNewVertex(std::uint64_t &vertexId,
+[[nodiscard]] SharedVertex createNewVertex(VertexPool &pool,
+                                           std::uint64_t &vertexId,
                                            const Vertex &oldVertex,
                                            const problem::Instance &problemInstance,
                                            const cg::VerticesIds &vOps,
@@ -128,8 +172,32 @@ void removeActiveVertex(dd::JobIdxToVertices &activeVertices, const Vertex &v);
                                            algorithms::paths::PathTimes ALAPST,
                                            bool graphIsRelaxed = false);
 
-std::vector<SharedVertex>
-expandVertex(auto &data, const Vertex &state, const problem::Instance &problemInstance);
+/// @brief Feasible scheduling option of a state whose vertex has not been created yet
+struct Expansion {
+    cg::VerticesIds vOps;
+    std::vector<problem::Operation> ops;
+    algorithms::paths::PathTimes ASAPST;
+    algorithms::paths::PathTimes ALAPST;
+
+    /// Vertices whose earliest start time changed from the parent, if it was computed
+    /// incrementally
+    std::optional<std::size_t> touchedVertices;
+};
+
+/**
+ * @brief Computes the times of the feasible children of @p state without creating them
+ * @details It only reads its arguments, so several states can be expanded at the same time as
+ * long as each one uses its own overlay.
+ * @param baseGraph Constraint graph of the solver
+ * @param dg Constraint graph with the edges of @p state applied on top of it
+ * @param state State to expand
+ * @param problemInstance The problem instance
+ * @return The feasible scheduling options of @p state in the order of its ready jobs
+ */
+[[nodiscard]] std::vector<Expansion> computeExpansions(const cg::ConstraintGraph &baseGraph,
+                                                       const cg::GraphOverlay &dg,
+                                                       const Vertex &state,
+                                                       const problem::Instance &problemInstance);
 
 /**
  * @brief Finds if the state can be merged with another state in the graph and returns the
@@ -141,7 +209,7 @@ expandVertex(auto &data, const Vertex &state, const problem::Instance &problemIn
  * @return true The vertex @p newVertex is not dominated.
  * @return false The vertex @p newVertex is dominated and it should not be added.
  */
-[[nodiscard]] bool findVertexDominance(JobIdxToVertices &activeVertices,
+[[nodiscard]] bool findVertexDominance(DominanceStore &activeVertices,
                                        const SharedVertex &newVertex,
                                        const problem::Instance &problemInstance);
 
@@ -161,24 +229,38 @@ expandVertex(auto &data, const Vertex &state, const problem::Instance &problemIn
 
 [[nodiscard]] bool isTerminal(const Vertex &vertex, const problem::Instance &instance);
 
-// NOTE: This is not being used for the current paper but may be used in future work
-template <typename T, class F = void *>
-void mergeLoop(T &states,
-               std::uint64_t &vertexId,
-               const problem::Instance &problemInstance,
-               const cg::ConstraintGraph &dg);
+/**
+ * @brief Adds a terminal state to the solutions
+ * @details Relaxed terminal states are not valid solutions, only their bound is kept.
+ */
+void addTerminal(DDSolverData &data, const Vertex &vertex);
+
+/**
+ * @brief Whether the restricted or relaxed diagram has expanded all the states of its current
+ * layer, so that the queue only holds the next layer
+ */
+[[nodiscard]] inline bool isLayerDone(const DDSolverData &data) {
+    return data.explorationType.isWidthBounded() && data.layerStatesLeft == 0;
+}
 
-SharedVertex mergeOperator(const Vertex &a,
+/**
+ * @brief Starts the next layer of a restricted or relaxed diagram
+ * @details When the layer is wider than @ref DDSolverData::maxWidth , the restricted diagram drops
+ * its worst ranked states and the relaxed diagram merges them into a single state. Must only be
+ * called when @ref isLayerDone is true.
+ */
+void startLayer(DDSolverData &data, const problem::Instance &problemInstance);
+
+SharedVertex mergeOperator(VertexPool &pool,
+                           const Vertex &a,
                            const Vertex &b,
                            std::uint64_t &vertexId,
                            const problem::Instance &problemInstance,
                            const cg::ConstraintGraph &dg);
 
-std::uint32_t chooseVertexToMerge(std::uint32_t size);
-
 void updateVertexALAPST(const algorithms::paths::PathTimes &ASAPST,
                         algorithms::paths::PathTimes &ALAPST,
-                        cg::ConstraintGraph &dg,
+                        const cg::GraphOverlay &dg,
                         const cg::VerticesIds &scheduledOps,
                         const cg::Edges &newestEdges,
                         const std::vector<problem::Operation> &newestOps);
@@ -211,18 +293,18 @@ bool shouldStop(const dd::DDSolverData &data, const cli::CLIArgs &args, std::siz
 
 void singleIteration(DDSolverData &dataPtr, const problem::Instance &problemInstance);
 
-template <class V> void orderQueue(StatesT &states, V comparator) {
-    std::make_heap(states.begin(), states.end(), comparator);
-}
-
-void push(auto &states,
-          cli::DDExplorationType explorationType,
-          SharedVertex &newVertex,
-          const DDSolution &solution,
-          bool reOrder);
+/**
+ * @brief Adds the children of @p state to the queue unless they are pruned or dominated
+ * @details The vertices are created in the order of @p expansions , so the ids of the new states
+ * do not depend on which thread computed their times.
+ */
+void addChildren(DDSolverData &data,
+                 const Vertex &state,
+                 std::vector<Expansion> expansions,
+                 const problem::Instance &problemInstance);
 
-void inline push(DDSolverData &data, SharedVertex &newVertex, bool reOrder) {
-    push(data.states, data.explorationType, newVertex, data.solution, reOrder);
+void inline push(DDSolverData &data, SharedVertex newVertex) {
+    data.states.push(std::move(newVertex));
 }
 
 SharedVertex pop(DDSolverData &data);
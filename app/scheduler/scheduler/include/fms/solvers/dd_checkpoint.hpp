@@ -0,0 +1,43 @@
+#ifndef FMS_SOLVERS_DD_CHECKPOINT_HPP
+#define FMS_SOLVERS_DD_CHECKPOINT_HPP
+
+#include "dd.hpp"
+
+#include "fms/cli/command_line.hpp"
+#include "fms/problem/flow_shop.hpp"
+
+#include <filesystem>
+
+namespace fms::solvers::dd {
+
+/**
+ * @brief Writes the state of a DD search to @p file so that it can be resumed by another process
+ * @details The checkpoint holds the states in the queue, the states of the dominance store, the
+ * solutions found so far, the bounds, the solve data and the next vertex id. The times of the
+ * states are stored once per @ref StateTimes , as the entries that differ from their parent times,
+ * so states sharing ancestors share their storage like they do in memory. The history of
+ * explored states (see @ref kStoreHistory and @ref HistoryWriter ) is not stored, the history
+ * of the resumed search starts with the states of the queue. The transposition table is not
+ * stored either, the resumed search starts with an empty one.
+ *
+ * The file is first written next to @p file and then renamed, so an interrupted write never
+ * replaces a valid checkpoint. Integers are stored in the byte order of the machine.
+ */
+void saveCheckpoint(const DDSolverData &data,
+                    const problem::Instance &problemInstance,
+                    const std::filesystem::path &file);
+
+/**
+ * @brief Restores a DD search saved by @ref saveCheckpoint
+ * @details The constraint graph is rebuilt from @p problemInstance , which must be the instance
+ * of the saved search, and the search must use the same exploration type. The time-out of @p args
+ * starts again from the moment of the call.
+ * @throw FmsSchedulerException if the file cannot be read or does not match the instance.
+ */
+[[nodiscard]] DDSolverDataPtr loadCheckpoint(const std::filesystem::path &file,
+                                             const cli::CLIArgs &args,
+                                             problem::Instance &problemInstance);
+
+} // namespace fms::solvers::dd
+
+#endif // FMS_SOLVERS_DD_CHECKPOINT_HPP
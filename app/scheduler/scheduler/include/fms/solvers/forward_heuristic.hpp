@@ -5,6 +5,7 @@
 
 #include "fms/algorithms/longest_path.hpp"
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
 #include "fms/cg/edge.hpp"
 #include "fms/delay.hpp"
 #include "fms/problem/flow_shop.hpp"
@@ -42,7 +43,18 @@ createOptions(const problem::Instance &problem,
               problem::MachineId reEntrantMachineId);
 
 std::vector<std::pair<PartialSolution, SchedulingOption>>
-evaluateOptionFeasibility(cg::ConstraintGraph &dg,
+evaluateOptionFeasibility(const cg::ConstraintGraph &dg,
+                          const problem::Instance &problem,
+                          const PartialSolution &solution,
+                          const std::vector<SchedulingOption> &options,
+                          const std::vector<delay> &ASAPTimes,
+                          problem::MachineId reEntrantMachine);
+
+/// @copydoc evaluateOptionFeasibility(const cg::ConstraintGraph&, const problem::Instance&, const PartialSolution&, const std::vector<SchedulingOption>&, const std::vector<delay>&, problem::MachineId)
+/// @param csr Snapshot of @p dg through which the options are evaluated
+std::vector<std::pair<PartialSolution, SchedulingOption>>
+evaluateOptionFeasibility(const cg::ConstraintGraph &dg,
+                          const cg::CSRGraph &csr,
                           const problem::Instance &problem,
                           const PartialSolution &solution,
                           const std::vector<SchedulingOption> &options,
@@ -50,7 +62,7 @@ evaluateOptionFeasibility(cg::ConstraintGraph &dg,
                           problem::MachineId reEntrantMachine);
 
 std::optional<std::pair<PartialSolution, SchedulingOption>>
-evaluateOptionFeasibility(cg::ConstraintGraph &dg,
+evaluateOptionFeasibility(const cg::ConstraintGraph &dg,
                           const problem::Instance &problem,
                           const PartialSolution &solution,
                           const SchedulingOption &options,
@@ -59,7 +71,9 @@ evaluateOptionFeasibility(cg::ConstraintGraph &dg,
 
 /* Algorithmic implementations */
 
+/// @param csr Snapshot of @p dg , taken again when scheduling the operation replaces @p dg
 PartialSolution scheduleOneOperation(cg::ConstraintGraph &dg,
+                                     cg::CSRGraph &csr,
                                      problem::Instance &,
                                      const PartialSolution &current_solution,
                                      const problem::Operation &eligibleOperation,
@@ -68,15 +82,30 @@ PartialSolution scheduleOneOperation(cg::ConstraintGraph &dg,
 delay determineSmallestDeadline(const cg::Vertex &v);
 
 /* add edges for the interleaving and validate whether the bound still hold; returns a negative
- * cycle if the resulting graph contains one (or a list of infeasible edges) */
-algorithms::paths::LongestPathResult validateInterleaving(cg::ConstraintGraph &dg,
-                                                          const problem::Instance &problem,
-                                                          const cg::Edges &inputEdges,
-                                                          std::vector<delay> &ASAPST,
-                                                          const cg::VerticesCRef &sources,
-                                                          const cg::VerticesCRef &window);
-
-std::pair<delay, unsigned int> computeFutureAvgProductivy(cg::ConstraintGraph &dg,
+ * cycle if the resulting graph contains one (or a list of infeasible edges, depending on
+ * report) */
+algorithms::paths::LongestPathResult validateInterleaving(
+        const cg::ConstraintGraph &dg,
+        const problem::Instance &problem,
+        const cg::Edges &inputEdges,
+        std::vector<delay> &ASAPST,
+        const cg::VerticesCRef &sources,
+        const cg::VerticesCRef &window,
+        algorithms::paths::CycleReport report = algorithms::paths::CycleReport::VIOLATED_EDGES);
+
+/// @copydoc validateInterleaving(const cg::ConstraintGraph&, const problem::Instance&, const cg::Edges&, std::vector<delay>&, const cg::VerticesCRef&, const cg::VerticesCRef&, algorithms::paths::CycleReport)
+/// @param csr Snapshot of @p dg through which the edges of the graph are traversed
+algorithms::paths::LongestPathResult validateInterleaving(
+        const cg::ConstraintGraph &dg,
+        const cg::CSRGraph &csr,
+        const problem::Instance &problem,
+        const cg::Edges &inputEdges,
+        std::vector<delay> &ASAPST,
+        const cg::VerticesCRef &sources,
+        const cg::VerticesCRef &window,
+        algorithms::paths::CycleReport report = algorithms::paths::CycleReport::VIOLATED_EDGES);
+
+std::pair<delay, unsigned int> computeFutureAvgProductivy(const cg::ConstraintGraph &dg,
                                                           const std::vector<delay> &ASAPST,
                                                           const PartialSolution &ps,
                                                           problem::MachineId reEntrantMachineId);
@@ -112,6 +141,7 @@ std::optional<std::size_t> rankSolutionsASAP(
  * @brief Find all feasible insertion points and their rank.
  *
  * @param dg Current delay graph
+ * @param csr Snapshot of @p dg
  * @param problem Problem instance
  * @param eligibleOperation Operation to insert
  * @param solution Current solution
@@ -122,6 +152,7 @@ std::optional<std::size_t> rankSolutionsASAP(
 std::tuple<std::vector<std::tuple<PartialSolution, std::shared_ptr<cg::ConstraintGraph>>>,
            std::optional<std::size_t>>
 getFeasibleOptions(cg::ConstraintGraph &dg,
+                   const cg::CSRGraph &csr,
                    problem::Instance &problem,
                    const cg::Vertex &eligibleOperation,
                    const PartialSolution &solution,
@@ -154,7 +154,7 @@ algorithms::paths::LongestPathResult
 recomputeSchedule(const problem::Instance &problemInstance,
                   PartialSolution &schedule,
                   const problem::MaintenancePolicy &maintPolicy,
-                  cg::ConstraintGraph &dg,
+                  const cg::ConstraintGraph &dg,
                   const Sequence &inputSequence,
                   algorithms::paths::PathTimes &ASAPST,
                   const cg::VerticesCRef &sources,
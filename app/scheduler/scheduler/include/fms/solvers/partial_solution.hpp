@@ -7,6 +7,7 @@
 
 #include "scheduling_option.hpp"
 
+#include <atomic>
 #include <fmt/compile.h>
 #include <utility>
 
@@ -52,8 +53,9 @@ public:
         m_firstMaintEdge(std::move(firstMaintEdge)),
         ASAPST(std::move(ASAPST)) {
 
-        static int id = 0;
-        this->id = id++;
+        // Solutions are also created by the threads of the parallel solvers
+        static std::atomic<int> nextId{0};
+        this->id = nextId.fetch_add(1, std::memory_order_relaxed);
     }
 
     [[nodiscard]] inline const problem::OperationsVector &
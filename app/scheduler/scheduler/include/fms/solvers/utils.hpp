@@ -28,8 +28,14 @@ checkSolutionAndOutputIfFails(const std::string &fileName,
                               const cg::Edges &extraEdges = {},
                               const std::string &extraMessage = "");
 
+/**
+ * @brief Checks that the input graph of @p instance is feasible
+ * @param instance Problem whose delay graph is checked
+ * @param nrThreads Number of threads used to compute the longest paths, see
+ * @ref algorithms::paths::computeASAPSTParallel
+ */
 algorithms::paths::LongestPathResultWithTimes
-checkSolutionAndOutputIfFails(const problem::Instance &instance);
+checkSolutionAndOutputIfFails(const problem::Instance &instance, std::size_t nrThreads = 1);
 
 algorithms::paths::LongestPathResultWithTimes
 checkSolutionAndOutputIfFails(const problem::Instance &instance, PartialSolution &ps);
@@ -57,6 +63,17 @@ cg::Edges getEdgesFromSequence(const problem::Instance &problem,
                                const Sequence &sequence,
                                problem::MachineId machineId);
 
+/**
+ * @brief Edges of @p sequence that enter the operations in the positions [ @p first , @p last )
+ * @details Same edges as the ones at these positions in the result of the overload above, without
+ * querying the edges of the other operations.
+ */
+cg::Edges getEdgesFromSequence(const problem::Instance &problem,
+                               const Sequence &sequence,
+                               problem::MachineId machineId,
+                               std::size_t first,
+                               std::size_t last);
+
 cg::Edges getAllEdgessFromSequences(const problem::Instance &problem,
                                     const MachinesSequences &sequences);
 cg::Edges getInferredEdges(const problem::Instance &problem, const MachinesSequences &sequences);
@@ -78,10 +95,12 @@ cg::Edges getAllEdgesPlusInferredEdges(const problem::Instance &problem,
  * @param problemInstance Problem to generate the graph for.
  * @param saveGraph If true, the graph will be saved as a DOT file named
  * `input_graph_<problemName>.dot`. Used for debugging.
+ * @param nrThreads Number of threads used to check the graph.
  * @return PathTimes Earliest start times for the operations in the graph.
  */
 algorithms::paths::PathTimes initProblemGraph(problem::Instance &problemInstance,
-                                              bool saveGraph = false);
+                                              bool saveGraph = false,
+                                              std::size_t nrThreads = 1);
 } // namespace fms::solvers::SolversUtils
 
 #endif
@@ -0,0 +1,100 @@
+#ifndef FMS_UTILS_TASK_WORKERS_HPP
+#define FMS_UTILS_TASK_WORKERS_HPP
+
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fms::utils {
+
+/**
+ * @brief Threads that run the tasks of a batch together with the calling thread
+ * @details The threads are kept until the object is destroyed and wait on a barrier between
+ * batches, so starting a batch does not create any thread. The tasks of a batch are handed out one
+ * index at a time. The first exception thrown by a task is rethrown by @ref run once the whole
+ * batch has finished.
+ */
+class TaskWorkers {
+public:
+    /// @param nrThreads Number of threads running the tasks, including the calling thread
+    explicit TaskWorkers(std::size_t nrThreads) : m_sync(static_cast<std::ptrdiff_t>(nrThreads)) {
+        m_threads.reserve(nrThreads - 1);
+        for (std::size_t i = 1; i < nrThreads; ++i) {
+            m_threads.emplace_back([this]() { work(); });
+        }
+    }
+
+    TaskWorkers(const TaskWorkers &) = delete;
+    TaskWorkers(TaskWorkers &&) = delete;
+    TaskWorkers &operator=(const TaskWorkers &) = delete;
+    TaskWorkers &operator=(TaskWorkers &&) = delete;
+
+    ~TaskWorkers() {
+        m_stop = true;
+        m_sync.arrive_and_wait();
+        // The threads are joined before the barrier is destroyed
+        m_threads.clear();
+    }
+
+    /// @brief Calls @p task once for every index below @p nrTasks and waits for all of them
+    void run(std::size_t nrTasks, std::function<void(std::size_t)> task) {
+        m_task = std::move(task);
+        m_nrTasks = nrTasks;
+        m_next.store(0, std::memory_order_relaxed);
+
+        m_sync.arrive_and_wait();
+        runTasks();
+        m_sync.arrive_and_wait();
+
+        if (m_error) {
+            std::rethrow_exception(std::exchange(m_error, nullptr));
+        }
+    }
+
+private:
+    void work() {
+        while (true) {
+            m_sync.arrive_and_wait();
+            if (m_stop) {
+                return;
+            }
+            runTasks();
+            m_sync.arrive_and_wait();
+        }
+    }
+
+    void runTasks() {
+        for (auto i = m_next.fetch_add(1, std::memory_order_relaxed); i < m_nrTasks;
+             i = m_next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                m_task(i);
+            } catch (...) {
+                const std::scoped_lock lock(m_errorMutex);
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    std::barrier<> m_sync;
+    std::function<void(std::size_t)> m_task;
+    std::size_t m_nrTasks = 0;
+    std::atomic<std::size_t> m_next{0};
+    bool m_stop = false;
+
+    std::mutex m_errorMutex;
+    std::exception_ptr m_error;
+
+    std::vector<std::jthread> m_threads;
+};
+
+} // namespace fms::utils
+
+#endif // FMS_UTILS_TASK_WORKERS_HPP
@@ -4,71 +4,1021 @@
 #include "fms/algorithms/longest_path.hpp"
 
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
 #include "fms/cg/edge.hpp"
+#include "fms/cg/graph_overlay.hpp"
 #include "fms/delay.hpp"
 #include "fms/problem/operation.hpp"
 
+#include <atomic>
+#include <barrier>
+#include <deque>
 #include <fstream>
 #include <limits>
 #include <numeric>
+#include <thread>
 
 namespace {
+using namespace fms;
+using namespace fms::cg;
+using algorithms::paths::IncrementalASAPScratch;
+using algorithms::paths::kALAPStartValue;
+using algorithms::paths::kASAPStartValue;
+using algorithms::paths::PathTimes;
+
+/**
+ * @brief Edge traversal of a @ref ConstraintGraph through its adjacency maps
+ * @details The kernels below are written against this small interface so that they can run on
+ * the graph itself or on a @ref CSRGraph snapshot with exactly the same visiting order.
+ */
+class GraphEdges {
+public:
+    explicit GraphEdges(const ConstraintGraph &dg) : m_vertices(dg.getVertices()) {}
+
+    [[nodiscard]] inline std::size_t getNumberOfVertices() const noexcept {
+        return m_vertices.size();
+    }
+
+    [[nodiscard]] inline problem::JobId getJobId(VertexId v) const noexcept {
+        return m_vertices[v].operation.jobId;
+    }
+
+    /// @brief Calls @p f for each outgoing edge of @p v until it returns true
+    template <typename F> inline bool anyOutgoing(VertexId v, F &&f) const {
+        for (const auto &[dst, weight] : m_vertices[v].getOutgoingEdges()) {
+            if (f(dst, weight)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Calls @p f for each incoming edge of @p v until it returns true
+    template <typename F> inline bool anyIncoming(VertexId v, F &&f) const {
+        for (const auto &[src, weight] : m_vertices[v].getIncomingEdges()) {
+            if (f(src, weight)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const Vertices &m_vertices;
+};
+
+/// @brief Edge traversal of a @ref CSRGraph followed by its side list of extra edges
+class CSREdges {
+public:
+    CSREdges(const CSRGraph &g, const ExtraEdges &extra) : m_g(g), m_extra(extra) {}
+
+    [[nodiscard]] inline std::size_t getNumberOfVertices() const noexcept {
+        return m_g.getNumberOfVertices();
+    }
+
+    [[nodiscard]] inline problem::JobId getJobId(VertexId v) const noexcept {
+        return m_g.getJobId(v);
+    }
+
+    template <typename F> inline bool anyOutgoing(VertexId v, F &&f) const {
+        const auto dsts = m_g.getOutgoingDst(v);
+        const auto weights = m_g.getOutgoingWeights(v);
+        for (std::size_t i = 0; i < dsts.size(); ++i) {
+            if (f(dsts[i], weights[i])) {
+                return true;
+            }
+        }
+        for (const auto &e : m_extra.getOutgoingEdges(v)) {
+            if (f(e.dst, e.weight)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename F> inline bool anyIncoming(VertexId v, F &&f) const {
+        const auto srcs = m_g.getIncomingSrc(v);
+        const auto weights = m_g.getIncomingWeights(v);
+        for (std::size_t i = 0; i < srcs.size(); ++i) {
+            if (f(srcs[i], weights[i])) {
+                return true;
+            }
+        }
+        for (const auto &e : m_extra.getIncomingEdges(v)) {
+            if (f(e.src, e.weight)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const CSRGraph &m_g;
+    const ExtraEdges &m_extra;
+};
+
+/// @brief Traversal of a @ref GraphOverlay followed by an optional side list of extra edges
+/// @details The extra edges are a second, read-only layer: evaluating a few more edges on top
+/// of an overlay does not need to copy it.
+class OverlayEdges {
+public:
+    explicit OverlayEdges(const GraphOverlay &g, const ExtraEdges &extra = kNoExtraEdges) :
+        m_g(g), m_vertices(g.getBase().getVertices()), m_extra(extra) {}
+
+    [[nodiscard]] inline std::size_t getNumberOfVertices() const noexcept {
+        return m_vertices.size();
+    }
+
+    [[nodiscard]] inline problem::JobId getJobId(VertexId v) const noexcept {
+        return m_vertices[v].operation.jobId;
+    }
+
+    template <typename F> inline bool anyOutgoing(VertexId v, F &&f) const {
+        if (m_g.anyOutgoing(v, f)) {
+            return true;
+        }
+        for (const auto &e : m_extra.getOutgoingEdges(v)) {
+            if (f(e.dst, e.weight)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename F> inline bool anyIncoming(VertexId v, F &&f) const {
+        if (m_g.anyIncoming(v, f)) {
+            return true;
+        }
+        for (const auto &e : m_extra.getIncomingEdges(v)) {
+            if (f(e.src, e.weight)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static const ExtraEdges kNoExtraEdges;
+
+    const GraphOverlay &m_g;
+    const Vertices &m_vertices;
+    const ExtraEdges &m_extra;
+};
+
+const ExtraEdges OverlayEdges::kNoExtraEdges{};
+
+/// @brief Outgoing edges of a @ref GraphOverlay followed by the edges added to an incremental
+/// update so far, which is all the propagation of the update needs
+class IncrementalEdges {
+public:
+    IncrementalEdges(const GraphOverlay &g, const IncrementalASAPScratch &added) :
+        m_g(g), m_added(added) {}
+
+    template <typename F> inline bool anyOutgoing(VertexId v, F &&f) const {
+        return m_g.anyOutgoing(v, f) || m_added.anyAddedOutgoing(v, f);
+    }
+
+private:
+    const GraphOverlay &m_g;
+    const IncrementalASAPScratch &m_added;
+};
+
+inline VertexId vertexIdOf(VertexId v) noexcept { return v; }
+
+inline VertexId vertexIdOf(const Vertex &v) noexcept { return v.id; }
+
+template <typename G> inline auto allVertexIds(const G &g) {
+    return std::views::iota(VertexId{0}, g.getNumberOfVertices());
+}
+
+/// @brief Callback of the sweeps for the relaxed edges when the predecessors are not recorded
+constexpr auto kIgnoreRelaxed = [](VertexId /*src*/, VertexId /*dst*/, delay /*weight*/) {};
+
+/**
+ * @brief One Bellman-Ford sweep over all the vertices. Returns true if any vertex was relaxed.
+ * @param onRelax Called with each edge that increases the time of its destination
+ */
+template <typename G, typename F = decltype(kIgnoreRelaxed)>
+bool relaxAllASAPST(const G &g, PathTimes &ASAPST, const F &onRelax = kIgnoreRelaxed) {
+    bool atLeastOneEdgeRelaxed = false;
+    for (VertexId v = 0; v < g.getNumberOfVertices(); ++v) {
+        if (ASAPST[v] == kASAPStartValue) {
+            continue;
+        }
+        g.anyOutgoing(v, [&](VertexId dst, delay weight) {
+            const auto value = ASAPST[v] + weight;
+            if (value > ASAPST[dst]) {
+                ASAPST[dst] = value;
+                onRelax(v, dst, weight);
+                atLeastOneEdgeRelaxed = true;
+            }
+            return false;
+        });
+    }
+    return atLeastOneEdgeRelaxed;
+}
+
+/// @brief One Bellman-Ford sweep over @p vertices that fails when a vertex of a job before
+/// @p firstJobId would be relaxed. @p onRelax is called with each relaxed edge.
+template <typename G, typename R, typename F = decltype(kIgnoreRelaxed)>
+std::tuple<bool, std::optional<Edge>> relaxWindowASAPST(const G &g,
+                                                        const R &vertices,
+                                                        problem::JobId firstJobId,
+                                                        PathTimes &ASAPST,
+                                                        const F &onRelax = kIgnoreRelaxed) {
+    bool atLeastOneEdgeRelaxed = false;
+    for (const auto &vertex : vertices) {
+        const VertexId v = vertexIdOf(vertex);
+        if (ASAPST[v] == kASAPStartValue) {
+            continue;
+        }
+
+        std::optional<Edge> infeasible;
+        g.anyOutgoing(v, [&](VertexId dst, delay weight) {
+            const auto value = ASAPST[v] + weight;
+            if (value > ASAPST[dst]) {
+                if (g.getJobId(dst) < firstJobId) {
+                    // Check if we relaxed a source node (all jobs already scheduled) if we did
+                    // then this means that there's a cycle as we shouldn't be able to relax
+                    // sources.
+                    infeasible.emplace(v, dst, weight);
+                    return true;
+                }
+                ASAPST[dst] = value;
+                onRelax(v, dst, weight);
+                atLeastOneEdgeRelaxed = true;
+            }
+            return false;
+        });
+
+        if (infeasible) {
+            return {atLeastOneEdgeRelaxed, infeasible};
+        }
+    }
+    return {atLeastOneEdgeRelaxed, std::nullopt};
+}
+
+/// @brief Collects, for each vertex in @p vertices, the first outgoing edge that can still be
+/// relaxed. After |V|-1 sweeps any such edge belongs to (or is reachable from) a positive cycle.
+template <typename G, typename R>
+Edges violatedEdgesASAPST(const G &g, const R &vertices, const PathTimes &ASAPST) {
+    Edges infeasible;
+    for (const auto &vertex : vertices) {
+        const VertexId v = vertexIdOf(vertex);
+        // if the vertex was updated at all, check this, otherwise it means the vertex is
+        // disconnected from the sources
+        if (ASAPST[v] == kASAPStartValue) {
+            continue;
+        }
+        g.anyOutgoing(v, [&](VertexId dst, delay weight) {
+            if (ASAPST[v] + weight > ASAPST[dst]) {
+                infeasible.emplace_back(v, dst, weight);
+                return true;
+            }
+            return false;
+        });
+    }
+    return infeasible;
+}
+
+/**
+ * @brief Last edge that relaxed each vertex during the sweeps
+ * @details The predecessor graph of the relaxations only contains a cycle if the cycle is
+ * positive, and once a positive cycle is reachable it appears within @f$|V|@f$ sweeps. Looking
+ * for it after each sweep is linear in the number of vertices, so the sweeps can stop as soon as
+ * the cycle exists instead of running to the end.
+ */
+class Predecessors {
+public:
+    explicit Predecessors(std::size_t nrVertices) :
+        m_src(nrVertices, kNone), m_weight(nrVertices), m_visitedFrom(nrVertices) {}
+
+    inline void set(VertexId src, VertexId dst, delay weight) noexcept {
+        m_src[dst] = src;
+        m_weight[dst] = weight;
+    }
+
+    /// @brief Returns the edges of a cycle of the predecessor graph, from the last edge of the
+    /// cycle back to the first one, or nothing if there is no cycle
+    [[nodiscard]] Edges findCycle() {
+        std::fill(m_visitedFrom.begin(), m_visitedFrom.end(), kNone);
+        for (VertexId start = 0; start < m_src.size(); ++start) {
+            VertexId v = start;
+            while (v != kNone && m_visitedFrom[v] == kNone) {
+                m_visitedFrom[v] = start;
+                v = m_src[v];
+            }
+            if (v != kNone && m_visitedFrom[v] == start) {
+                return getCycle(v);
+            }
+        }
+        return {};
+    }
+
+private:
+    static constexpr VertexId kNone = std::numeric_limits<VertexId>::max();
+
+    [[nodiscard]] Edges getCycle(VertexId last) const {
+        Edges cycle;
+        VertexId v = last;
+        do {
+            cycle.emplace_back(m_src[v], v, m_weight[v]);
+            v = m_src[v];
+        } while (v != last);
+        return cycle;
+    }
+
+    VerticesIds m_src;
+    std::vector<delay> m_weight;
+    VerticesIds m_visitedFrom;
+};
+
+/**
+ * @brief Variant of @ref computeASAPSTImpl that reports an actual positive cycle
+ * @details The predecessors are recorded during the sweeps and searched for a cycle after each
+ * sweep that changed a time, see @ref Predecessors .
+ */
+template <typename G>
+algorithms::paths::LongestPathResult computeASAPSTCycleImpl(const G &g, PathTimes &ASAPST) {
+    Predecessors predecessors(g.getNumberOfVertices());
+    const auto record = [&predecessors](VertexId src, VertexId dst, delay weight) {
+        predecessors.set(src, dst, weight);
+    };
+
+    for (std::size_t i = 0; i < g.getNumberOfVertices(); i++) {
+        if (!relaxAllASAPST(g, ASAPST, record)) {
+            return {};
+        }
+        if (auto cycle = predecessors.findCycle(); !cycle.empty()) {
+            return {std::move(cycle)};
+        }
+    }
+    return {violatedEdgesASAPST(g, allVertexIds(g), ASAPST)};
+}
+
+template <typename G>
+algorithms::paths::LongestPathResult computeASAPSTImpl(const G &g, PathTimes &ASAPST) {
+    for (std::size_t i = 1; i < g.getNumberOfVertices(); i++) {
+        // If no relaxation needed to be performed, we should stop.
+        if (!relaxAllASAPST(g, ASAPST)) {
+            return {};
+        }
+    }
+
+    // Check for positive cycles. The nth iteration must not change the values computed in the
+    // previous iteration, if that happens, the algorithm will never converge.
+    return {violatedEdgesASAPST(g, allVertexIds(g), ASAPST)};
+}
+
+/**
+ * @brief Label-correcting (SPFA) variant of @ref computeASAPSTImpl
+ * @details Only the vertices whose time changed are revisited, so on graphs that are almost
+ * acyclic the cost is close to linear instead of @f$O(VE)@f$. A vertex whose longest path has
+ * @f$|V|@f$ edges proves that there is a positive cycle. In that case the times are restored and
+ * the sweeps are run, so that the reported cycle and the times are the same as with
+ * @ref computeASAPSTImpl .
+ */
+template <typename G>
+algorithms::paths::LongestPathResult computeASAPSTWorklistImpl(const G &g, PathTimes &ASAPST) {
+    const auto nrVertices = g.getNumberOfVertices();
+    const PathTimes initial(ASAPST.begin(), ASAPST.begin() + nrVertices);
+
+    std::deque<VertexId> worklist;
+    std::vector<std::uint8_t> queued(nrVertices, 0U);
+    std::vector<std::size_t> pathLength(nrVertices, 0);
+    for (VertexId v = 0; v < nrVertices; ++v) {
+        if (ASAPST[v] != kASAPStartValue) {
+            worklist.push_back(v);
+            queued[v] = 1U;
+        }
+    }
+
+    bool positiveCycle = false;
+    while (!worklist.empty() && !positiveCycle) {
+        const VertexId v = worklist.front();
+        worklist.pop_front();
+        queued[v] = 0U;
+
+        positiveCycle = g.anyOutgoing(v, [&](VertexId dst, delay weight) {
+            const auto value = ASAPST[v] + weight;
+            if (value <= ASAPST[dst]) {
+                return false;
+            }
+            ASAPST[dst] = value;
+            pathLength[dst] = pathLength[v] + 1;
+            if (pathLength[dst] >= nrVertices) {
+                return true;
+            }
+            if (queued[dst] == 0U) {
+                worklist.push_back(dst);
+                queued[dst] = 1U;
+            }
+            return false;
+        });
+    }
+
+    if (!positiveCycle) {
+        return {};
+    }
+
+    std::copy(initial.begin(), initial.end(), ASAPST.begin());
+    return computeASAPSTImpl(g, ASAPST);
+}
+
+/**
+ * @brief Bellman-Ford sweeps in the given vertex order, bounded by @p maxRounds
+ * @details When the order is topological for the forward edges, a graph without positive cycles
+ * converges in one sweep per backward edge of its longest paths (plus the final sweep that
+ * changes nothing). If it does not converge within @p maxRounds the times are restored and the
+ * cycle is reported by @ref computeASAPSTImpl .
+ */
+template <typename G>
+algorithms::paths::LongestPathResult computeASAPSTOrderedImpl(const G &g,
+                                                              PathTimes &ASAPST,
+                                                              const VerticesIds &order,
+                                                              std::size_t maxRounds) {
+    const PathTimes initial(ASAPST.begin(), ASAPST.begin() + g.getNumberOfVertices());
+
+    for (std::size_t round = 0; round < maxRounds; ++round) {
+        bool atLeastOneEdgeRelaxed = false;
+        for (const VertexId v : order) {
+            if (ASAPST[v] == kASAPStartValue) {
+                continue;
+            }
+            g.anyOutgoing(v, [&](VertexId dst, delay weight) {
+                const auto value = ASAPST[v] + weight;
+                if (value > ASAPST[dst]) {
+                    ASAPST[dst] = value;
+                    atLeastOneEdgeRelaxed = true;
+                }
+                return false;
+            });
+        }
+
+        if (!atLeastOneEdgeRelaxed) {
+            return {};
+        }
+    }
+
+    std::copy(initial.begin(), initial.end(), ASAPST.begin());
+    return computeASAPSTImpl(g, ASAPST);
+}
+
+/// @brief Minimum number of vertices given to each thread of @ref computeASAPSTParallelImpl
+constexpr std::size_t kMinVerticesPerThread = 512;
+
+/**
+ * @brief Splits the vertices in @p nrParts ranges with about the same number of outgoing edges
+ * @details The ranges only end where the job of the vertices changes, so the operations of a job
+ * (and their deadlines) are relaxed by the same thread.
+ * @return The first vertex of each range followed by the number of vertices
+ */
+template <typename G> std::vector<VertexId> partitionByJobs(const G &g, std::size_t nrParts) {
+    const auto nrVertices = g.getNumberOfVertices();
+    std::vector<std::size_t> firstEdge(nrVertices + 1, 0);
+    for (VertexId v = 0; v < nrVertices; ++v) {
+        std::size_t degree = 1;
+        g.anyOutgoing(v, [&degree](VertexId, delay) {
+            ++degree;
+            return false;
+        });
+        firstEdge[v + 1] = firstEdge[v] + degree;
+    }
+
+    std::vector<VertexId> bounds{0};
+    for (std::size_t part = 1; part < nrParts; ++part) {
+        const auto target = firstEdge.back() * part / nrParts;
+        auto v = static_cast<VertexId>(
+                std::lower_bound(firstEdge.begin(), firstEdge.end(), target) - firstEdge.begin());
+        v = std::max(v, bounds.back() + 1);
+        while (v < nrVertices && g.getJobId(v) == g.getJobId(v - 1)) {
+            ++v;
+        }
+        if (v >= nrVertices) {
+            break;
+        }
+        bounds.push_back(v);
+    }
+    bounds.push_back(nrVertices);
+    return bounds;
+}
+
+/**
+ * @brief Multi-threaded variant of @ref computeASAPSTImpl
+ * @details Each thread sweeps its own range of vertices (see @ref partitionByJobs) and raises the
+ * times of the destinations with an atomic maximum, so the threads see the updates of the others
+ * within the same round. A round is at least as good as a Jacobi iteration, so without positive
+ * cycles the times stop changing within @f$|V|@f$ rounds, and the fixed point is the same as the
+ * one of the sequential sweeps. Otherwise the times are restored and the cycle is reported by
+ * @ref computeASAPSTImpl , so the result is identical in every case.
+ */
+template <typename G>
+algorithms::paths::LongestPathResult
+computeASAPSTParallelImpl(const G &g, PathTimes &ASAPST, std::size_t nrThreads) {
+    static_assert(std::atomic_ref<delay>::required_alignment == alignof(delay));
+    const auto nrVertices = g.getNumberOfVertices();
+    nrThreads = std::min(nrThreads, nrVertices / kMinVerticesPerThread);
+    if (nrThreads <= 1) {
+        return computeASAPSTImpl(g, ASAPST);
+    }
+
+    const auto bounds = partitionByJobs(g, nrThreads);
+    const auto nrParts = bounds.size() - 1;
+    const PathTimes initial(ASAPST.begin(), ASAPST.begin() + nrVertices);
+
+    std::atomic<bool> changed{false};
+    bool converged = false;
+    bool stop = false;
+    std::size_t round = 0;
+    std::barrier sync(static_cast<std::ptrdiff_t>(nrParts), [&]() noexcept {
+        converged = !changed.exchange(false, std::memory_order_relaxed);
+        stop = converged || ++round >= nrVertices;
+    });
+
+    const auto sweep = [&](std::size_t part) {
+        while (!stop) {
+            bool relaxed = false;
+            for (VertexId v = bounds[part]; v < bounds[part + 1]; ++v) {
+                const auto time = std::atomic_ref(ASAPST[v]).load(std::memory_order_relaxed);
+                if (time == kASAPStartValue) {
+                    continue;
+                }
+                g.anyOutgoing(v, [&](VertexId dst, delay weight) {
+                    const auto value = time + weight;
+                    std::atomic_ref target(ASAPST[dst]);
+                    auto current = target.load(std::memory_order_relaxed);
+                    while (value > current) {
+                        if (target.compare_exchange_weak(
+                                    current, value, std::memory_order_relaxed)) {
+                            relaxed = true;
+                            break;
+                        }
+                    }
+                    return false;
+                });
+            }
+            if (relaxed) {
+                changed.store(true, std::memory_order_relaxed);
+            }
+            sync.arrive_and_wait();
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(nrParts - 1);
+        for (std::size_t part = 1; part < nrParts; ++part) {
+            threads.emplace_back(sweep, part);
+        }
+        sweep(0);
+    }
+
+    if (converged) {
+        return {};
+    }
+    std::copy(initial.begin(), initial.end(), ASAPST.begin());
+    return computeASAPSTImpl(g, ASAPST);
+}
+
+/**
+ * @brief Relaxes the edge from the lanes @p src to the lanes @p dst
+ * @details Branch-free so that the loop over the lanes is vectorised. The sum is done unsigned
+ * because it is also evaluated for the lanes that have not been reached yet.
+ */
+inline bool relaxLanesASAPST(const delay *src, delay *dst, delay weight, std::size_t nrLanes) {
+    bool relaxed = false;
+    for (std::size_t k = 0; k < nrLanes; ++k) {
+        const auto value = static_cast<delay>(static_cast<std::uint64_t>(src[k])
+                                              + static_cast<std::uint64_t>(weight));
+        const bool better = src[k] != kASAPStartValue && value > dst[k];
+        dst[k] = better ? value : dst[k];
+        relaxed |= better;
+    }
+    return relaxed;
+}
+
+/// @brief Bellman-Ford sweeps of @ref computeASAPSTImpl run for all the lanes at once
+template <typename G>
+void computeASAPSTFromNodesImpl(const G &g,
+                                std::span<const VertexId> sources,
+                                algorithms::paths::MultiSourcePathTimes &result) {
+    const auto nrVertices = g.getNumberOfVertices();
+    const auto nrLanes = sources.size();
+    result.nrSources = nrLanes;
+    result.times.assign(nrVertices * nrLanes, kASAPStartValue);
+    for (std::size_t k = 0; k < nrLanes; ++k) {
+        result.times[sources[k] * nrLanes + k] = 0;
+    }
+
+    auto *times = result.times.data();
+    for (std::size_t i = 1; i < nrVertices; i++) {
+        bool atLeastOneEdgeRelaxed = false;
+        for (VertexId v = 0; v < nrVertices; ++v) {
+            const auto *src = times + v * nrLanes;
+            if (std::all_of(src, src + nrLanes, [](delay t) { return t == kASAPStartValue; })) {
+                continue;
+            }
+            g.anyOutgoing(v, [&](VertexId dst, delay weight) {
+                atLeastOneEdgeRelaxed |=
+                        relaxLanesASAPST(src, times + dst * nrLanes, weight, nrLanes);
+                return false;
+            });
+        }
+
+        // A lane that converged is not modified by the following sweeps, so stopping when all
+        // converged gives the same times as stopping each one on its own.
+        if (!atLeastOneEdgeRelaxed) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Windowed variant of @ref computeASAPSTCycleImpl
+ * @details An edge towards a job before @p firstJobId is still reported on its own as soon as it
+ * would be relaxed.
+ */
+template <typename G, typename R>
+algorithms::paths::LongestPathResult computeWindowASAPSTCycleImpl(const G &g,
+                                                                  PathTimes &ASAPST,
+                                                                  const R &allVertices,
+                                                                  problem::JobId firstJobId) {
+    Predecessors predecessors(g.getNumberOfVertices());
+    const auto record = [&predecessors](VertexId src, VertexId dst, delay weight) {
+        predecessors.set(src, dst, weight);
+    };
+
+    for (std::size_t i = 0; i < allVertices.size(); i++) {
+        const auto [atLeastOneEdgeRelaxed, infeasibleEdge] =
+                relaxWindowASAPST(g, allVertices, firstJobId, ASAPST, record);
+        if (infeasibleEdge) {
+            return {{infeasibleEdge.value()}};
+        }
+        if (!atLeastOneEdgeRelaxed) {
+            return {};
+        }
+        if (auto cycle = predecessors.findCycle(); !cycle.empty()) {
+            return {std::move(cycle)};
+        }
+    }
+    return {violatedEdgesASAPST(g, allVertices, ASAPST)};
+}
+
+template <typename G, typename R>
+algorithms::paths::LongestPathResult computeWindowASAPSTImpl(const G &g,
+                                                             PathTimes &ASAPST,
+                                                             const R &allVertices,
+                                                             problem::JobId firstJobId) {
+    Edges infeasible;
+
+    // For each vertex, iterate once (should be N-1)
+    const auto nrVertices = allVertices.size();
+    for (std::size_t i = 1; i < nrVertices; i++) {
+        const auto [atLeastOneEdgeRelaxed, infeasibleEdge] =
+                relaxWindowASAPST(g, allVertices, firstJobId, ASAPST);
+
+        if (infeasibleEdge) {
+            infeasible.push_back(infeasibleEdge.value());
+            break;
+        }
+
+        // If no relaxation needed to be performed, we should stop.
+        if (!atLeastOneEdgeRelaxed) {
+            break;
+        }
+    }
+
+    auto violated = violatedEdgesASAPST(g, allVertices, ASAPST);
+    infeasible.insert(infeasible.end(), violated.begin(), violated.end());
+    return {std::move(infeasible)};
+}
+
+/// @brief Flags of the vertices whose ALAP times cannot be changed by the relaxation
+std::vector<std::uint8_t> sourcesMask(std::size_t nrVertices, const VerticesIds &sources) {
+    std::vector<std::uint8_t> isSource(nrVertices, 0U);
+    for (const auto source : sources) {
+        isSource[source] = 1U;
+    }
+    return isSource;
+}
+
+template <typename G>
+std::tuple<bool, std::optional<Edge>>
+relaxAllALAPST(const G &g, PathTimes &ALAPST, const std::vector<std::uint8_t> &isSource) {
+    bool atLeastOneEdgeRelaxed = false;
+    for (VertexId v = 0; v < g.getNumberOfVertices(); ++v) {
+        if (ALAPST[v] == kALAPStartValue) {
+            continue;
+        }
+        g.anyIncoming(v, [&](VertexId src, delay weight) {
+            const auto value = ALAPST[v] - weight;
+            // Sources cannot be moved, the final check of computeALAPSTImpl reports them
+            if (value < ALAPST[src] && isSource[src] == 0U) {
+                ALAPST[src] = value;
+                atLeastOneEdgeRelaxed = true;
+            }
+            return false;
+        });
+    }
+    return {atLeastOneEdgeRelaxed, std::nullopt};
+}
+
+template <typename G>
+algorithms::paths::LongestPathResult
+computeALAPSTImpl(const G &g, PathTimes &ALAPST, const VerticesIds &sources) {
+    Edges infeasible;
+    const auto isSource = sourcesMask(g.getNumberOfVertices(), sources);
+
+    for (std::size_t i = 1; i < g.getNumberOfVertices(); i++) {
+        const auto [oneEdgeRelaxed, infeasibleEdge] = relaxAllALAPST(g, ALAPST, isSource);
+
+        if (infeasibleEdge) {
+            infeasible.push_back(infeasibleEdge.value());
+            break;
+        }
+
+        // If no relaxation needed to be performed, we should stop.
+        if (!oneEdgeRelaxed) {
+            break;
+        }
+    }
+
+    // Check for positive cycles. The nth iteration must not change the values computed in the
+    // previous iteration, if that happens, the algorithm will never converge.
+    for (VertexId v = 0; v < g.getNumberOfVertices(); ++v) {
+        if (ALAPST[v] == kALAPStartValue) {
+            continue;
+        }
+        g.anyIncoming(v, [&](VertexId src, delay weight) {
+            if (ALAPST[v] - weight < ALAPST[src]) {
+                infeasible.emplace_back(src, v, weight);
+                return true;
+            }
+            return false;
+        });
+    }
+
+    return {std::move(infeasible)};
+}
+
+/**
+ * @brief Propagates the edge @p e from the times @p ASAPST , which are consistent with @p g
+ * @details The vertices whose time increases are revisited, largest increase first, and
+ * @p onIncrease is called with each of them. @p e must not be in @p g yet.
+ * @return true if @p e closes a positive cycle
+ */
+template <typename G, typename F>
+bool addOneEdgeIncrementalASAPSTImpl(const G &g, const Edge &e, PathTimes &ASAPST, F &&onIncrease) {
+    using VertexPr = std::tuple<delay, VertexId>;
+    constexpr auto Comparator = [](const auto &lhs, const auto &rhs) {
+        return std::get<0>(lhs) < std::get<0>(rhs);
+    };
+    std::priority_queue<VertexPr, std::deque<VertexPr>, decltype(Comparator)> toRelax(Comparator);
+
+    if (const auto amount = algorithms::paths::relaxOneEdgeASAPST(e, ASAPST); amount > 0) {
+        toRelax.emplace(amount, e.dst);
+        onIncrease(e.dst);
+    }
+
+    while (!toRelax.empty()) {
+        const auto [_, v] = toRelax.top();
+        toRelax.pop();
+
+        g.anyOutgoing(v, [&](VertexId dst, delay weight) {
+            if (const auto amount = algorithms::paths::relaxOneEdgeASAPST({v, dst, weight}, ASAPST);
+                amount > 0) {
+                toRelax.emplace(amount, dst);
+                onIncrease(dst);
+            }
+            return false;
+        });
+
+        if (v == e.src && algorithms::paths::relaxOneEdgeASAPST(e, ASAPST) > 0) {
+            // We relaxed the edge we added thus, we found a positive cycle.
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename G>
+bool addOneEdgeIncrementalASAPSTImpl(const G &g, const Edge &e, PathTimes &ASAPST) {
+    return addOneEdgeIncrementalASAPSTImpl(g, e, ASAPST, [](VertexId) {});
+}
+
+/// @brief Outcome of an incremental update of the ALAP times
+enum class ALAPUpdate { CONSISTENT, SOURCE_VIOLATED, POSITIVE_CYCLE };
+
+using ALAPQueueEntry = std::tuple<delay, VertexId>;
+constexpr auto kALAPQueueComparator = [](const auto &lhs, const auto &rhs) {
+    return std::get<0>(lhs) < std::get<0>(rhs);
+};
+using ALAPQueue = std::priority_queue<ALAPQueueEntry,
+                                      std::deque<ALAPQueueEntry>,
+                                      decltype(kALAPQueueComparator)>;
+
+/**
+ * @brief Backward counterpart of @ref addOneEdgeIncrementalASAPSTImpl
+ * @details Propagates the decrease of the ALAP times of the vertices in @p toRelax over the
+ * incoming edges, largest decrease first. Sources are never moved, like in the sweeps of
+ * @ref computeALAPSTImpl , so the result is the same as running them from the same times. A
+ * vertex whose decrease comes from a path of @f$|V|@f$ edges proves that there is a positive
+ * cycle.
+ */
+template <typename G>
+ALAPUpdate propagateIncrementalALAPSTImpl(const G &g,
+                                          ALAPQueue &toRelax,
+                                          PathTimes &ALAPST,
+                                          algorithms::paths::IncrementalALAPScratch &scratch) {
+    const auto nrVertices = g.getNumberOfVertices();
+    auto outcome = ALAPUpdate::CONSISTENT;
+
+    while (!toRelax.empty()) {
+        const auto [_, v] = toRelax.top();
+        toRelax.pop();
+        if (ALAPST[v] == kALAPStartValue) {
+            continue;
+        }
+
+        const bool positiveCycle = g.anyIncoming(v, [&](VertexId src, delay weight) {
+            if (ALAPST[v] - weight >= ALAPST[src]) {
+                return false;
+            }
+            if (scratch.isSource(src)) {
+                outcome = ALAPUpdate::SOURCE_VIOLATED;
+                return false;
+            }
+
+            const auto amount = algorithms::paths::relaxOneEdgeALAPST({src, v, weight}, ALAPST);
+            const auto length = scratch.getPathLength(v) + 1;
+            scratch.setPathLength(src, length);
+            if (length >= nrVertices) {
+                return true;
+            }
+            toRelax.emplace(amount, src);
+            return false;
+        });
+
+        if (positiveCycle) {
+            outcome = ALAPUpdate::POSITIVE_CYCLE;
+            break;
+        }
+    }
+
+    scratch.clearPathLengths();
+    return outcome;
+}
+
+template <typename G>
+ALAPUpdate addOneEdgeIncrementalALAPSTImpl(const G &g,
+                                           const Edge &e,
+                                           PathTimes &ALAPST,
+                                           algorithms::paths::IncrementalALAPScratch &scratch) {
+    if (ALAPST[e.dst] == kALAPStartValue || ALAPST[e.dst] - e.weight >= ALAPST[e.src]) {
+        return ALAPUpdate::CONSISTENT;
+    }
+    if (scratch.isSource(e.src)) {
+        return ALAPUpdate::SOURCE_VIOLATED;
+    }
+
+    ALAPQueue toRelax(kALAPQueueComparator);
+    toRelax.emplace(algorithms::paths::relaxOneEdgeALAPST(e, ALAPST), e.src);
+    return propagateIncrementalALAPSTImpl(g, toRelax, ALAPST, scratch);
+}
+
+template <typename G>
+void initializeASAPSTImpl(const G &g,
+                          PathTimes &ASAPST,
+                          const VerticesIds &sources,
+                          bool graphSources) {
+    // Assumption: vertices cannot be deleted, and the id's are continuous
+    for (std::size_t i = 0; i < ASAPST.size(); i++) {
+        if (graphSources && g.isSource(i)) {
+            ASAPST[i] = 0;
+        } else {
+            ASAPST[i] = kASAPStartValue;
+        }
+    }
+
+    for (const auto &source : sources) {
+        ASAPST[source] = 0;
+    }
+}
+
+template <typename G> PathTimes initializeALAPSTImpl(const G &g, bool graphSources) {
+    PathTimes ALAPST(g.getNumberOfVertices());
+
+    // Assumption: vertices cannot be deleted, and the id's are continuous
+    for (std::size_t i = 0; i < ALAPST.size(); i++) {
+        if (graphSources && g.isSource(i)) {
+            ALAPST[i] = 0;
+        } else {
+            ALAPST[i] = kALAPStartValue;
+        }
+    }
+    return ALAPST;
+}
+} // namespace
+
+namespace fms::algorithms::paths {
+using namespace fms::cg;
+
+ForwardOrder::ForwardOrder(const ConstraintGraph &dg) { build(GraphEdges(dg)); }
+
+ForwardOrder::ForwardOrder(const CSRGraph &g) { build(CSREdges(g, {})); }
+
+template <typename G> void ForwardOrder::build(const G &g) {
+    const auto nrVertices = g.getNumberOfVertices();
+
+    // Kahn's algorithm over the non-negative edges, ties broken by vertex id
+    std::vector<std::size_t> inDegree(nrVertices, 0);
+    for (VertexId v = 0; v < nrVertices; ++v) {
+        g.anyOutgoing(v, [&](VertexId dst, delay weight) {
+            if (weight >= 0) {
+                ++inDegree[dst];
+            }
+            return false;
+        });
+    }
 
-template <typename T> fms::problem::JobId minJobId(T &&begin, T &&end) {
-    return std::accumulate(begin,
-                           end,
-                           fms::problem::JobId::max(),
-                           [](fms::problem::JobId minJobId, const fms::cg::Vertex &v) {
-                               return std::min(v.operation.jobId, minJobId);
-                           });
-}
-} // namespace
+    m_order.clear();
+    m_order.reserve(nrVertices);
+    std::vector<std::uint8_t> placed(nrVertices, 0U);
+    for (VertexId v = 0; v < nrVertices; ++v) {
+        if (inDegree[v] == 0) {
+            m_order.push_back(v);
+            placed[v] = 1U;
+        }
+    }
+    for (std::size_t i = 0; i < m_order.size(); ++i) {
+        g.anyOutgoing(m_order[i], [&](VertexId dst, delay weight) {
+            if (weight >= 0 && --inDegree[dst] == 0) {
+                m_order.push_back(dst);
+                placed[dst] = 1U;
+            }
+            return false;
+        });
+    }
 
-namespace fms::algorithms::paths {
-using namespace fms::cg;
+    // Vertices in a cycle of non-negative edges cannot be ordered, they are appended by id and
+    // their edges become backward edges
+    for (VertexId v = 0; v < nrVertices; ++v) {
+        if (placed[v] == 0U) {
+            m_order.push_back(v);
+        }
+    }
+
+    std::vector<std::size_t> position(nrVertices);
+    for (std::size_t i = 0; i < m_order.size(); ++i) {
+        position[m_order[i]] = i;
+    }
+    m_nrBackwardEdges = 0;
+    for (VertexId v = 0; v < nrVertices; ++v) {
+        g.anyOutgoing(v, [&](VertexId dst, delay /*weight*/) {
+            if (position[dst] <= position[v]) {
+                ++m_nrBackwardEdges;
+            }
+            return false;
+        });
+    }
+}
 
 PathTimes
 initializeASAPST(const ConstraintGraph &dg, const VerticesIds &sources, bool graphSources) {
     // Allocate Starting Times array
     PathTimes ASAPST(dg.getNumberOfVertices());
     initializeASAPST(dg, ASAPST, sources, graphSources);
-    return std::move(ASAPST);
+    return ASAPST;
 }
 
 void initializeASAPST(const cg::ConstraintGraph &dg,
                       PathTimes &ASAPST,
                       const cg::VerticesIds &sources,
                       bool graphSources) {
+    initializeASAPSTImpl(dg, ASAPST, sources, graphSources);
+}
 
-    // Assumption: vertices cannot be deleted, and the id's are continuous
-    for (std::size_t i = 0; i < ASAPST.size(); i++) {
-        if (dg.isSource(i) && graphSources) {
-            ASAPST[i] = 0;
-        } else {
-            ASAPST[i] = kASAPStartValue;
-        }
-    }
+PathTimes initializeASAPST(const CSRGraph &g, const VerticesIds &sources, bool graphSources) {
+    PathTimes ASAPST(g.getNumberOfVertices());
+    initializeASAPST(g, ASAPST, sources, graphSources);
+    return ASAPST;
+}
 
-    for (const auto &source : sources) {
-        ASAPST[source] = 0;
-    }
+void initializeASAPST(const CSRGraph &g,
+                      PathTimes &ASAPST,
+                      const VerticesIds &sources,
+                      bool graphSources) {
+    initializeASAPSTImpl(g, ASAPST, sources, graphSources);
 }
 
 PathTimes
 initializeALAPST(const ConstraintGraph &dg, const VerticesIds & /*sources*/, bool graphSources) {
-    // Allocate Starting Times array
-    std::vector<delay> ALAPST(dg.getNumberOfVertices());
+    return initializeALAPSTImpl(dg, graphSources);
+}
 
-    // Step 1: Initialize the ASAPST vector.
-    // Assumption: vertices cannot be deleted, and the id's are continuous
-    for (std::size_t i = 0; i < ALAPST.size(); i++) {
-        if (dg.isSource(i) && graphSources) {
-            ALAPST[i] = 0;
-        } else {
-            ALAPST[i] = kALAPStartValue;
-        }
-    }
-    return std::move(ALAPST);
+PathTimes initializeALAPST(const CSRGraph &g, const VerticesIds & /*sources*/, bool graphSources) {
+    return initializeALAPSTImpl(g, graphSources);
 }
 
 void dumpToFile(const ConstraintGraph &dg,
@@ -86,66 +1036,135 @@ void dumpToFile(const ConstraintGraph &dg,
 //////////
 
 LongestPathResult computeASAPST(const ConstraintGraph &dg, PathTimes &ASAPST) {
-    // This version uses the fact that the memory is contiguous to go faster
-    for (std::size_t i = 1; i < dg.getNumberOfVertices(); i++) {
-        const auto oneEdgeRelaxed = relaxVerticesASAPST(dg, ASAPST);
+    return computeASAPSTImpl(GraphEdges(dg), ASAPST);
+}
 
-        // If no relaxation needed to be performed, we should stop.
-        if (!oneEdgeRelaxed) {
-            return {};
-        }
+LongestPathResult computeASAPST(const GraphOverlay &g, PathTimes &ASAPST) {
+    return computeASAPSTImpl(OverlayEdges(g), ASAPST);
+}
+
+LongestPathResult
+computeASAPST(const ConstraintGraph &dg, PathTimes &ASAPST, LongestPathEngine engine) {
+    switch (engine) {
+    case LongestPathEngine::WORKLIST:
+        return computeASAPSTWorklistImpl(GraphEdges(dg), ASAPST);
+    case LongestPathEngine::TWO_PHASE:
+        return computeASAPST(dg, ASAPST, ForwardOrder(dg));
+    default:
+        return computeASAPST(dg, ASAPST);
     }
+}
 
-    // Step 3: Check for positive cycles. The nth iteration must not change the values computed in
-    // the previous iteration, if that happens, the algorithm will never converge.
-    Edges infeasible;
-    for (const auto &v : dg.getVertices()) {
-        for (const auto &[dst, weight] : v.getOutgoingEdges()) {
-            if ((ASAPST[v.id] != kASAPStartValue) && (ASAPST[v.id] + weight) > ASAPST[dst]) {
-                infeasible.emplace_back(v.id, dst, weight);
-                break;
-            }
-        }
+LongestPathResult
+computeASAPST(const GraphOverlay &g, PathTimes &ASAPST, LongestPathEngine engine) {
+    switch (engine) {
+    case LongestPathEngine::WORKLIST:
+        return computeASAPSTWorklistImpl(OverlayEdges(g), ASAPST);
+    case LongestPathEngine::TWO_PHASE:
+        return computeASAPST(g, ASAPST, ForwardOrder(g.getBase()));
+    default:
+        return computeASAPST(g, ASAPST);
     }
+}
 
-    return {std::move(infeasible)};
+LongestPathResult computeASAPST(const ConstraintGraph &dg, PathTimes &ASAPST, CycleReport report) {
+    if (report == CycleReport::CYCLE) {
+        return computeASAPSTCycleImpl(GraphEdges(dg), ASAPST);
+    }
+    return computeASAPST(dg, ASAPST);
 }
 
-//////////
-// ALAP //
-//////////
+LongestPathResult computeASAPST(const GraphOverlay &g, PathTimes &ASAPST, CycleReport report) {
+    if (report == CycleReport::CYCLE) {
+        return computeASAPSTCycleImpl(OverlayEdges(g), ASAPST);
+    }
+    return computeASAPST(g, ASAPST);
+}
 
 LongestPathResult
-computeALAPST(const ConstraintGraph &dg, PathTimes &ALAPST, const VerticesIds &sources) {
-    // This version uses the fact that the memory is contiguous to go faster
-    Edges infeasible;
+computeASAPSTParallel(const ConstraintGraph &dg, PathTimes &ASAPST, std::size_t nrThreads) {
+    return computeASAPSTParallelImpl(GraphEdges(dg), ASAPST, nrThreads);
+}
+
+LongestPathResult
+computeASAPSTParallel(const GraphOverlay &g, PathTimes &ASAPST, std::size_t nrThreads) {
+    return computeASAPSTParallelImpl(OverlayEdges(g), ASAPST, nrThreads);
+}
 
-    for (std::size_t i = 1; i < dg.getNumberOfVertices(); i++) {
-        const auto [oneEdgeRelaxed, infeasibleEdge] = relaxVerticesALAPST(dg, ALAPST, sources);
+LongestPathResult computeASAPSTParallel(const CSRGraph &g,
+                                        PathTimes &ASAPST,
+                                        std::size_t nrThreads,
+                                        const ExtraEdges &extra) {
+    return computeASAPSTParallelImpl(CSREdges(g, extra), ASAPST, nrThreads);
+}
 
-        if (infeasibleEdge) {
-            infeasible.push_back(infeasibleEdge.value());
-            break;
-        }
+LongestPathResult
+computeASAPST(const ConstraintGraph &dg, PathTimes &ASAPST, const ForwardOrder &order) {
+    return computeASAPSTOrderedImpl(
+            GraphEdges(dg), ASAPST, order.getOrder(), order.getNumberOfBackwardEdges() + 2);
+}
 
-        // If no relaxation needed to be performed, we should stop.
-        if (!oneEdgeRelaxed) {
-            break;
-        }
-    }
+LongestPathResult
+computeASAPST(const GraphOverlay &g, PathTimes &ASAPST, const ForwardOrder &order) {
+    // Each edit may add one backward edge
+    return computeASAPSTOrderedImpl(OverlayEdges(g),
+                                    ASAPST,
+                                    order.getOrder(),
+                                    order.getNumberOfBackwardEdges() + g.getEdges().size() + 2);
+}
 
-    // Step 3: Check for positive cycles. The nth iteration must not change the values computed in
-    // the previous iteration, if that happens, the algorithm will never converge.
-    for (const auto &v : dg.getVertices()) {
-        for (const auto &[src, weight] : v.getIncomingEdges()) {
-            if (((ALAPST[v.id] != kALAPStartValue)) && (ALAPST[v.id] - weight) < ALAPST[src]) {
-                infeasible.emplace_back(src, v.id, weight);
-                break;
-            }
-        }
+LongestPathResult
+computeASAPST(const ConstraintGraph &dg, PathTimes &ASAPST, const Edges &inputEdges) {
+    return computeASAPST(GraphOverlay(dg), ASAPST, inputEdges);
+}
+
+LongestPathResult
+computeASAPST(const GraphOverlay &g, PathTimes &ASAPST, const Edges &inputEdges) {
+    return computeASAPSTImpl(OverlayEdges(g, ExtraEdges(g, inputEdges)), ASAPST);
+}
+
+LongestPathResult computeASAPST(const CSRGraph &g, PathTimes &ASAPST, const ExtraEdges &extra) {
+    return computeASAPSTImpl(CSREdges(g, extra), ASAPST);
+}
+
+LongestPathResult computeASAPST(const CSRGraph &g,
+                                PathTimes &ASAPST,
+                                const ExtraEdges &extra,
+                                LongestPathEngine engine) {
+    switch (engine) {
+    case LongestPathEngine::WORKLIST:
+        return computeASAPSTWorklistImpl(CSREdges(g, extra), ASAPST);
+    case LongestPathEngine::TWO_PHASE: {
+        const ForwardOrder order(g);
+        return computeASAPSTOrderedImpl(CSREdges(g, extra),
+                                        ASAPST,
+                                        order.getOrder(),
+                                        order.getNumberOfBackwardEdges() + extra.size() + 2);
+    }
+    default:
+        return computeASAPST(g, ASAPST, extra);
     }
+}
 
-    return {std::move(infeasible)};
+//////////
+// ALAP //
+//////////
+
+LongestPathResult
+computeALAPST(const ConstraintGraph &dg, PathTimes &ALAPST, const VerticesIds &sources) {
+    return computeALAPSTImpl(GraphEdges(dg), ALAPST, sources);
+}
+
+LongestPathResult
+computeALAPST(const GraphOverlay &g, PathTimes &ALAPST, const VerticesIds &sources) {
+    return computeALAPSTImpl(OverlayEdges(g), ALAPST, sources);
+}
+
+LongestPathResult computeALAPST(const CSRGraph &g,
+                                PathTimes &ALAPST,
+                                const VerticesIds &sources,
+                                const ExtraEdges &extra) {
+    return computeALAPSTImpl(CSREdges(g, extra), ALAPST, sources);
 }
 
 /**
@@ -159,108 +1178,202 @@ computeALAPST(const ConstraintGraph &dg, PathTimes &ALAPST, const VerticesIds &s
 LongestPathResult computeASAPST(const ConstraintGraph &dg,
                                 std::vector<delay> &ASAPST,
                                 const VerticesCRef &sources,
-                                const VerticesCRef &window) {
-    problem::JobId firstJobId = minJobId(window.begin(), window.end());
-    Edges infeasible;
-    VerticesCRef allVertices{sources};
+                                const VerticesCRef &window,
+                                CycleReport report) {
+    problem::JobId firstJobId = problem::JobId::max();
+    for (const Vertex &v : window) {
+        firstJobId = std::min(v.operation.jobId, firstJobId);
+    }
 
+    VerticesCRef allVertices{sources};
     const auto &graphSources = dg.getSources();
     allVertices.insert(allVertices.end(), graphSources.begin(), graphSources.end());
     allVertices.insert(allVertices.end(), window.begin(), window.end());
 
-    // For each vertex, iterate once (should be N-1)
-    const auto nrVertices = allVertices.size();
-    for (std::size_t i = 1; i < nrVertices; i++) {
-        // This flag is used to check if the distance of any vertex is relaxed in an iteration.
-        // Whenever an edge is relaxed, this flag is set and algorithm continues to next iteration.
-        const auto [atLeastOneEdgeRelaxed, infeasibleEdge] =
-                relaxVerticesASAPST(allVertices, dg, firstJobId, ASAPST);
+    if (report == CycleReport::CYCLE) {
+        return computeWindowASAPSTCycleImpl(GraphEdges(dg), ASAPST, allVertices, firstJobId);
+    }
+    return computeWindowASAPSTImpl(GraphEdges(dg), ASAPST, allVertices, firstJobId);
+}
 
-        if (infeasibleEdge) {
-            infeasible.push_back(infeasibleEdge.value());
-            break;
-        }
+LongestPathResult computeASAPST(const GraphOverlay &g,
+                                PathTimes &ASAPST,
+                                const VerticesCRef &sources,
+                                const VerticesCRef &window,
+                                CycleReport report) {
+    problem::JobId firstJobId = problem::JobId::max();
+    for (const Vertex &v : window) {
+        firstJobId = std::min(v.operation.jobId, firstJobId);
+    }
 
-        // If no relaxation needed to be performed, we should stop.
-        if (!atLeastOneEdgeRelaxed) {
-            break;
-        }
+    VerticesCRef allVertices{sources};
+    const auto &graphSources = g.getBase().getSources();
+    allVertices.insert(allVertices.end(), graphSources.begin(), graphSources.end());
+    allVertices.insert(allVertices.end(), window.begin(), window.end());
+
+    if (report == CycleReport::CYCLE) {
+        return computeWindowASAPSTCycleImpl(OverlayEdges(g), ASAPST, allVertices, firstJobId);
+    }
+    return computeWindowASAPSTImpl(OverlayEdges(g), ASAPST, allVertices, firstJobId);
+}
+
+LongestPathResult computeASAPST(const CSRGraph &g,
+                                PathTimes &ASAPST,
+                                const VerticesCRef &sources,
+                                const VerticesCRef &window,
+                                const ExtraEdges &extra) {
+    problem::JobId firstJobId = problem::JobId::max();
+    for (const Vertex &v : window) {
+        firstJobId = std::min(v.operation.jobId, firstJobId);
     }
 
-    // Step 3: Check for positive cycles. The nth iteration must not change the values computed in
-    // the previous iteration, if that happens, the algorithm will never converge.
-    for (const Vertex &v : allVertices) {
-        for (const auto &[dst, weight] : v.getOutgoingEdges()) {
-            // if the vertex was updated at all, check this, otherwise it means the vertex is
-            // disconnected from the sources
-            if ((ASAPST[v.id] != kASAPStartValue) && ((ASAPST[v.id] + weight) > ASAPST[dst])) {
-                infeasible.emplace_back(v.id, dst, weight);
-                break;
-            }
-        }
+    VerticesIds allVertices;
+    allVertices.reserve(sources.size() + g.getSources().size() + window.size());
+    for (const Vertex &v : sources) {
+        allVertices.push_back(v.id);
+    }
+    allVertices.insert(allVertices.end(), g.getSources().begin(), g.getSources().end());
+    for (const Vertex &v : window) {
+        allVertices.push_back(v.id);
     }
 
-    return {infeasible};
+    return computeWindowASAPSTImpl(CSREdges(g, extra), ASAPST, allVertices, firstJobId);
 }
 
 std::tuple<bool, std::optional<Edge>> relaxVerticesASAPST(const VerticesCRef &allVertices,
                                                           const ConstraintGraph &dg,
                                                           problem::JobId firstJobId,
                                                           std::vector<delay> &ASAPST) {
+    return relaxWindowASAPST(GraphEdges(dg), allVertices, firstJobId, ASAPST);
+}
 
-    bool atLeastOneEdgeRelaxed = false;
-    for (const Vertex &v : allVertices) {
-        for (const auto &[dst, weight] : v.getOutgoingEdges()) {
-            auto value = ASAPST[v.id] + weight;
-            if (ASAPST[v.id] != kASAPStartValue && value > ASAPST[dst]) {
-                if (dg.getVertex(dst).operation.jobId < firstJobId) {
-                    // Check if we relaxed a source node (all jobs already scheduled) if we did
-                    // then this means that there's a cycle as we shouldn't be able to relax
-                    // sources.
-                    return {atLeastOneEdgeRelaxed, Edge(v.id, dst, weight)};
-                }
+bool relaxVerticesASAPST(const ConstraintGraph &dg, PathTimes &ASAPST) {
+    return relaxAllASAPST(GraphEdges(dg), ASAPST);
+}
 
-                ASAPST[dst] = value;
-                atLeastOneEdgeRelaxed = true;
-            }
-        }
+std::tuple<bool, std::optional<Edge>>
+relaxVerticesALAPST(const ConstraintGraph &dg, PathTimes &ALAPST, const VerticesIds &sources) {
+    return relaxAllALAPST(GraphEdges(dg), ALAPST, sourcesMask(dg.getNumberOfVertices(), sources));
+}
+
+delay relaxOneEdgeALAPST(const Edge &e, PathTimes &ALAPST) {
+    if (ALAPST[e.dst] == kALAPStartValue) {
+        return 0;
+    }
+    const auto value = ALAPST[e.dst] - e.weight;
+    if (value < ALAPST[e.src]) {
+        const auto relaxAmount = ALAPST[e.src] == kALAPStartValue
+                                         ? std::numeric_limits<delay>::max()
+                                         : ALAPST[e.src] - value;
+        ALAPST[e.src] = value;
+        return relaxAmount;
     }
+    return 0;
+}
 
-    return {atLeastOneEdgeRelaxed, std::nullopt};
+bool addEdgesIncrementalALAPST(const ConstraintGraph &dg,
+                               const Edges &edges,
+                               PathTimes &ALAPST,
+                               const VerticesIds &sources) {
+    return addEdgesIncrementalALAPST(GraphOverlay(dg), edges, ALAPST, sources);
 }
 
-bool relaxVerticesASAPST(const ConstraintGraph &dg, PathTimes &ASAPST) {
-    bool atLeastOneEdgeRelaxed = false;
-    for (const auto &v : dg.getVertices()) {
-        for (const auto &[dst, weight] : v.getOutgoingEdges()) {
-            auto value = ASAPST[v.id] + weight;
-            if (ASAPST[v.id] != kASAPStartValue && value > ASAPST[dst]) {
-                ASAPST[dst] = value;
-                atLeastOneEdgeRelaxed = true;
-            }
+bool addEdgesIncrementalALAPST(const GraphOverlay &g,
+                               const Edges &edges,
+                               PathTimes &ALAPST,
+                               const VerticesIds &sources) {
+    IncrementalALAPScratch scratch;
+    return addEdgesIncrementalALAPST(g, edges, ALAPST, sources, scratch);
+}
+
+bool addEdgesIncrementalALAPST(const GraphOverlay &g,
+                               const Edges &edges,
+                               PathTimes &ALAPST,
+                               const VerticesIds &sources,
+                               IncrementalALAPScratch &scratch) {
+    scratch.markSources(g.getNumberOfVertices(), sources);
+    bool sourceViolated = false;
+    bool positiveCycle = false;
+
+    // The edges are accumulated in a side list, neither the graph nor the overlay are modified
+    ExtraEdges added;
+    for (const auto &e : edges) {
+        // Same as computeALAPST on the graph with the edges: existing edges are kept as they are
+        if (g.hasEdge(e.src, e.dst) || added.hasEdge(e.src, e.dst)) {
+            continue;
+        }
+        added.add(e);
+
+        const auto outcome =
+                addOneEdgeIncrementalALAPSTImpl(OverlayEdges(g, added), e, ALAPST, scratch);
+        if (outcome == ALAPUpdate::POSITIVE_CYCLE) {
+            positiveCycle = true;
+            break;
         }
+        sourceViolated = sourceViolated || outcome == ALAPUpdate::SOURCE_VIOLATED;
     }
 
-    return atLeastOneEdgeRelaxed;
+    scratch.clear();
+    return positiveCycle || sourceViolated;
 }
 
-std::tuple<bool, std::optional<Edge>>
-relaxVerticesALAPST(const ConstraintGraph &dg, PathTimes &ALAPST, const VerticesIds &sources) {
-    bool atLeastOneEdgeRelaxed = false;
-    for (const auto &v : dg.getVertices()) {
-        for (const auto &[src, weight] : v.getIncomingEdges()) {
-            auto value = ALAPST[v.id] - weight;
-            if (ALAPST[v.id] != kALAPStartValue && value < ALAPST[src]) {
-                if (std::find(sources.begin(), sources.end(), src) != sources.end()) {
-                    return {atLeastOneEdgeRelaxed,
-                            std::nullopt}; // we relaxed a source thus infeasible
-                }
-                ALAPST[src] = value;
-                atLeastOneEdgeRelaxed = true;
-            }
-        }
+bool updateIncrementalALAPST(const GraphOverlay &g,
+                             const VerticesIds &decreased,
+                             PathTimes &ALAPST,
+                             const VerticesIds &sources) {
+    IncrementalALAPScratch scratch;
+    return updateIncrementalALAPST(g, decreased, ALAPST, sources, scratch);
+}
+
+bool updateIncrementalALAPST(const GraphOverlay &g,
+                             const VerticesIds &decreased,
+                             PathTimes &ALAPST,
+                             const VerticesIds &sources,
+                             IncrementalALAPScratch &scratch) {
+    scratch.markSources(g.getNumberOfVertices(), sources);
+
+    ALAPQueue toRelax(kALAPQueueComparator);
+    for (const auto v : decreased) {
+        // The decrease is unknown, all the vertices are equally urgent
+        toRelax.emplace(std::numeric_limits<delay>::max(), v);
     }
-    return {atLeastOneEdgeRelaxed, std::nullopt};
+    const auto outcome = propagateIncrementalALAPSTImpl(OverlayEdges(g), toRelax, ALAPST, scratch);
+
+    scratch.clear();
+    return outcome != ALAPUpdate::CONSISTENT;
+}
+
+void IncrementalALAPScratch::markSources(std::size_t nrVertices, const VerticesIds &sources) {
+    if (m_isSource.size() < nrVertices) {
+        m_isSource.resize(nrVertices, 0U);
+        m_pathLength.resize(nrVertices, 0);
+    }
+    m_sources = sources;
+    for (const auto source : m_sources) {
+        m_isSource[source] = 1U;
+    }
+}
+
+void IncrementalALAPScratch::setPathLength(VertexId v, std::size_t length) {
+    if (m_pathLength[v] == 0) {
+        m_touched.push_back(v);
+    }
+    m_pathLength[v] = length;
+}
+
+void IncrementalALAPScratch::clearPathLengths() {
+    for (const auto v : m_touched) {
+        m_pathLength[v] = 0;
+    }
+    m_touched.clear();
+}
+
+void IncrementalALAPScratch::clear() {
+    clearPathLengths();
+    for (const auto source : m_sources) {
+        m_isSource[source] = 0U;
+    }
+    m_sources.clear();
 }
 
 delay relaxOneEdgeASAPST(const Edge &e, PathTimes &ASAPST) {
@@ -276,118 +1389,146 @@ delay relaxOneEdgeASAPST(const Edge &e, PathTimes &ASAPST) {
 }
 
 bool addOneEdgeIncrementalASAPST(const ConstraintGraph &dg, const Edge &e, PathTimes &ASAPST) {
-    using VertexPr = std::tuple<delay, VertexId>;
-    constexpr auto Comparator = [](const auto &lhs, const auto &rhs) {
-        return std::get<0>(lhs) < std::get<0>(rhs);
-    };
-    std::priority_queue<VertexPr, std::deque<VertexPr>, decltype(Comparator)> toRelax(Comparator);
-
-    if (const auto amount = relaxOneEdgeASAPST(e, ASAPST); amount > 0) {
-        toRelax.emplace(amount, e.dst);
-    }
+    return addOneEdgeIncrementalASAPSTImpl(GraphEdges(dg), e, ASAPST);
+}
 
-    while (!toRelax.empty()) {
-        const auto [_, v] = toRelax.top();
-        toRelax.pop();
+bool addOneEdgeIncrementalASAPST(const GraphOverlay &g,
+                                 const Edge &e,
+                                 PathTimes &ASAPST,
+                                 const ExtraEdges &extra) {
+    return addOneEdgeIncrementalASAPSTImpl(OverlayEdges(g, extra), e, ASAPST);
+}
 
-        for (const auto &[dst, weight] : dg.getVertex(v).getOutgoingEdges()) {
-            if (const auto amount = relaxOneEdgeASAPST({v, dst, weight}, ASAPST); amount > 0) {
-                toRelax.emplace(amount, dst);
-            }
-        }
+bool addEdgesIncrementalASAPST(const ConstraintGraph &dg, const Edges &edges, PathTimes &ASAPST) {
+    return addEdgesIncrementalASAPST(GraphOverlay(dg), edges, ASAPST);
+}
 
-        if (v == e.src && relaxOneEdgeASAPST(e, ASAPST) > 0) {
-            // We relaxed the edge we added thus, we found a positive cycle.
-            return true;
-        }
-    }
+bool addEdgesIncrementalASAPST(const GraphOverlay &g, const Edges &edges, PathTimes &ASAPST) {
+    return computeIncrementalASAPST(g, edges, ASAPST).positiveCycle;
+}
 
-    return false;
+IncrementalPathResult
+computeIncrementalASAPST(const GraphOverlay &g, const Edges &edges, PathTimes &ASAPST) {
+    IncrementalASAPScratch scratch;
+    return computeIncrementalASAPST(g, edges, ASAPST, scratch);
 }
 
-bool addEdgesIncrementalASAPST(ConstraintGraph &dg, const Edges &edges, PathTimes &ASAPST) {
-    Edges addedEdges;
+IncrementalPathResult computeIncrementalASAPST(const GraphOverlay &g,
+                                               const Edges &edges,
+                                               PathTimes &ASAPST,
+                                               IncrementalASAPScratch &scratch) {
+    scratch.reserve(g.getNumberOfVertices());
+    const auto onIncrease = [&scratch](VertexId v) { scratch.markTouched(v); };
 
+    IncrementalPathResult result;
+    // The edges are accumulated in the scratch, neither the graph nor the overlay are modified
+    const IncrementalEdges withAdded(g, scratch);
     for (const auto &e : edges) {
-        if (addOneEdgeIncrementalASAPST(dg, e, ASAPST)) {
-            dg.removeEdges(addedEdges);
-            return true;
+        // Same as computeASAPST on the graph with the edges: existing edges are kept as they are
+        if (g.hasEdge(e) || scratch.hasAddedEdge(e.src, e.dst)) {
+            continue;
         }
-
-        if (!dg.hasEdge(e)) {
-            dg.addEdges(e);
-            addedEdges.push_back(e);
+        // The propagation must not see the new edge, it detects a cycle by relaxing it again
+        if (addOneEdgeIncrementalASAPSTImpl(withAdded, e, ASAPST, onIncrease)) {
+            result.positiveCycle = true;
+            break;
         }
+        scratch.addEdge(e);
     }
 
-    dg.removeEdges(addedEdges);
-    return false;
+    result.touchedVertices = scratch.getNumberOfTouched();
+    scratch.clear();
+    return result;
 }
 
-bool addEdgesIncrementalASAPSTConst(ConstraintGraph dg, const Edges &edges, PathTimes &ASAPST) {
-    for (const auto &e : edges) {
-        if (addOneEdgeIncrementalASAPST(dg, e, ASAPST)) {
-            return true;
-        }
+void IncrementalASAPScratch::reserve(std::size_t nrVertices) {
+    if (m_isTouched.size() < nrVertices) {
+        m_isTouched.resize(nrVertices, 0U);
+        m_firstOut.resize(nrVertices, kNoEdge);
+        m_lastOut.resize(nrVertices, kNoEdge);
+        m_firstIn.resize(nrVertices, kNoEdge);
+    }
+}
 
-        if (!dg.hasEdge(e)) {
-            dg.addEdges(e);
-        }
+bool IncrementalASAPScratch::markTouched(VertexId v) {
+    if (m_isTouched[v] != 0U) {
+        return false;
     }
-    return false;
+    m_isTouched[v] = 1U;
+    m_touched.push_back(v);
+    return true;
 }
 
-std::vector<Edge> getPositiveCycle(const ConstraintGraph &dg) {
-    // Code mostly from https://cp-algorithms.com/graph/finding-negative-cycle-in-graph.html
+void IncrementalASAPScratch::addEdge(const Edge &e) {
+    const auto index = static_cast<std::uint32_t>(m_added.size());
+    m_added.push_back({e, kNoEdge, m_firstIn[e.dst]});
+    m_firstIn[e.dst] = index;
+    if (m_firstOut[e.src] == kNoEdge) {
+        m_firstOut[e.src] = index;
+    } else {
+        m_added[m_lastOut[e.src]].nextOut = index;
+    }
+    m_lastOut[e.src] = index;
+}
 
-    auto ASAPST = initializeASAPST(dg);
-    const auto &vertices = dg.getVertices();
-
-    std::vector<std::optional<VertexId>> previous(vertices.size());
-    std::optional<VertexId> lastModified;
-
-    // First find an edge that is part of the cycle
-    for (std::size_t i = 0; i < vertices.size(); i++) {
-        lastModified = std::nullopt;
-        for (const auto &v : vertices) {
-            for (const auto &[dst, weight] : v.getOutgoingEdges()) {
-                const auto value = ASAPST[v.id] + weight;
-                if (ASAPST[v.id] != kASAPStartValue && value > ASAPST[dst]) {
-                    ASAPST[dst] = value;
-                    previous[dst] = v.id;
-                    lastModified = dst;
-                }
-            }
+bool IncrementalASAPScratch::hasAddedEdge(VertexId src, VertexId dst) const noexcept {
+    for (auto i = m_firstIn[dst]; i != kNoEdge; i = m_added[i].nextIn) {
+        if (m_added[i].edge.src == src) {
+            return true;
         }
     }
+    return false;
+}
 
-    // Now, follow the cycle for n iterations, if at some point lastModified is not set,
-    // then, there's no cycle.
-    for (std::size_t i = 0; i < vertices.size(); i++) {
-        if (!lastModified.has_value()) {
-            return {};
-        }
-        lastModified = previous[lastModified.value()];
+void IncrementalASAPScratch::clear() {
+    for (const auto v : m_touched) {
+        m_isTouched[v] = 0U;
+    }
+    m_touched.clear();
+    for (const auto &added : m_added) {
+        m_firstOut[added.edge.src] = kNoEdge;
+        m_lastOut[added.edge.src] = kNoEdge;
+        m_firstIn[added.edge.dst] = kNoEdge;
     }
+    m_added.clear();
+}
 
-    if (!lastModified.has_value()) {
-        return {};
+PathTimes MultiSourcePathTimes::getSource(std::size_t lane) const {
+    PathTimes result(nrSources == 0 ? 0 : times.size() / nrSources);
+    for (VertexId v = 0; v < result.size(); ++v) {
+        result[v] = get(v, lane);
     }
+    return result;
+}
 
-    VertexId vLast = lastModified.value();
-    std::vector<Edge> cycle;
-    bool first = true;
+MultiSourcePathTimes computeASAPSTFromNodes(const CSRGraph &g,
+                                            std::span<const VertexId> sources,
+                                            const ExtraEdges &extra) {
+    MultiSourcePathTimes result;
+    computeASAPSTFromNodesImpl(CSREdges(g, extra), sources, result);
+    return result;
+}
 
-    for (VertexId v = vLast;; v = *previous[v]) {
-        if (v == vLast && cycle.size() > 1) {
-            break;
-        }
+std::vector<Edge> getPositiveCycle(const ConstraintGraph &dg) {
+    auto ASAPST = initializeASAPST(dg);
+    return computeASAPSTCycleImpl(GraphEdges(dg), ASAPST).positiveCycle;
+}
 
-        VertexId src = *previous[v];
-        cycle.emplace_back(src, v, dg.getVertex(src).getWeight(v));
-    }
+Edges getPositiveCycle(const ConstraintGraph &dg, const Edges &edges) {
+    const GraphOverlay overlay(dg);
+    const ExtraEdges extra(overlay, edges);
+    auto ASAPST = initializeASAPST(dg);
+    return computeASAPSTCycleImpl(OverlayEdges(overlay, extra), ASAPST).positiveCycle;
+}
+
+Edges getPositiveCycle(const GraphOverlay &g) {
+    auto ASAPST = initializeASAPST(g.getBase());
+    return computeASAPSTCycleImpl(OverlayEdges(g), ASAPST).positiveCycle;
+}
 
-    return cycle;
+Edges getPositiveCycle(const CSRGraph &g, const ExtraEdges &extra) {
+    auto ASAPST = initializeASAPST(g);
+    return computeASAPSTCycleImpl(CSREdges(g, extra), ASAPST).positiveCycle;
 }
 
 } // namespace fms::algorithms::paths
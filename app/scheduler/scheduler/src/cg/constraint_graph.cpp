@@ -10,7 +10,7 @@ cg::VertexId cg::Graph::addVertex(const problem::Operation &s) {
     VertexId id = lastId++;
 
     auto &v = vertices.emplace_back(id, s);
-    identifierToVertex[s] = id;
+    identifierToVertex.insert(s, id);
     jobToVertex[s.jobId].emplace_back(v.id);
     return id;
 }
@@ -0,0 +1,84 @@
+#include "fms/pch/containers.hpp"
+
+#include "fms/cg/csr_graph.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace fms;
+
+cg::CSRGraph::CSRGraph(const ConstraintGraph &dg) {
+    const auto &vertices = dg.getVertices();
+    const std::size_t nrVertices = vertices.size();
+
+    m_outOffsets.resize(nrVertices + 1, 0);
+    m_inOffsets.resize(nrVertices + 1, 0);
+    m_jobIds.reserve(nrVertices);
+    m_isSource.reserve(nrVertices);
+
+    for (const auto &v : vertices) {
+        m_outOffsets[v.id + 1] = v.getOutgoingEdges().size();
+        m_inOffsets[v.id + 1] = v.getIncomingEdges().size();
+        m_jobIds.push_back(v.operation.jobId);
+        m_isSource.push_back(ConstraintGraph::isSource(v) ? 1U : 0U);
+        if (ConstraintGraph::isSource(v)) {
+            m_sources.push_back(v.id);
+        }
+    }
+    std::partial_sum(m_outOffsets.begin(), m_outOffsets.end(), m_outOffsets.begin());
+    std::partial_sum(m_inOffsets.begin(), m_inOffsets.end(), m_inOffsets.begin());
+
+    m_outDst.reserve(m_outOffsets.back());
+    m_outWeight.reserve(m_outOffsets.back());
+    m_inSrc.reserve(m_inOffsets.back());
+    m_inWeight.reserve(m_inOffsets.back());
+
+    // Keep the iteration order of the maps so that the sweeps visit the edges in the same order
+    for (const auto &v : vertices) {
+        for (const auto &[dst, weight] : v.getOutgoingEdges()) {
+            m_outDst.push_back(dst);
+            m_outWeight.push_back(weight);
+        }
+        for (const auto &[src, weight] : v.getIncomingEdges()) {
+            m_inSrc.push_back(src);
+            m_inWeight.push_back(weight);
+        }
+    }
+}
+
+void cg::ExtraEdges::group() {
+    // Repeated pairs are dropped keeping the first occurrence, as Graph::addEdges does
+    std::vector<std::size_t> order(m_bySrc.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return std::tie(m_bySrc[lhs].src, m_bySrc[lhs].dst)
+               < std::tie(m_bySrc[rhs].src, m_bySrc[rhs].dst);
+    });
+
+    std::vector<bool> keep(m_bySrc.size(), true);
+    for (std::size_t i = 1; i < order.size(); ++i) {
+        const auto &prev = m_bySrc[order[i - 1]];
+        const auto &curr = m_bySrc[order[i]];
+        if (prev.src == curr.src && prev.dst == curr.dst) {
+            keep[order[i]] = false;
+        }
+    }
+
+    Edges unique;
+    unique.reserve(m_bySrc.size());
+    for (std::size_t i = 0; i < m_bySrc.size(); ++i) {
+        if (keep[i]) {
+            unique.push_back(m_bySrc[i]);
+        }
+    }
+
+    m_byDst = unique;
+    std::stable_sort(m_byDst.begin(), m_byDst.end(), CompareDst{});
+    m_bySrc = std::move(unique);
+    std::stable_sort(m_bySrc.begin(), m_bySrc.end(), CompareSrc{});
+}
+
+void cg::ExtraEdges::add(const Edge &e) {
+    m_bySrc.insert(std::upper_bound(m_bySrc.begin(), m_bySrc.end(), e, CompareSrc{}), e);
+    m_byDst.insert(std::upper_bound(m_byDst.begin(), m_byDst.end(), e, CompareDst{}), e);
+}
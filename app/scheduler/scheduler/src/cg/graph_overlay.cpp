@@ -0,0 +1,90 @@
+#include "fms/pch/containers.hpp"
+
+#include "fms/cg/graph_overlay.hpp"
+
+using namespace fms;
+
+cg::Edges cg::GraphOverlay::addEdges(const Edges &edges) {
+    Edges addedEdges;
+    addedEdges.reserve(edges.size());
+    for (const auto &e : edges) {
+        if (!hasEdge(e.src, e.dst)) {
+            addEdges(e);
+            addedEdges.emplace_back(e);
+        }
+    }
+    return addedEdges;
+}
+
+void cg::GraphOverlay::addEdges(const Edge &e) {
+    auto &out = layerOf(m_outSlot, m_out, e.src);
+    auto &in = layerOf(m_inSlot, m_in, e.dst);
+
+    // Existing edges are either in the base graph or were already added to the overlay
+    const bool inBase = m_base->getVertices()[e.src].hasOutgoingEdge(e.dst);
+    auto &outEdges = inBase ? out.overridden : out.added;
+    auto &inEdges = inBase ? in.overridden : in.added;
+
+    for (auto &entry : outEdges) {
+        if (entry.first == e.dst) {
+            entry.second = e.weight;
+            for (auto &inEntry : inEdges) {
+                if (inEntry.first == e.src) {
+                    inEntry.second = e.weight;
+                }
+            }
+            for (auto &edge : m_edges) {
+                if (edge.src == e.src && edge.dst == e.dst) {
+                    edge.weight = e.weight;
+                }
+            }
+            return;
+        }
+    }
+
+    outEdges.emplace_back(e.dst, e.weight);
+    inEdges.emplace_back(e.src, e.weight);
+    m_edges.push_back(e);
+}
+
+void cg::GraphOverlay::clear() {
+    m_edges.clear();
+    m_outSlot.clear();
+    m_inSlot.clear();
+    m_out.clear();
+    m_in.clear();
+}
+
+bool cg::GraphOverlay::hasEdge(VertexId src, VertexId dst) const {
+    if (m_base->hasEdge(src, dst)) {
+        return true;
+    }
+    return !m_outSlot.empty() && m_outSlot[src] != kNoLayer
+           && find(m_out[m_outSlot[src]].added, dst) != nullptr;
+}
+
+delay cg::GraphOverlay::getWeight(VertexId src, VertexId dst) const {
+    if (!m_outSlot.empty() && m_outSlot[src] != kNoLayer) {
+        const auto &layer = m_out[m_outSlot[src]];
+        if (const auto *entry = find(layer.overridden, dst); entry != nullptr) {
+            return entry->second;
+        }
+        if (const auto *entry = find(layer.added, dst); entry != nullptr) {
+            return entry->second;
+        }
+    }
+    return m_base->getWeight(src, dst);
+}
+
+cg::GraphOverlay::Layer &cg::GraphOverlay::layerOf(std::vector<std::uint32_t> &layerSlot,
+                                                   std::vector<Layer> &layers,
+                                                   VertexId v) {
+    if (layerSlot.empty()) {
+        layerSlot.resize(m_base->getNumberOfVertices(), kNoLayer);
+    }
+    if (layerSlot[v] == kNoLayer) {
+        layerSlot[v] = static_cast<std::uint32_t>(layers.size());
+        layers.emplace_back();
+    }
+    return layers[layerSlot[v]];
+}
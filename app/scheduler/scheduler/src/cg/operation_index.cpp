@@ -0,0 +1,28 @@
+#include "fms/pch/containers.hpp"
+
+#include "fms/cg/operation_index.hpp"
+
+using namespace fms;
+
+void cg::OperationIndex::insert(const problem::Operation &op, VertexId v) {
+    if (denseRow(op) == nullptr) {
+        m_sparse[op] = v;
+        return;
+    }
+
+    const auto jobId = op.jobId.value;
+    Row *row = nullptr;
+    if (jobId < kMaxDenseJobId) {
+        if (jobId >= m_jobs.size()) {
+            m_jobs.resize(jobId + 1);
+        }
+        row = &m_jobs[jobId];
+    } else {
+        row = &m_reserved[problem::JobId::max().value - jobId];
+    }
+
+    if (op.operationId >= row->size()) {
+        row->resize(op.operationId + 1, kNoVertex);
+    }
+    (*row)[op.operationId] = v;
+}
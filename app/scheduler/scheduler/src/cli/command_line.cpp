@@ -61,6 +61,10 @@ std::tuple<cxxopts::Options, CLIArgs> getOptions() {
             cxxopts::value<std::string>()->default_value(args.sequenceFile))
         ("max-iterations", "Maximum number of iterations that the algorithm should perform",
             cxxopts::value<std::uint64_t>()->default_value(std::to_string(args.maxIterations)))
+        ("path-threads", "Number of threads used to check the longest paths of complete instances",
+            cxxopts::value<std::uint32_t>()->default_value(std::to_string(args.pathThreads)))
+        ("threads", "Number of threads used by the DD, branch and bound and MNEH solvers",
+            cxxopts::value<std::uint32_t>()->default_value(std::to_string(args.threads)))
         ("modular-algorithm", "Algorithm to use for modular scheduling (broadcast|cocktail|broadcast-half|cocktail-half).", 
             cxxopts::value<std::string>()->default_value(std::string{args.modularAlgorithm.shortName()}))
         ("modular-store-bounds", "Store the bounds of every iteration in the output JSON.")
@@ -79,8 +83,31 @@ std::tuple<cxxopts::Options, CLIArgs> getOptions() {
             "Accepted options are: 'flow','job' or 'fixedorder'",
             cxxopts::value<std::string>()->default_value(std::string{args.shopType.shortName()}))
         ("exploration-type", "Tell the DD solution what type of graph exploration technique it should use.\n"
-            "Accepted options are: 'breadth','depth', 'best','static' or 'adaptive'",
+            "Accepted options are: 'breadth','depth', 'best','static', 'adaptive', 'restricted' or "
+            "'relaxed'",
             cxxopts::value<std::string>()->default_value(std::string{args.explorationType.shortName()}))
+        ("max-width", "Maximum number of states per layer of the 'restricted' and 'relaxed' "
+            "DD exploration types",
+            cxxopts::value<std::uint32_t>()->default_value(std::to_string(args.maxWidth)))
+        ("checkpoint", "File where the DD solver saves its search when it stops before finishing "
+            "it, and periodically if --checkpoint-interval is given",
+            cxxopts::value<std::string>()->default_value(args.checkpointFile))
+        ("checkpoint-interval", "Time between two checkpoints of the DD solver in milliseconds "
+            "(0 only saves it when the search stops)",
+            cxxopts::value<std::int64_t>()->default_value(std::to_string(args.checkpointInterval.count())))
+        ("resume", "Checkpoint file from which the DD solver resumes its search",
+            cxxopts::value<std::string>()->default_value(args.resumeFile))
+        ("history-file", "File where the DD solver streams a record of every state it creates",
+            cxxopts::value<std::string>()->default_value(args.historyFile))
+        ("transposition-memory", "Memory budget in MiB of the table of expanded states that the "
+            "DD solver uses to drop states reached again through another path (0 disables it)",
+            cxxopts::value<std::uint32_t>()->default_value(std::to_string(args.transpositionMemory)))
+        ("node-selection", "Order in which the branch and bound solver expands its open nodes.\n"
+            "Accepted options are: 'depth', 'best' (smallest lower bound first) or 'hybrid' (best "
+            "first, diving to a complete schedule while the node memory budget is exceeded)",
+            cxxopts::value<std::string>()->default_value(std::string{args.nodeSelection.shortName()}))
+        ("node-memory", "Memory budget in MiB of the open nodes of the branch and bound solver",
+            cxxopts::value<std::uint32_t>()->default_value(std::to_string(args.nodeMemory)))
         ("list-algorithms", "List all available algorithms and exit")
         ("list-modular-algorithms", "List all available modular algorithms and exit")
         ("list-modular-multi-algorithm-behaviour,list-modular-multi-algorithm-behavior", 
@@ -241,6 +268,16 @@ CLIArgs getArgs(int argc, char **argv) {
         args.timeOut = std::chrono::milliseconds(result["time-out"].as<std::int64_t>());
         args.maxIterations = result["max-iterations"].as<std::uint64_t>();
         args.maxPartialSolutions = result["max-partial"].as<std::uint32_t>();
+        args.pathThreads = result["path-threads"].as<std::uint32_t>();
+        args.threads = result["threads"].as<std::uint32_t>();
+        args.maxWidth = result["max-width"].as<std::uint32_t>();
+        args.checkpointFile = result["checkpoint"].as<std::string>();
+        args.checkpointInterval =
+                std::chrono::milliseconds(result["checkpoint-interval"].as<std::int64_t>());
+        args.resumeFile = result["resume"].as<std::string>();
+        args.historyFile = result["history-file"].as<std::string>();
+        args.transpositionMemory = result["transposition-memory"].as<std::uint32_t>();
+        args.nodeMemory = result["node-memory"].as<std::uint32_t>();
         args.sequenceFile = result["sequence-file"].as<std::string>();
 
         if (result["modular-store-bounds"].count() > 0) {
@@ -262,6 +299,22 @@ CLIArgs getArgs(int argc, char **argv) {
         args.shopType = ShopType::parse(result["shop-type"].as<std::string>());
         args.explorationType =
                 DDExplorationType::parse(result["exploration-type"].as<std::string>());
+        args.nodeSelection =
+                NodeSelectionType::parse(result["node-selection"].as<std::string>());
+
+        // The parallel branch and bound keeps its open nodes in per-thread depth-first stacks
+        if (args.threads > 1
+            && std::ranges::find(args.algorithms, AlgorithmType{AlgorithmType::BRANCH_BOUND})
+                       != args.algorithms.end()
+            && (args.nodeSelection != NodeSelectionType::DEPTH
+                || args.nodeMemory != CLIArgs{}.nodeMemory)) {
+            fmt::println(std::cerr,
+                         "The branch and bound solver only supports --node-selection and "
+                         "--node-memory with a single thread, got --threads {}",
+                         args.threads);
+            printUsage(options);
+            std::exit(EXIT_FAILURE);
+        }
 
         fmt::println("These are the parsed parameters:");
         for (const auto &kv : result) {
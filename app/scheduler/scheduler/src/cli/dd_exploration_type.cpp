@@ -26,6 +26,12 @@ DDExplorationType DDExplorationType::parse(const std::string &name) {
     if (lowerCase == "adaptive") {
         return DDExplorationType::ADAPTIVE;
     }
+    if (lowerCase == "restricted") {
+        return DDExplorationType::RESTRICTED;
+    }
+    if (lowerCase == "relaxed") {
+        return DDExplorationType::RELAXED;
+    }
     throw std::runtime_error("Unknown shop type: " + name);
 }
 
@@ -41,6 +47,10 @@ std::string_view DDExplorationType::shortName() const {
         return "static";
     case Value::ADAPTIVE:
         return "adaptive";
+    case Value::RESTRICTED:
+        return "restricted";
+    case Value::RELAXED:
+        return "relaxed";
     }
 
     return "";
@@ -0,0 +1,37 @@
+#include "fms/pch/containers.hpp"
+#include "fms/pch/utils.hpp"
+
+#include "fms/cli/node_selection_type.hpp"
+
+#include "fms/utils/strings.hpp"
+
+using namespace fms;
+using namespace fms::cli;
+
+NodeSelectionType NodeSelectionType::parse(const std::string &name) {
+    const std::string lowerCase = utils::strings::toLower(name);
+
+    if (lowerCase == "depth") {
+        return NodeSelectionType::DEPTH;
+    }
+    if (lowerCase == "best") {
+        return NodeSelectionType::BEST;
+    }
+    if (lowerCase == "hybrid") {
+        return NodeSelectionType::HYBRID;
+    }
+    throw std::runtime_error("Unknown node selection type: " + name);
+}
+
+std::string_view NodeSelectionType::shortName() const {
+    switch (m_value) {
+    case Value::DEPTH:
+        return "depth";
+    case Value::BEST:
+        return "best";
+    case Value::HYBRID:
+        return "hybrid";
+    }
+
+    return "";
+}
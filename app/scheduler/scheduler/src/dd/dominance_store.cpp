@@ -0,0 +1,228 @@
+#include "fms/pch/containers.hpp"
+#include "fms/pch/utils.hpp"
+
+#include "fms/dd/dominance_store.hpp"
+
+#include "fms/algorithms/hash.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using namespace fms;
+using namespace fms::dd;
+
+namespace {
+
+/// @brief Latest minus earliest start time. The start values of unreachable vertices wrap around
+/// instead of overflowing.
+inline delay slack(delay ALAPST, delay ASAPST) noexcept {
+    return static_cast<delay>(static_cast<std::uint64_t>(ALAPST)
+                              - static_cast<std::uint64_t>(ASAPST));
+}
+
+} // namespace
+
+DominanceSummary::DominanceSummary(const Vertex &vertex, const problem::Instance &problem) :
+    m_completionHash(std::hash<JobIdxToOpIdx>{}(vertex.getJobsCompletion())) {
+    const auto &dg = problem.getDelayGraph();
+    const auto times = vertex.getTimes()->decode();
+    const auto &ASAPST = times->ASAPST;
+    const auto &ALAPST = times->ALAPST;
+    const auto nrVertices = ASAPST.size();
+
+    m_scheduled.resize((nrVertices + 63) / 64, 0U);
+    m_ready.resize(m_scheduled.size(), 0U);
+    for (const auto vId : vertex.scheduledOps()) {
+        m_scheduled[vId / 64] |= std::uint64_t{1} << (vId % 64);
+    }
+    for (const auto &op : vertex.immediatelyReadyOps()) {
+        const auto vId = dg.getVertexId(op);
+        m_ready[vId / 64] |= std::uint64_t{1} << (vId % 64);
+    }
+    for (std::size_t i = 0; i < m_scheduled.size(); ++i) {
+        m_opsHash = algorithms::hash_combine(m_opsHash, m_scheduled[i]);
+        m_opsHash = algorithms::hash_combine(m_opsHash, m_ready[i]);
+    }
+
+    m_blockSize = std::max<std::size_t>((nrVertices + kBlocks - 1) / kBlocks, 1);
+    m_minSlack.fill(std::numeric_limits<delay>::max());
+    m_maxSlack.fill(std::numeric_limits<delay>::min());
+    m_minASAPST.fill(std::numeric_limits<delay>::max());
+    m_maxASAPST.fill(std::numeric_limits<delay>::min());
+    for (cg::VertexId vId = 0; vId < nrVertices; ++vId) {
+        if (isScheduled(vId)) {
+            continue;
+        }
+        const auto block = vId / m_blockSize;
+        const auto vSlack = slack(ALAPST[vId], ASAPST[vId]);
+        m_minSlack[block] = std::min(m_minSlack[block], vSlack);
+        m_maxSlack[block] = std::max(m_maxSlack[block], vSlack);
+        if (!isReady(vId)) {
+            m_minASAPST[block] = std::min(m_minASAPST[block], ASAPST[vId]);
+            m_maxASAPST[block] = std::max(m_maxASAPST[block], ASAPST[vId]);
+        }
+    }
+}
+
+bool DominanceSummary::mayBeDominatedBy(const DominanceSummary &other) const noexcept {
+    // The blocks only cover the same vertices when both states have the same operations left
+    if (m_opsHash != other.m_opsHash || m_scheduled != other.m_scheduled
+        || m_ready != other.m_ready) {
+        return true;
+    }
+
+    // Element-wise dominance implies the same order between the block minimums and maximums
+    for (std::size_t b = 0; b < kBlocks; ++b) {
+        if (other.m_minSlack[b] > m_minSlack[b] || other.m_maxSlack[b] > m_maxSlack[b]
+            || other.m_minASAPST[b] < m_minASAPST[b] || other.m_maxASAPST[b] < m_maxASAPST[b]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool fms::dd::isDominated(const Vertex &newVertex,
+                          const DominanceSummary &newSummary,
+                          const Vertex &oldVertex,
+                          const DominanceSummary &oldSummary,
+                          const problem::Instance &problem) {
+    const auto &dg = problem.getDelayGraph();
+    const auto &allSequencesNew = newVertex.getMachinesSequences();
+    const auto &allSequencesOld = oldVertex.getMachinesSequences();
+
+    if (allSequencesNew.size() != allSequencesOld.size()
+        || !newSummary.mayBeDominatedBy(oldSummary)) {
+        return false;
+    }
+
+    const auto newTimes = newVertex.getTimes()->decode();
+    const auto oldTimes = oldVertex.getTimes()->decode();
+    const auto &newASAPST = newTimes->ASAPST;
+    const auto &oldASAPST = oldTimes->ASAPST;
+    const auto &newALAPST = newTimes->ALAPST;
+    const auto &oldALAPST = oldTimes->ALAPST;
+
+    const auto allReadyOps = newVertex.immediatelyReadyOps();
+
+    // If it is dominated, possible start time (machine availability + sequence dependent setup
+    // times) are always higher for the old than for the new
+    const bool opStartTimeDominance = std::all_of(
+            allSequencesNew.begin(), allSequencesNew.end(), [&](const auto &machineSequenceNew) {
+                const auto &mId = machineSequenceNew.first;
+                // Merged states do not keep their sequences, so the machines can differ
+                const auto itOld = allSequencesOld.find(mId);
+                if (itOld == allSequencesOld.end()) {
+                    return false;
+                }
+                const auto &sequenceOld = itOld->second;
+                const auto &sequenceNew = machineSequenceNew.second;
+                if (machineSequenceNew.second.empty() || sequenceOld.empty()) {
+                    LOG_W("Empty edges for machine {}", machineSequenceNew.first);
+                    return false;
+                }
+
+                problem::OperationsVector readyOps;
+                std::copy_if(allReadyOps.begin(),
+                             allReadyOps.end(),
+                             back_inserter(readyOps),
+                             [&](const auto &op) { return problem.getMachine(op) == mId; });
+
+                const auto vIdDstNew = dg.getVertexId(sequenceNew.back());
+                const auto vIdDstOld = dg.getVertexId(sequenceOld.back());
+                if (readyOps.empty()) {
+                    return newASAPST.at(vIdDstNew) + problem.getProcessingTime(vIdDstNew)
+                           >= oldASAPST.at(vIdDstOld) + problem.getProcessingTime(vIdDstOld);
+                }
+
+                const auto &opDstNew = dg.getVertex(vIdDstNew).operation;
+                const auto &opDstOld = dg.getVertex(vIdDstOld).operation;
+
+                return std::all_of(readyOps.begin(), readyOps.end(), [&](const auto &op) {
+                    return newASAPST.at(vIdDstNew) + problem.query(opDstNew, op)
+                           >= oldASAPST.at(vIdDstOld) + problem.query(opDstOld, op);
+                });
+            });
+
+    if (!opStartTimeDominance) {
+        return false;
+    }
+
+    for (cg::VertexId vId = 0; vId < newASAPST.size(); ++vId) {
+        // it is always dominated based on the scheduled operations because we only check yet to
+        // be scheduled ops
+        if (newSummary.isScheduled(vId)) {
+            continue;
+        }
+        if (slack(oldALAPST[vId], oldASAPST[vId]) > slack(newALAPST[vId], newASAPST[vId])) {
+            return false;
+        }
+        // if it is in ready ops then the start time is already handled by opStartTimeDominance
+        if (!newSummary.isReady(vId) && oldASAPST[vId] < newASAPST[vId]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DominanceStore::addIfNotDominated(const SharedVertex &newVertex,
+                                       const problem::Instance &problem) {
+    DominanceSummary newSummary(*newVertex, problem);
+    auto &bucket = m_buckets[newSummary.completionHash()];
+
+    // Different job completions can share the hash so they are compared too
+    const auto &completion = newVertex->getJobsCompletion();
+    for (const auto &[v, summary] : bucket) {
+        if (v->getJobsCompletion() == completion
+            && isDominated(*newVertex, newSummary, *v, summary, problem)) {
+            // It is dominated we can discard it
+            LOG("state is dominated");
+            return true;
+        }
+    }
+
+    const auto dominated = std::remove_if(bucket.begin(), bucket.end(), [&](const Entry &e) {
+        if (e.vertex->getJobsCompletion() == completion
+            && isDominated(*e.vertex, e.summary, *newVertex, newSummary, problem)) {
+            // It dominates the vertex so we remove it
+            LOG("state dominates");
+            return true;
+        }
+        return false;
+    });
+    m_size -= static_cast<std::size_t>(std::distance(dominated, bucket.end()));
+    bucket.erase(dominated, bucket.end());
+
+    // If it is not dominated, we add it
+    LOG("state is added");
+    bucket.push_back({newVertex, std::move(newSummary)});
+    ++m_size;
+    return false;
+}
+
+void DominanceStore::insert(const SharedVertex &vertex, const problem::Instance &problem) {
+    DominanceSummary summary(*vertex, problem);
+    m_buckets[summary.completionHash()].push_back({vertex, std::move(summary)});
+    ++m_size;
+}
+
+void DominanceStore::erase(const Vertex &vertex) {
+    const auto it = m_buckets.find(std::hash<JobIdxToOpIdx>{}(vertex.getJobsCompletion()));
+    if (it == m_buckets.end()) {
+        return;
+    }
+
+    auto &bucket = it->second;
+    const auto entry = std::find_if(bucket.begin(), bucket.end(), [&](const Entry &e) {
+        return e.vertex->id() == vertex.id();
+    });
+    if (entry == bucket.end()) {
+        return;
+    }
+
+    std::swap(*entry, bucket.back());
+    bucket.pop_back();
+    --m_size;
+    if (bucket.empty()) {
+        m_buckets.erase(it);
+    }
+}
@@ -0,0 +1,162 @@
+#include "fms/pch/containers.hpp"
+
+#include "fms/dd/state_history.hpp"
+
+#include "fms/scheduler_exception.hpp"
+
+#include <array>
+#include <cstring>
+
+using namespace fms;
+using namespace fms::dd;
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'F', 'M', 'S', 'D', 'D', 'H', 'S', '\0'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kHeaderSize = kMagic.size() + sizeof(kVersion);
+
+/// Job id stored for the root, which has no last operation
+constexpr auto kNoJob = problem::JobId::max();
+
+/// id, parentId, depth, lowerBound, jobId, operationId and fate, without padding
+constexpr std::size_t kRecordSize = 3 * sizeof(VertexId) + sizeof(delay)
+                                    + sizeof(problem::JobId::ValueType)
+                                    + sizeof(problem::OperationId) + sizeof(StateFate);
+
+using RecordBytes = std::array<char, kRecordSize>;
+
+template <typename T> char *put(char *out, T value) {
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+template <typename T> const char *get(const char *in, T &value) {
+    std::memcpy(&value, in, sizeof(T));
+    return in + sizeof(T);
+}
+
+} // namespace
+
+HistoryRecord
+HistoryRecord::create(const Vertex &vertex, const cg::ConstraintGraph &dg, StateFate fate) {
+    HistoryRecord record{.id = vertex.id(),
+                         .parentId = vertex.parentId(),
+                         .depth = vertex.vertexDepth(),
+                         .lowerBound = vertex.lowerBound(),
+                         .lastOperation = std::nullopt,
+                         .fate = fate};
+    if (const auto vId = vertex.getLastScheduledOperation(); vId && dg.isVisible(*vId)) {
+        record.lastOperation = dg.getOperation(*vId);
+    }
+    return record;
+}
+
+HistoryWriter::HistoryWriter(const std::filesystem::path &file) :
+    m_out(file, std::ios::binary | std::ios::out | std::ios::trunc) {
+    if (!m_out) {
+        throw FmsSchedulerException(
+                fmt::format("Unable to create the DD state history {}", file.string()));
+    }
+    m_out.write(kMagic.data(), kMagic.size());
+    m_out.write(reinterpret_cast<const char *>(&kVersion), sizeof(kVersion));
+}
+
+void HistoryWriter::write(const HistoryRecord &record) {
+    RecordBytes bytes{};
+    auto *out = put(bytes.data(), record.id);
+    out = put(out, record.parentId);
+    out = put(out, record.depth);
+    out = put(out, record.lowerBound);
+    out = put(out, record.lastOperation ? record.lastOperation->jobId.value : kNoJob.value);
+    out = put(out, record.lastOperation ? record.lastOperation->operationId : 0);
+    put(out, record.fate);
+    m_out.write(bytes.data(), bytes.size());
+    ++m_size;
+}
+
+void HistoryWriter::flush() { m_out.flush(); }
+
+HistoryReader::HistoryReader(const std::filesystem::path &file) :
+    m_file(file), m_in(file, std::ios::binary | std::ios::in) {
+    std::array<char, kMagic.size()> magic{};
+    std::uint32_t version = 0;
+    m_in.read(magic.data(), magic.size());
+    m_in.read(reinterpret_cast<char *>(&version), sizeof(version));
+    if (!m_in || magic != kMagic || version != kVersion) {
+        throw FmsSchedulerException(
+                fmt::format("{} is not a DD state history", m_file.string()));
+    }
+
+    // A record cut by an interrupted run is ignored
+    m_size = (std::filesystem::file_size(m_file) - kHeaderSize) / kRecordSize;
+}
+
+HistoryRecord HistoryReader::at(std::size_t index) {
+    if (index >= m_size) {
+        throw std::out_of_range(fmt::format("DD state history record {} out of range", index));
+    }
+
+    RecordBytes bytes{};
+    m_in.seekg(static_cast<std::streamoff>(kHeaderSize + index * kRecordSize));
+    m_in.read(bytes.data(), bytes.size());
+    if (!m_in) {
+        throw FmsSchedulerException(
+                fmt::format("Unable to read the DD state history {}", m_file.string()));
+    }
+
+    HistoryRecord record;
+    problem::JobId::ValueType jobId = 0;
+    problem::OperationId operationId = 0;
+    const auto *in = get(bytes.data(), record.id);
+    in = get(in, record.parentId);
+    in = get(in, record.depth);
+    in = get(in, record.lowerBound);
+    in = get(in, jobId);
+    in = get(in, operationId);
+    get(in, record.fate);
+    if (problem::JobId(jobId) != kNoJob) {
+        record.lastOperation = problem::Operation{problem::JobId(jobId), operationId, std::nullopt};
+    }
+    return record;
+}
+
+std::optional<HistoryRecord> HistoryReader::find(VertexId id) {
+    std::size_t first = 0;
+    std::size_t last = m_size;
+    while (first < last) {
+        const auto middle = first + (last - first) / 2;
+        auto record = at(middle);
+        if (record.id == id) {
+            return record;
+        }
+        if (record.id < id) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return std::nullopt;
+}
+
+HistoryTree HistoryTree::build(std::size_t nrRecords, const RecordLookup &lookup) {
+    HistoryTree tree;
+    tree.positions.reserve(nrRecords);
+    for (std::size_t i = 0; i < nrRecords; ++i) {
+        const auto record = lookup(i);
+        // The parents have lower ids, so their records come first
+        if (record.parentId != record.id && tree.positions.contains(record.parentId)) {
+            tree.children[record.parentId].push_back(record.id);
+        } else {
+            tree.roots.push_back(record.id);
+        }
+        tree.positions.emplace(record.id, i);
+    }
+    return tree;
+}
+
+const std::vector<VertexId> &HistoryTree::childrenOf(VertexId id) const {
+    static const std::vector<VertexId> kNoChildren;
+    const auto it = children.find(id);
+    return it == children.end() ? kNoChildren : it->second;
+}
@@ -0,0 +1,140 @@
+#include "fms/pch/containers.hpp"
+#include "fms/pch/fmt.hpp"
+
+#include "fms/dd/state_queue.hpp"
+
+#include "fms/dd/comparator.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+using namespace fms;
+using namespace fms::dd;
+
+StateQueue::StateQueue(cli::DDExplorationType explorationType) :
+    m_explorationType(explorationType) {
+    switch (explorationType) {
+    case cli::DDExplorationType::DEPTH:
+    case cli::DDExplorationType::BREADTH:
+    case cli::DDExplorationType::BEST:
+    case cli::DDExplorationType::STATIC:
+    case cli::DDExplorationType::ADAPTIVE:
+    case cli::DDExplorationType::RESTRICTED:
+    case cli::DDExplorationType::RELAXED:
+        break;
+    default:
+        // Only reachable with a value outside of the enumeration, whose short name is empty
+        throw std::runtime_error(
+                fmt::format("FmsScheduler::unknown graph exploration type {} supplied to the DD "
+                            "state queue",
+                            static_cast<int>(explorationType)));
+    }
+}
+
+bool StateQueue::isRanked() const noexcept {
+    return m_explorationType == cli::DDExplorationType::BEST
+           || m_explorationType == cli::DDExplorationType::STATIC
+           || m_explorationType == cli::DDExplorationType::ADAPTIVE;
+}
+
+void StateQueue::push(SharedVertex vertex) {
+    const auto lowerBound = vertex->lowerBound();
+    ++m_lowerBounds[lowerBound];
+    ++m_size;
+
+    if (!isRanked()) {
+        m_ordered.push_back(std::move(vertex));
+        return;
+    }
+
+    const auto depth = vertex->vertexDepth();
+    if (depth >= m_ranked.size()) {
+        m_ranked.resize(depth + 1);
+    }
+    m_ranked[depth][lowerBound].push_back(std::move(vertex));
+}
+
+SharedVertex StateQueue::pop(const DDSolution &solution) {
+    SharedVertex vertex;
+    if (!isRanked()) {
+        if (m_explorationType == cli::DDExplorationType::DEPTH) {
+            vertex = std::move(m_ordered.back());
+            m_ordered.pop_back();
+        } else {
+            vertex = std::move(m_ordered.front());
+            m_ordered.pop_front();
+        }
+    } else {
+        const auto depth = m_explorationType == cli::DDExplorationType::BEST
+                                   ? bestDepth()
+                                   : bestRankDepth(solution);
+        auto &buckets = m_ranked[depth];
+        const auto bucket = buckets.begin();
+        vertex = std::move(bucket->second.back());
+        bucket->second.pop_back();
+        if (bucket->second.empty()) {
+            buckets.erase(bucket);
+        }
+    }
+
+    removeLowerBound(vertex->lowerBound());
+    --m_size;
+    return vertex;
+}
+
+std::vector<SharedVertex> StateQueue::takeAll() {
+    std::vector<SharedVertex> states;
+    states.reserve(m_size);
+    std::move(m_ordered.begin(), m_ordered.end(), std::back_inserter(states));
+    for (auto &buckets : m_ranked) {
+        for (auto &[_, bucket] : buckets) {
+            std::move(bucket.begin(), bucket.end(), std::back_inserter(states));
+        }
+    }
+
+    m_ordered.clear();
+    m_ranked.clear();
+    m_lowerBounds.clear();
+    m_size = 0;
+    return states;
+}
+
+std::size_t StateQueue::bestDepth() const {
+    // The deepest state with the lowest lower bound
+    const auto lowerBound = minLowerBound();
+    for (auto depth = m_ranked.size(); depth-- > 0;) {
+        const auto &buckets = m_ranked[depth];
+        if (!buckets.empty() && buckets.begin()->first == lowerBound) {
+            return depth;
+        }
+    }
+    throw std::logic_error("StateQueue::bestDepth: the lower bounds are out of sync");
+}
+
+std::size_t StateQueue::bestRankDepth(const DDSolution &solution) const {
+    // The rank grows with the lower bound, so the best state of a depth is in its first bucket
+    const CompareVerticesRanking ranking(solution);
+    auto bestRank = std::numeric_limits<double>::max();
+    auto best = m_ranked.size();
+    for (auto depth = m_ranked.size(); depth-- > 0;) {
+        const auto &buckets = m_ranked[depth];
+        if (buckets.empty()) {
+            continue;
+        }
+        const auto rank = ranking.rank(depth, buckets.begin()->first);
+        if (best == m_ranked.size() || rank < bestRank) {
+            bestRank = rank;
+            best = depth;
+        }
+    }
+    return best;
+}
+
+void StateQueue::removeLowerBound(delay lowerBound) {
+    const auto it = m_lowerBounds.find(lowerBound);
+    if (--it->second == 0) {
+        m_lowerBounds.erase(it);
+    }
+}
@@ -0,0 +1,152 @@
+#include "fms/pch/containers.hpp"
+
+#include "fms/dd/state_times.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace fms;
+using namespace fms::dd;
+
+namespace {
+
+std::atomic<std::uint64_t> nextKey{0};
+
+/// @brief Least recently used decoded times of the calling thread
+class DecodedCache {
+public:
+    [[nodiscard]] StateTimes::DecodedPtr find(std::uint64_t key) {
+        const auto it = std::find_if(m_entries.begin(), m_entries.end(), [key](const auto &e) {
+            return e.first == key;
+        });
+        if (it == m_entries.end()) {
+            return nullptr;
+        }
+        // Move the entry to the front so that it is evicted last
+        std::rotate(m_entries.begin(), it, it + 1);
+        return m_entries.front().second;
+    }
+
+    void insert(std::uint64_t key, StateTimes::DecodedPtr decoded) {
+        if (m_entries.size() == StateTimes::kCacheSize) {
+            m_entries.pop_back();
+        }
+        m_entries.emplace(m_entries.begin(), key, std::move(decoded));
+    }
+
+private:
+    std::vector<std::pair<std::uint64_t, StateTimes::DecodedPtr>> m_entries;
+};
+
+DecodedCache &cache() {
+    thread_local DecodedCache decodedCache;
+    return decodedCache;
+}
+
+template <typename R>
+void appendDelta(const algorithms::paths::PathTimes &parent,
+                 const algorithms::paths::PathTimes &times,
+                 std::vector<R> &delta) {
+    for (std::uint32_t v = 0; v < times.size(); ++v) {
+        if (times[v] == parent[v]) {
+            continue;
+        }
+        const auto diff =
+                static_cast<std::uint64_t>(times[v]) - static_cast<std::uint64_t>(parent[v]);
+        if (!delta.empty() && delta.back().first + delta.back().count == v
+            && delta.back().diff == diff) {
+            ++delta.back().count;
+        } else {
+            delta.push_back({v, 1, diff});
+        }
+    }
+}
+
+template <typename R>
+void applyDelta(const std::vector<R> &delta, algorithms::paths::PathTimes &times) {
+    for (const auto &[first, count, diff] : delta) {
+        for (auto v = first; v < first + count; ++v) {
+            times[v] = static_cast<delay>(static_cast<std::uint64_t>(times[v]) + diff);
+        }
+    }
+}
+
+} // namespace
+
+StateTimes::Ptr StateTimes::create(algorithms::paths::PathTimes ASAPST,
+                                   algorithms::paths::PathTimes ALAPST) {
+    // The constructor is private so make_shared cannot be used
+    std::shared_ptr<StateTimes> times(new StateTimes());
+    times->m_key = nextKey.fetch_add(1, std::memory_order_relaxed);
+    times->m_lowerBound = ASAPST.back();
+    times->m_full = std::make_shared<const Decoded>(Decoded{std::move(ASAPST), std::move(ALAPST)});
+    return times;
+}
+
+StateTimes::Ptr StateTimes::create(const Ptr &parent,
+                                   algorithms::paths::PathTimes ASAPST,
+                                   algorithms::paths::PathTimes ALAPST) {
+    if (parent->m_chainLength + 1 >= kMaxChainLength) {
+        return create(std::move(ASAPST), std::move(ALAPST));
+    }
+
+    const auto base = parent->decode();
+    std::shared_ptr<StateTimes> times(new StateTimes());
+    appendDelta(base->ASAPST, ASAPST, times->m_ASAPSTDelta);
+    appendDelta(base->ALAPST, ALAPST, times->m_ALAPSTDelta);
+
+    const auto deltaBytes =
+            (times->m_ASAPSTDelta.size() + times->m_ALAPSTDelta.size()) * sizeof(Run);
+    const auto fullBytes = (ASAPST.size() + ALAPST.size()) * sizeof(delay);
+    if (2 * deltaBytes > fullBytes) {
+        return create(std::move(ASAPST), std::move(ALAPST));
+    }
+
+    times->m_ASAPSTDelta.shrink_to_fit();
+    times->m_ALAPSTDelta.shrink_to_fit();
+    times->m_key = nextKey.fetch_add(1, std::memory_order_relaxed);
+    times->m_parent = parent;
+    times->m_chainLength = parent->m_chainLength + 1;
+    times->m_lowerBound = ASAPST.back();
+    cache().insert(times->m_key,
+                   std::make_shared<const Decoded>(Decoded{std::move(ASAPST), std::move(ALAPST)}));
+    return times;
+}
+
+StateTimes::DecodedPtr StateTimes::decode() const {
+    if (m_full) {
+        return m_full;
+    }
+    auto &decodedCache = cache();
+    if (auto decoded = decodedCache.find(m_key)) {
+        return decoded;
+    }
+
+    // Go up until a full copy or cached times are found
+    std::vector<const StateTimes *> chain{this};
+    DecodedPtr base;
+    for (const auto *t = m_parent.get(); base == nullptr; t = t->m_parent.get()) {
+        base = t->m_full ? t->m_full : decodedCache.find(t->m_key);
+        if (base == nullptr) {
+            chain.push_back(t);
+        }
+    }
+
+    auto decoded = std::make_shared<Decoded>(*base);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        applyDelta((*it)->m_ASAPSTDelta, decoded->ASAPST);
+        applyDelta((*it)->m_ALAPSTDelta, decoded->ALAPST);
+    }
+    decodedCache.insert(m_key, decoded);
+    return decoded;
+}
+
+std::size_t StateTimes::memoryUsage() const noexcept {
+    auto bytes = sizeof(StateTimes)
+                 + (m_ASAPSTDelta.capacity() + m_ALAPSTDelta.capacity()) * sizeof(Run);
+    if (m_full) {
+        bytes += sizeof(Decoded)
+                 + (m_full->ASAPST.capacity() + m_full->ALAPST.capacity()) * sizeof(delay);
+    }
+    return bytes;
+}
@@ -0,0 +1,79 @@
+#include "fms/pch/containers.hpp"
+
+#include "fms/dd/transposition_table.hpp"
+
+using namespace fms;
+using namespace fms::dd;
+
+std::uint64_t zobrist::hash(const Vertex &vertex) noexcept {
+    std::uint64_t hash = 0;
+    const auto &jobsCompletion = vertex.getJobsCompletion();
+    for (std::size_t jobIdx = 0; jobIdx < jobsCompletion.size(); ++jobIdx) {
+        hash ^= completionKey(jobIdx, jobsCompletion[jobIdx]);
+    }
+    for (const auto &[_, vId] : vertex.getLastOperation()) {
+        hash ^= lastOperationKey(vId);
+    }
+    const auto &jobOrder = vertex.getJobOrder();
+    for (std::size_t position = 0; position < jobOrder.size(); ++position) {
+        hash ^= jobOrderKey(position, jobOrder[position]);
+    }
+    return hash;
+}
+
+bool TranspositionTable::isDominated(const Vertex &vertex, const problem::Instance &problem) {
+    if (vertex.isRelaxed()) {
+        return false;
+    }
+
+    const auto it = m_entries.find(vertex.transpositionHash());
+    // Different states can share the hash, the job completions are compared to be sure that the
+    // dominance check is meaningful
+    if (it == m_entries.end() || it->second.vertex->id() == vertex.id()
+        || it->second.vertex->getJobsCompletion() != vertex.getJobsCompletion()) {
+        ++m_misses;
+        return false;
+    }
+
+    const auto &entry = it->second;
+    if (!dd::isDominated(
+                vertex, DominanceSummary(vertex, problem), *entry.vertex, entry.summary, problem)) {
+        ++m_misses;
+        return false;
+    }
+    ++m_hits;
+    return true;
+}
+
+void TranspositionTable::insert(const SharedVertex &vertex, const problem::Instance &problem) {
+    if (vertex->isRelaxed()) {
+        return;
+    }
+
+    DominanceSummary summary(*vertex, problem);
+    // Only the times that differ from the parent are counted, the others are usually shared with
+    // states that are still in the search
+    const auto bytes = vertex->memoryUsage() + vertex->getTimes()->memoryUsage()
+                       + summary.memoryUsage() + sizeof(Entry) + sizeof(std::uint64_t);
+    if (bytes > m_budget) {
+        return;
+    }
+
+    const auto hash = vertex->transpositionHash();
+    if (const auto it = m_entries.find(hash); it != m_entries.end()) {
+        m_bytes -= it->second.bytes;
+        it->second = Entry{vertex, std::move(summary), bytes};
+    } else {
+        m_entries.emplace(hash, Entry{vertex, std::move(summary), bytes});
+        m_order.push_back(hash);
+    }
+    m_bytes += bytes;
+
+    while (m_bytes > m_budget) {
+        const auto oldest = m_entries.find(m_order.front());
+        m_order.pop_front();
+        m_bytes -= oldest->second.bytes;
+        m_entries.erase(oldest);
+        ++m_evictions;
+    }
+}
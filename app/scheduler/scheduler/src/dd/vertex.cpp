@@ -24,3 +24,23 @@ cg::Edges Vertex::getAllEdges(const problem::Instance &problem) const {
     }
     return allEdges;
 }
+
+std::size_t Vertex::memoryUsage() const noexcept {
+    // Rough size of a node of the standard maps: the value and two or three pointers
+    constexpr std::size_t kNodeOverhead = 3 * sizeof(void *);
+
+    std::size_t bytes = sizeof(Vertex);
+    for (const auto &[machine, ops] : m_machinesSequences) {
+        bytes += sizeof(std::pair<const problem::MachineId, solvers::Sequence>) + kNodeOverhead
+                 + ops.capacity() * sizeof(problem::Operation);
+    }
+    for (const auto &[job, ops] : m_readyOps) {
+        bytes += sizeof(std::pair<const problem::JobId, problem::OperationsVector>)
+                 + kNodeOverhead + ops.capacity() * sizeof(problem::Operation);
+    }
+    bytes += m_lastOperation.size() * (sizeof(MachineToVertex::value_type) + kNodeOverhead);
+    bytes += m_jobsCompletion.capacity() * sizeof(std::size_t);
+    bytes += m_jobOrder.capacity() * sizeof(problem::JobId);
+    bytes += (m_scheduledOps.capacity() + m_encounteredOps.capacity()) * sizeof(cg::VertexId);
+    return bytes;
+}
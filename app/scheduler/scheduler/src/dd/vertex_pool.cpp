@@ -0,0 +1,79 @@
+#include "fms/pch/containers.hpp"
+
+#include "fms/dd/vertex_pool.hpp"
+
+#include <algorithm>
+
+using namespace fms;
+using namespace fms::dd;
+
+std::shared_ptr<VertexPool> VertexPool::create() {
+    // The owner only marks the pool as orphaned, the last vertex deletes it
+    return {new VertexPool(), [](VertexPool *pool) {
+                pool->m_orphaned = true;
+                pool->deleteIfUnused();
+            }};
+}
+
+VertexPtr VertexPool::make(Vertex &&vertex) {
+    const auto depth = vertex.vertexDepth();
+    if (depth >= m_levels.size()) {
+        m_levels.resize(depth + 1);
+    }
+    auto &level = m_levels[depth];
+
+    detail::VertexSlot *slot = nullptr;
+    if (level.freeList != nullptr) {
+        slot = std::exchange(level.freeList, level.freeList->nextFree);
+    } else {
+        if (level.lastSlabUsed == level.lastSlabSize) {
+            level.lastSlabSize = std::clamp(2 * level.lastSlabSize, kMinSlabSize, kMaxSlabSize);
+            level.lastSlabUsed = 0;
+            level.slabs.push_back(
+                    std::make_unique_for_overwrite<detail::VertexSlot[]>(level.lastSlabSize));
+        }
+        slot = &level.slabs.back()[level.lastSlabUsed++];
+    }
+
+    ::new (static_cast<void *>(slot->storage)) Vertex(std::move(vertex));
+    slot->pool = this;
+    slot->nextFree = nullptr;
+    slot->refs = 1;
+    slot->level = static_cast<std::uint32_t>(depth);
+    ++level.live;
+    ++m_live;
+    return VertexPtr(slot);
+}
+
+void VertexPool::release(detail::VertexSlot *slot) noexcept {
+    slot->vertex()->~Vertex();
+
+    auto &level = m_levels[slot->level];
+    if (--level.live == 0) {
+        // The whole depth is exhausted, give its memory back at once
+        level = Level{};
+    } else {
+        slot->nextFree = std::exchange(level.freeList, slot);
+    }
+
+    --m_live;
+    deleteIfUnused();
+}
+
+void VertexPool::deleteIfUnused() noexcept {
+    if (m_orphaned && m_live == 0) {
+        delete this;
+    }
+}
+
+std::size_t VertexPool::reservedBytes() const noexcept {
+    std::size_t slots = 0;
+    for (const auto &level : m_levels) {
+        auto slabSize = kMinSlabSize;
+        for (std::size_t i = 0; i < level.slabs.size(); ++i) {
+            slots += slabSize;
+            slabSize = std::min(2 * slabSize, kMaxSlabSize);
+        }
+    }
+    return slots * sizeof(detail::VertexSlot);
+}
@@ -5,6 +5,7 @@
 #include "fms/scheduler.hpp"
 
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
 #include "fms/cli/command_line.hpp"
 #include "fms/problem/flow_shop.hpp"
 #include "fms/problem/module.hpp"
@@ -56,7 +57,8 @@ problem::Instance Scheduler::loadFlowShopInstance(cli::CLIArgs &args,
     return instance;
 }
 
-std::pair<bool, std::vector<delay>> Scheduler::checkConsistency(const problem::Instance &flowshop) {
+std::pair<bool, std::vector<delay>> Scheduler::checkConsistency(const problem::Instance &flowshop,
+                                                                std::size_t nrThreads) {
     bool bounds = true; // consistent, unless found otherwise
     const cg::ConstraintGraph &dg = flowshop.getDelayGraph();
 
@@ -84,8 +86,12 @@ std::pair<bool, std::vector<delay>> Scheduler::checkConsistency(const problem::I
         }
     }
 
-    auto vec = algorithms::paths::initializeASAPST(dg);
-    auto result = algorithms::paths::computeASAPST(dg, vec);
+    const cg::CSRGraph csr(dg);
+    auto vec = algorithms::paths::initializeASAPST(csr);
+    auto result = nrThreads > 1
+                          ? algorithms::paths::computeASAPSTParallel(csr, vec, nrThreads)
+                          : algorithms::paths::computeASAPST(
+                                    csr, vec, {}, algorithms::paths::LongestPathEngine::TWO_PHASE);
 
     bounds = bounds && result.positiveCycle.empty();
     // earliest possible start times, given no interleavings;
@@ -111,8 +117,11 @@ Scheduler::runAlgorithm(problem::Instance &flowShopInstance,
         return {{solvers::forward::solve(flowShopInstance, args)}, std::move(data)};
     case cli::AlgorithmType::MDBHCS:
         return {solvers::ParetoHeuristic::solve(flowShopInstance, args), std::move(data)};
-    case cli::AlgorithmType::BRANCH_BOUND:
-        return {{solvers::branch_bound::solve(flowShopInstance, args)}, std::move(data)};
+    case cli::AlgorithmType::BRANCH_BOUND: {
+        auto [solution, tmpData] = solvers::branch_bound::solve(flowShopInstance, args);
+        data.update(tmpData);
+        return {{std::move(solution)}, std::move(data)};
+    }
     case cli::AlgorithmType::ANYTIME:
         return {{solvers::anytime::solve(flowShopInstance, args)}, std::move(data)};
     case cli::AlgorithmType::ITERATED_GREEDY:
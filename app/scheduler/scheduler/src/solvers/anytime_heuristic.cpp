@@ -29,7 +29,8 @@ PartialSolution solve(problem::Instance &problemInstance, const cli::CLIArgs &ar
         cg::exports::saveAsDot(dg, name);
     }
 
-    auto [result, ASAPST] = SolversUtils::checkSolutionAndOutputIfFails(problemInstance);
+    auto [result, ASAPST] =
+            SolversUtils::checkSolutionAndOutputIfFails(problemInstance, args.pathThreads);
     LOG(fmt::format("Number of vertices in the delay graph is {}", dg.getNumberOfVertices()));
 
     // We only support a single re-entrant machine in the system so choose the first one
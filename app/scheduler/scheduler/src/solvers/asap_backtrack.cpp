@@ -38,7 +38,7 @@ PartialSolution AsapBacktrack::solve(problem::Instance &problem, const cli::CLIA
     // solve the instance
     LOG("Computation of the schedule started");
 
-    auto ASAPST = SolversUtils::initProblemGraph(problem, IS_LOG_D());
+    auto ASAPST = SolversUtils::initProblemGraph(problem, IS_LOG_D(), args.pathThreads);
     auto dg = problem.getDelayGraph();
 
     // We only support a single re-entrant machine in the system so choose the first one
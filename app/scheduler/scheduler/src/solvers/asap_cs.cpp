@@ -44,7 +44,7 @@ PartialSolution ASAPCS::solve(problem::Instance &problem, const cli::CLIArgs &ar
     // solve the instance
     LOG("Computation of the schedule started");
 
-    auto ASAPST = SolversUtils::initProblemGraph(problem, IS_LOG_D());
+    auto ASAPST = SolversUtils::initProblemGraph(problem, IS_LOG_D(), args.pathThreads);
     auto dg = problem.getDelayGraph();
 
     // We only support a single re-entrant machine in the system so choose the first one
@@ -7,26 +7,169 @@
 #include "fms/cg/builder.hpp"
 #include "fms/cg/constraint_graph.hpp"
 #include "fms/cg/export_utilities.hpp"
+#include "fms/cg/graph_overlay.hpp"
 #include "fms/problem/flow_shop.hpp"
 #include "fms/problem/indices.hpp"
 #include "fms/problem/operation.hpp"
+#include "fms/solvers/branch_bound_tree.hpp"
 #include "fms/solvers/forward_heuristic.hpp"
 #include "fms/solvers/pareto_heuristic.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <iomanip> // std::setprecision
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <queue>
+#include <thread>
 
 namespace fms::solvers::branch_bound {
 
+namespace {
+
+/// @brief Weight that an edge has once it is added to @p dg , whose own edges take precedence
+delay effectiveWeight(const cg::ConstraintGraph &dg, const cg::Edge &e) {
+    const auto &src = dg.getVertex(e.src);
+    return src.hasOutgoingEdge(e.dst) ? src.getWeight(e.dst) : e.weight;
+}
+
+/// @brief Checks if the edges @p added imply the edge @p removed , directly or through one
+/// operation inserted between its vertices
+bool isImplied(const cg::ConstraintGraph &dg, const cg::Edge &removed, const cg::Edges &added) {
+    for (const auto &first : added) {
+        if (first.src != removed.src) {
+            continue;
+        }
+        const auto firstWeight = effectiveWeight(dg, first);
+        if (first.dst == removed.dst && firstWeight >= removed.weight) {
+            return true;
+        }
+        for (const auto &second : added) {
+            if (second.src == first.dst && second.dst == removed.dst
+                && firstWeight + effectiveWeight(dg, second) >= removed.weight) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Finds the edges of @p childEdges that are not in @p parentEdges
+ * @details The times of the child can only be computed from the ones of its parent if every
+ * constraint of the parent still holds in the child. The edges are compared by their vertices,
+ * so sequences that contain the same pair twice, which @ref forward::validateInterleaving
+ * resolves by their order, and maintenance operations, which add extra edges, are evaluated
+ * from scratch.
+ * @return The added edges, or nothing if the child must be evaluated from scratch
+ */
+std::optional<cg::Edges> findAddedEdges(const cg::ConstraintGraph &dg,
+                                        cg::Edges parentEdges,
+                                        cg::Edges childEdges) {
+    const auto byVertices = [](const cg::Edge &lhs, const cg::Edge &rhs) {
+        return std::tie(lhs.src, lhs.dst, lhs.weight) < std::tie(rhs.src, rhs.dst, rhs.weight);
+    };
+    const auto sameVertices = [](const cg::Edge &lhs, const cg::Edge &rhs) {
+        return lhs.src == rhs.src && lhs.dst == rhs.dst;
+    };
+
+    std::ranges::sort(parentEdges, byVertices);
+    std::ranges::sort(childEdges, byVertices);
+    if (std::ranges::adjacent_find(parentEdges, sameVertices) != parentEdges.end()
+        || std::ranges::adjacent_find(childEdges, sameVertices) != childEdges.end()) {
+        return std::nullopt;
+    }
+    if (std::ranges::any_of(childEdges, [&dg](const cg::Edge &e) {
+            return dg.getOperation(e.src).isMaintenance();
+        })) {
+        return std::nullopt;
+    }
+
+    cg::Edges added;
+    cg::Edges removed;
+    std::ranges::set_difference(childEdges, parentEdges, std::back_inserter(added), byVertices);
+    std::ranges::set_difference(parentEdges, childEdges, std::back_inserter(removed), byVertices);
+
+    for (const auto &e : removed) {
+        // The edges of the graph take precedence, so the parent did not use this one
+        if (dg.getVertex(e.src).hasOutgoingEdge(e.dst)) {
+            continue;
+        }
+        if (std::ranges::any_of(added, [&](const cg::Edge &a) { return sameVertices(a, e); })
+            || !isImplied(dg, e, added)) {
+            return std::nullopt;
+        }
+    }
+    return added;
+}
+
+} // namespace
+
 BranchBoundNode::BranchBoundNode(const problem::Instance &problem,
-                                 cg::ConstraintGraph &dg,
+                                 const cg::ConstraintGraph &dg,
+                                 const cg::CSRGraph &csr,
                                  const PartialSolution &solution,
                                  delay trivialLowerBound) :
     solution(solution) {
     this->solution.clearASAPST();
-    algorithms::paths::PathTimes ASAPST = getASAPST(problem, dg);
+    setBounds(problem, computeASAPST(problem, dg, csr), trivialLowerBound);
+}
+
+BranchBoundNode::BranchBoundNode(const problem::Instance &problem,
+                                 const cg::ConstraintGraph &dg,
+                                 const cg::CSRGraph &csr,
+                                 const BranchBoundNode &parent,
+                                 std::shared_ptr<const algorithms::paths::PathTimes> parentASAPST,
+                                 const PartialSolution &solution,
+                                 delay trivialLowerBound) :
+    solution(solution) {
+    this->solution.clearASAPST();
+
+    auto added = findAddedEdges(dg,
+                                parent.getSolution().getAllAndInferredEdges(problem),
+                                solution.getAllAndInferredEdges(problem));
+    if (added) {
+        this->parentASAPST = std::move(parentASAPST);
+        addedEdges = std::move(*added);
+
+        auto ASAPST = *this->parentASAPST;
+        touchedVertices = propagateAddedEdges(problem, dg, csr, ASAPST);
+        if (touchedVertices) {
+            setBounds(problem, ASAPST, trivialLowerBound);
+            return;
+        }
+    }
+
+    // The full computation reports the positive cycle of an infeasible child
+    setBounds(problem, computeASAPST(problem, dg, csr), trivialLowerBound);
+}
+
+BranchBoundNode::BranchBoundNode(const problem::Instance &problem,
+                                 PartialSolution solution,
+                                 delay lowerbound,
+                                 delay makespan,
+                                 std::shared_ptr<const algorithms::paths::PathTimes> parentASAPST,
+                                 cg::Edges addedEdges) :
+    solution(std::move(solution)),
+    lowerbound(lowerbound),
+    makespan(makespan),
+    lastInsertedOperation(
+            *this->solution.firstPossibleOp(problem.getReEntrantMachines().front())),
+    parentASAPST(std::move(parentASAPST)) {
+    this->solution.clearASAPST();
+    if (this->parentASAPST) {
+        this->addedEdges = std::move(addedEdges);
+    }
+}
+
+void BranchBoundNode::setBounds(const problem::Instance &problem,
+                                const algorithms::paths::PathTimes &ASAPST,
+                                delay trivialLowerBound) {
     auto reEntrantMachine = problem.getReEntrantMachines().front();
 
     lastInsertedOperation = *solution.firstPossibleOp(reEntrantMachine);
@@ -50,22 +193,65 @@ BranchBoundNode::BranchBoundNode(const problem::Instance &problem,
 }
 
 std::vector<delay> BranchBoundNode::getASAPST(const problem::Instance &problem,
-                                              cg::ConstraintGraph &dg) const {
-    std::vector<delay> ASAPST = algorithms::paths::initializeASAPST(dg);
+                                              const cg::ConstraintGraph &dg,
+                                              const cg::CSRGraph &csr) const {
+    if (parentASAPST) {
+        auto ASAPST = *parentASAPST;
+        if (propagateAddedEdges(problem, dg, csr, ASAPST)) {
+            return ASAPST;
+        }
+    }
+    return computeASAPST(problem, dg, csr);
+}
+
+std::optional<std::size_t>
+BranchBoundNode::propagateAddedEdges(const problem::Instance &problem,
+                                     const cg::ConstraintGraph &dg,
+                                     const cg::CSRGraph &csr,
+                                     algorithms::paths::PathTimes &ASAPST) const {
+    // The times of the parent are consistent with the edges that the node keeps from it
+    cg::GraphOverlay overlay(dg, csr);
+    for (const auto &e : solution.getAllAndInferredEdges(problem)) {
+        if (std::ranges::find(addedEdges, e) == addedEdges.end() && !overlay.hasEdge(e)) {
+            overlay.addEdges(e);
+        }
+    }
+
+    // The children are evaluated on the search threads, each one keeps its own buffers
+    thread_local algorithms::paths::IncrementalASAPScratch scratch;
+    const auto result =
+            algorithms::paths::computeIncrementalASAPST(overlay, addedEdges, ASAPST, scratch);
+    if (result.positiveCycle) {
+        return std::nullopt;
+    }
+    return result.touchedVertices;
+}
+
+std::vector<delay> BranchBoundNode::computeASAPST(const problem::Instance &problem,
+                                                  const cg::ConstraintGraph &dg,
+                                                  const cg::CSRGraph &csr) const {
+    std::vector<delay> ASAPST = algorithms::paths::initializeASAPST(csr);
     // determine the sequencing edges
     cg::Edges finalSequence = solution.getAllAndInferredEdges(problem);
 
-    // compute (over the whole window) the ASAPST for these sequencing edges
-    // assume it is feasible, otherwise this will take a very long time
-    algorithms::paths::LongestPathResult result = forward::validateInterleaving(
-            dg, problem, finalSequence, ASAPST, {}, dg.getVerticesC());
+    // compute (over the whole window) the ASAPST for these sequencing edges, an infeasible
+    // sequence stops as soon as its positive cycle is found
+    algorithms::paths::LongestPathResult result =
+            forward::validateInterleaving(dg,
+                                          csr,
+                                          problem,
+                                          finalSequence,
+                                          ASAPST,
+                                          {},
+                                          dg.getVerticesC(),
+                                          algorithms::paths::CycleReport::CYCLE);
     if (!result.positiveCycle.empty()) {
-        std::cout << "Detected infeasible edges: " << std::endl;
+        std::cout << "Detected positive cycle: " << std::endl;
         for (const auto &edge : result.positiveCycle) {
             LOG(fmt::format("-- {}\n", edge));
         }
 
-        cg::exports::saveAsDot(dg, "inconsistent.dot", finalSequence);
+        cg::exports::saveAsDot(dg, "inconsistent.dot", finalSequence, result.positiveCycle);
         std::cout << chosenSequencesToString(solution);
 
         throw FmsSchedulerException(
@@ -80,111 +266,135 @@ bool operator>(const BranchBoundNode &lhs, const BranchBoundNode &rhs) {
     return lhs.getLowerbound() > rhs.getLowerbound();
 }
 
-PartialSolution solve(problem::Instance &problemInstance, const cli::CLIArgs &args) {
-    // solve the instance
-    LOG("Started branch and bound");
-
-    // make a copy of the delaygraph
-    if (!problemInstance.isGraphInitialized()) {
-        problemInstance.updateDelayGraph(cg::Builder::FORPFSSPSD(problemInstance));
+namespace {
+
+constexpr auto kTerminationOptimal = "optimal";
+constexpr auto kTerminationTimeOut = "time-out";
+
+using Clock = std::chrono::steady_clock;
+
+/// @brief Counters of the nodes visited by a search, reported in the output JSON
+struct SearchStatistics {
+    /// Nodes whose children were created
+    std::uint64_t expanded = 0;
+    /// Nodes discarded because their lower bound is not below the best makespan
+    std::uint64_t pruned = 0;
+    /// Complete schedules that were evaluated
+    std::uint64_t complete = 0;
+    /// Nodes taken from the stack of another thread
+    std::uint64_t stolen = 0;
+    /// Children evaluated from the times of their parent, and total number of vertices that
+    /// changed in them
+    std::uint64_t incremental = 0;
+    std::uint64_t touchedVertices = 0;
+
+    void addChild(const BranchBoundNode &child) {
+        if (const auto touched = child.getTouchedVertices()) {
+            incremental++;
+            touchedVertices += *touched;
+        }
     }
-    auto dg = problemInstance.getDelayGraph();
 
-    if (args.verbose >= utils::LOGGER_LEVEL::DEBUG) {
-        cg::exports::saveAsTikz(problemInstance, dg, "input_graph.tex");
+    SearchStatistics &operator+=(const SearchStatistics &other) {
+        expanded += other.expanded;
+        pruned += other.pruned;
+        complete += other.complete;
+        stolen += other.stolen;
+        incremental += other.incremental;
+        touchedVertices += other.touchedVertices;
+        return *this;
     }
-
-    std::vector<delay> ASAPST = algorithms::paths::initializeASAPST(dg);
-    auto result = algorithms::paths::computeASAPST(dg, ASAPST);
-
-    // check wether the input graph is feasible or not
-    if (!result.positiveCycle.empty()) {
-        LOG_C("The input graph is infeasible. Aborting.");
-        throw FmsSchedulerException("The input graph is infeasible. Aborting.");
+};
+
+/**
+ * @brief Schedules the next operation of the re-entrant machine that is not yet in @p solution
+ * @return The children ranked from the least to the most likely optimal one, and whether they
+ * are complete schedules
+ */
+std::pair<std::vector<PartialSolution>, bool> branch(const cg::ConstraintGraph &dg,
+                                                     const cg::CSRGraph &csr,
+                                                     const problem::Instance &problem,
+                                                     const std::vector<unsigned int> &ops,
+                                                     const PartialSolution &solution) {
+    const auto reentrantMachine = problem.getReEntrantMachines().front();
+    for (std::size_t i = 0; i + 1 < problem.getNumberOfJobs(); i++) {
+        const auto jobId = problem.getJobAtOutputPosition(i);
+
+        // First operation is already included in the initial sequence
+        for (std::size_t opIdx = 1; opIdx < ops.size(); opIdx++) {
+            const auto firstPossibleOp = *solution.firstPossibleOp(reentrantMachine);
+            if (dg.isSource(firstPossibleOp) || jobId > firstPossibleOp.jobId) {
+                const auto &eligibleOperation = dg.getVertex({jobId, ops[opIdx], std::nullopt});
+                // if it was the (second-to-)last sheet to schedule (last second pass is already
+                // included) the children are complete
+                return {scheduleOneOperation(dg, csr, problem, solution, eligibleOperation),
+                        i + 2 == problem.getNumberOfJobs()};
+            }
+        }
     }
+    return {{}, false};
+}
 
-    LOG(std::string() + "Number of vertices in the delay graph is "
-        + std::to_string(dg.getNumberOfVertices()));
-
-    // find out which machine is the re-entrant machine
-    problem::MachineId reentrant_machine = problemInstance.getReEntrantMachines().front();
-    const std::vector<unsigned int> &ops = problemInstance.getOperationsMappedOnMachine().at(
-            reentrant_machine); // check how many operations are mapped
-
-    auto initial_sequence = forward::createInitialSequence(problemInstance, reentrant_machine);
-
-    auto trivialLowerBound = createTrivialCompletionLowerBound(problemInstance);
-
-    // best-first can be implemented by a priority_queue
-    //    std::priority_queue<BranchBoundNode, std::vector<BranchBoundNode>,
-    //    std::greater<BranchBoundNode>> open_nodes; // use a min-heap to retrieve the solution with
-    //    the smallest lower bound
-    // LIFO (depth-first)
-    std::vector<BranchBoundNode>
-            open_nodes; // use a 'stack' to continue with the last added node first
-    open_nodes.emplace_back(problemInstance,
-                            dg,
-                            PartialSolution({{reentrant_machine, initial_sequence}}, ASAPST),
-                            trivialLowerBound);
-
-    LOG_I("Using INITIAL SCHEDULING to get initial result");
-
-    // The Branch & Bound algorithm can be seeded by creating any initial schedule (e.g., the
-    // 'stupid schedule', a bhcs/md-bhcs result)
-    BranchBoundNode stupidScheduleNode(
-            createStupidSchedule(problemInstance, reentrant_machine, trivialLowerBound));
-    BranchBoundNode bhcsNode(
-            problemInstance, dg, forward::solve(problemInstance, args), trivialLowerBound);
-    LOG_C("Seed with BHCS completed with makespan of {}", bhcsNode.getMakespan());
-
-    // The Branch & Bound algorithm is seeded with the best result from the Pareto scheduler
-    cli::CLIArgs argss = args;
-    argss.maxPartialSolutions = 20;
-    std::vector<PartialSolution> solutions = ParetoHeuristic::solve(problemInstance, argss);
-    PartialSolution best = solutions.back();
-    for (const PartialSolution &sol : solutions) {
-        if (best.getMakespan() > sol.getMakespan()) {
-            best = sol;
-        }
+/// @brief Stops the search if scheduling an operation decreased the lower bound of @p parent
+void checkChildLowerBound(const BranchBoundNode &parent,
+                          const BranchBoundNode &child,
+                          problem::MachineId reentrantMachine) {
+    if (child.getLowerbound() >= parent.getLowerbound()) {
+        return;
     }
-    LOG_C("Seed with MD-BHCS completed with makespan of {}", best.getMakespan());
 
-    BranchBoundNode mdbhcsNode(problemInstance, dg, best, trivialLowerBound);
+    const auto &s = child.getSolution();
+    std::string edges1 = chosenSequencesToString(parent.getSolution());
+    std::string edges2 = chosenSequencesToString(s);
+
+    LOG_C("Lower bound decreased by inserting an operation!");
+    LOG_C("{} -> {}",
+          *(s.firstPossibleOp(reentrantMachine) - 1),
+          *s.firstPossibleOp(reentrantMachine));
+    LOG_I("original node: {}: {}", edges1, parent.getLowerbound());
+    LOG_I("new node: {}: {}", edges2, child.getLowerbound());
+
+    std::ofstream before("before_insertion.txt");
+    before << edges1;
+    before.close();
+    std::ofstream after("after_insertion.txt");
+    after << edges2;
+    after.close();
+
+    throw FmsSchedulerException("Lower bound decreased by making a scheduling decision! This "
+                                "cannot happen with a proper lower bound!");
+}
 
-    BranchBoundNode bestFoundNode = mdbhcsNode; // Choose which algorithm's result to seed with
-    if (bestFoundNode.getMakespan() > bhcsNode.getMakespan()) {
-        bestFoundNode = bhcsNode;
-    }
-    if (bestFoundNode.getMakespan() < open_nodes.back().getLowerbound()) {
-        LOG_C("{} is smaller than initial lowerbound {}",
-              bestFoundNode.getMakespan(),
-              open_nodes.back().getLowerbound());
-        throw FmsSchedulerException(
-                "Either the initial lowerbound or the initial solution is incorrect; found a "
-                "(valid?) solution that is lower than the initial lower bound");
-    }
-    LOG_C("Finished INITIAL SCHEDULING heuristic with makespan {}", bestFoundNode.getMakespan());
+/**
+ * @brief Search on the calling thread in the order of the node selection policy of @p tree
+ * @return Lower bound of the makespan when the search ended
+ */
+delay searchSequential(const problem::Instance &problemInstance,
+                       const cg::ConstraintGraph &dg,
+                       const cg::CSRGraph &csr,
+                       const cli::CLIArgs &args,
+                       delay trivialLowerBound,
+                       NodeTree &tree,
+                       BranchBoundNode &bestFoundNode,
+                       Clock::time_point &bestFoundTime,
+                       SearchStatistics &statistics) {
+    const auto reentrant_machine = problemInstance.getReEntrantMachines().front();
+    const std::vector<unsigned int> &ops =
+            problemInstance.getOperationsMappedOnMachine().at(reentrant_machine);
 
     auto start = utils::time::getCpuTime();
 
     delay previous_iteration_lowerbound = 0;
 
     unsigned int iteration = 0;
-    unsigned int retired = 0;
-    while (!open_nodes.empty()) {
-        delay lowerbound = bestFoundNode.getMakespan();
-        for (const BranchBoundNode &n : open_nodes) {
-            lowerbound = std::min(lowerbound, n.getLowerbound());
-        }
-
-        LOG_I("Open nodes: {}", open_nodes.size());
-        const BranchBoundNode node = open_nodes.back();
-        open_nodes.pop_back();
+    while (tree.openNodes() > 0) {
+        const delay lowerbound =
+                std::min(bestFoundNode.getMakespan(),
+                         tree.lowerBound().value_or(bestFoundNode.getMakespan()));
 
-        PartialSolution solution = node.getSolution();
-        // recompute the solution ASAPST every time to save a lot of memory (feasible sequences are
-        // cheap to compute anyway)
-        solution.setASAPST(node.getASAPST(problemInstance, dg));
+        LOG_I("Open nodes: {}", tree.openNodes());
+        const auto index = *tree.pop();
+        const BranchBoundNode node = tree.restore(index);
 
         // sanity check on the lowerbound values calculated. Exploring the solution space further
         // must only lead to stricter lowerbounds, never looser ones
@@ -207,8 +417,7 @@ PartialSolution solve(problem::Instance &problemInstance, const cli::CLIArgs &ar
         if (lowerbound >= bestFoundNode.getMakespan()) {
             // found an optimal solution, finish execution!
             LOG_C("Optimal solution found");
-            return {bestFoundNode.getSolution().getChosenSequencesPerMachine(),
-                    bestFoundNode.getASAPST(problemInstance, dg)};
+            return lowerbound;
         }
         if ((iteration % 800) == 0) {
             std::cout << std::setw(12) << "ITERATION" << std::setw(15) << "LOWERBOUND"
@@ -226,122 +435,469 @@ PartialSolution solve(problem::Instance &problemInstance, const cli::CLIArgs &ar
                       << bestFoundNode.getMakespan() << std::setw(12)
                       << (((double)bestFoundNode.getMakespan() - lowerbound) / (double)lowerbound)
                                  * 100
-                      << std::setw(12) << open_nodes.size() << std::setw(16) << retired
+                      << std::setw(12) << tree.openNodes() << std::setw(16) << statistics.pruned
                       << std::setw(18) << time_spent << std::setw(22) << time_spent / iteration
                       << std::endl;
 
             std::cout << std::setprecision(precision);
             if (time_spent > args.timeOut) {
                 LOG_C("Time limit exceeded");
-                return {bestFoundNode.getSolution().getChosenSequencesPerMachine(),
-                        bestFoundNode.getASAPST(problemInstance, dg)};
+                return lowerbound;
             }
         }
 
-        if (bestFoundNode.getASAPST(problemInstance, dg).at(dg.getVertices().back().id)
-            <= node.getLowerbound()) {
+        if (bestFoundNode.getMakespan() <= node.getLowerbound()) {
             // ignore this branch, as it can never become optimal
-            retired++;
+            statistics.pruned++;
+            tree.release(index);
             continue;
         }
 
-        bool scheduled_one_operation = false;
-        // schedule one eligible node
-        for (std::size_t i = 0; i < problemInstance.getNumberOfJobs() - 1; i++) {
-            if (scheduled_one_operation) {
-                break;
+        PartialSolution solution = node.getSolution();
+        // the tree only keeps the edges added to the parent to save a lot of memory, the times
+        // are rebuilt from the ones of the parent, which are shared by its children
+        const auto ASAPST = std::make_shared<const algorithms::paths::PathTimes>(
+                node.getASAPST(problemInstance, dg, csr));
+        solution.setASAPST(*ASAPST);
+
+        statistics.expanded++;
+        auto [newSolutions, complete] = branch(dg, csr, problemInstance, ops, solution);
+        if (complete) {
+            for (const auto &s : newSolutions) {
+                BranchBoundNode new_node(
+                        problemInstance, dg, csr, node, ASAPST, s, trivialLowerBound);
+                statistics.addChild(new_node);
+                statistics.complete++;
+                if (bestFoundNode.getMakespan() > new_node.getMakespan()) {
+                    LOG_W("Found a better solution {} is smaller than {} ",
+                          new_node.getMakespan(),
+                          bestFoundNode.getMakespan());
+
+                    bestFoundNode = new_node;
+                    bestFoundTime = Clock::now();
+                }
+            }
+        } else {
+            // add each of the feasible solutions to the open nodes
+            LOG_I("Adding {} nodes", newSolutions.size());
+            tree.setTimes(index, ASAPST);
+
+            // for the depth-first selection the order of insertion makes a big difference, the
+            // one that is more likely to be optimal should be evaluated earlier
+            for (PartialSolution &s : newSolutions) {
+                BranchBoundNode newNode(
+                        problemInstance, dg, csr, node, ASAPST, s, trivialLowerBound);
+                statistics.addChild(newNode);
+                checkChildLowerBound(node, newNode, reentrant_machine);
+
+                if (newNode.getLowerbound() < bestFoundNode.getMakespan()) {
+                    tree.addChild(index, solution, newNode);
+                } else {
+                    statistics.pruned++;
+                }
+            }
+        }
+        tree.release(index);
+    }
+
+    LOG_C("Optimal solution found (no more branches left to explore)");
+    return bestFoundNode.getMakespan();
+}
+
+/**
+ * @brief Depth-first search shared by several threads that steal work from each other
+ * @details Every thread owns a stack of open nodes. It expands the newest node of its stack, like
+ * the sequential search, and when its stack is empty it steals the oldest node of another thread,
+ * which is the root of the largest subtree left. The makespan of the best solution is an atomic
+ * so that the threads prune against the newest bound without locking. The number of nodes that
+ * are in a stack or being expanded is counted; a parent is only removed from it after its
+ * children were added, so it only becomes zero when the whole tree has been explored.
+ *
+ * The options are evaluated on overlays of the constraint graph, so all the threads share it.
+ */
+class WorkStealingSearch {
+public:
+    WorkStealingSearch(const problem::Instance &problem,
+                       const cg::ConstraintGraph &dg,
+                       const cg::CSRGraph &csr,
+                       const cli::CLIArgs &args,
+                       delay trivialLowerBound,
+                       BranchBoundNode bestFoundNode) :
+        m_problem(problem),
+        m_ops(problem.getOperationsMappedOnMachine().at(problem.getReEntrantMachines().front())),
+        m_timeOut(args.timeOut),
+        m_trivialLowerBound(trivialLowerBound),
+        m_workers(args.threads),
+        m_graph(dg),
+        m_csr(csr),
+        m_best(std::move(bestFoundNode)),
+        m_bestMakespan(m_best.getMakespan()) {}
+
+    /// @brief Explores the tree below @p root
+    /// @return Lower bound of the makespan when the search ended
+    delay run(BranchBoundNode root) {
+        m_start = Clock::now();
+        m_pending = 1;
+        m_workers.front().nodes.push_back(std::move(root));
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(m_workers.size() - 1);
+            for (std::size_t id = 1; id < m_workers.size(); ++id) {
+                threads.emplace_back([this, id]() { work(id); });
+            }
+            work(0);
+        }
+
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+
+        // The threads finish the node that they are expanding before stopping, so all the open
+        // nodes are in the stacks
+        delay lowerBound = m_best.getMakespan();
+        for (const auto &worker : m_workers) {
+            for (const auto &node : worker.nodes) {
+                lowerBound = std::min(lowerBound, node.getLowerbound());
             }
+        }
+        return lowerBound;
+    }
+
+    [[nodiscard]] const BranchBoundNode &best() const noexcept { return m_best; }
+
+    /// @brief Time at which the best solution was found, if it is not the initial one
+    [[nodiscard]] std::optional<Clock::time_point> bestTime() const noexcept { return m_bestTime; }
+
+    [[nodiscard]] SearchStatistics statistics() const {
+        SearchStatistics total;
+        for (const auto &worker : m_workers) {
+            total += worker.statistics;
+        }
+        return total;
+    }
 
-            const auto jobId = problemInstance.getJobAtOutputPosition(i);
-
-            bool first = true; // First operation is already included in the initial sequence
-            for (unsigned int op : ops) {
-                if (!first) {
-                    problem::JobId firstPossibleJob =
-                            solution.firstPossibleOp(reentrant_machine)->jobId;
-                    if (dg.isSource(*solution.firstPossibleOp(reentrant_machine))
-                        || jobId > firstPossibleJob) {
-                        // schedule the next operation
-                        const auto &eligibleOperation = dg.getVertex({jobId, op});
-                        auto newSolutions = scheduleOneOperation(
-                                dg, problemInstance, solution, eligibleOperation);
-
-                        if (i + 2
-                            == problemInstance
-                                       .getNumberOfJobs()) { // if it was the (second-to-)last sheet
-                                                             // to schedule (last second pass is
-                                                             // already included)
-                            for (const auto &s : newSolutions) {
-                                BranchBoundNode new_node(problemInstance, dg, s, trivialLowerBound);
-                                if (bestFoundNode.getMakespan() > new_node.getMakespan()) {
-                                    LOG_W("Found a better solution {} is smaller than {} ",
-                                          new_node.getMakespan(),
-                                          bestFoundNode.getMakespan());
-
-                                    bestFoundNode = new_node;
-                                }
-                            }
-                        } else {
-                            // add each of the feasible solutions to the heap of open nodes
-                            LOG_I("Adding {} nodes", newSolutions.size());
-
-                            // for the stack-based branch and bound the order of insertion makes a
-                            // big difference, the one that is more likely to be optimal should be
-                            // evaluated earlier
-                            for (PartialSolution &s : newSolutions) {
-                                BranchBoundNode newNode(problemInstance, dg, s, trivialLowerBound);
-                                std::string edges1 = chosenSequencesToString(solution);
-                                std::string edges2 = chosenSequencesToString(s);
-
-                                if (newNode.getLowerbound() < node.getLowerbound()) {
-                                    LOG_C("Lower bound decreased by inserting an operation!");
-                                    LOG_C("{} -> {}",
-                                          *(s.firstPossibleOp(reentrant_machine) - 1),
-                                          *s.firstPossibleOp(reentrant_machine));
-                                    LOG_I("original node: {}: {}", edges1, node.getLowerbound());
-                                    LOG_I("new node: {}: {}", edges2, newNode.getLowerbound());
-
-                                    std::ofstream before("before_insertion.txt");
-                                    before << edges1;
-                                    before.close();
-                                    std::ofstream after("after_insertion.txt");
-                                    after << edges2;
-                                    after.close();
-
-                                    throw FmsSchedulerException(
-                                            "Lower bound decreased by making a scheduling "
-                                            "decision! This cannot happen with a proper lower "
-                                            "bound!");
-                                }
-
-                                if (newNode.getLowerbound() < bestFoundNode.getMakespan()) {
-                                    open_nodes.push_back(newNode);
-                                } else {
-                                    retired++;
-                                }
-                            }
-                        }
-                        scheduled_one_operation = true;
-                        break; // Break out of the loop after scheduling the current operation,
-                               // continue with another Branch and Bound node
+    [[nodiscard]] std::vector<std::uint64_t> expandedPerThread() const {
+        std::vector<std::uint64_t> expanded;
+        expanded.reserve(m_workers.size());
+        for (const auto &worker : m_workers) {
+            expanded.push_back(worker.statistics.expanded);
+        }
+        return expanded;
+    }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<BranchBoundNode> nodes;
+        SearchStatistics statistics;
+    };
+
+    void work(std::size_t id) {
+        try {
+            while (!m_stop.load(std::memory_order_relaxed)) {
+                auto node = take(id);
+                if (!node) {
+                    if (m_pending.load(std::memory_order_acquire) == 0) {
+                        return;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                expand(id, *node);
+                m_pending.fetch_sub(1, std::memory_order_acq_rel);
+
+                if (Clock::now() - m_start > m_timeOut) {
+                    if (!m_stop.exchange(true)) {
+                        LOG_C("Time limit exceeded");
                     }
                 }
-                first = false;
             }
+        } catch (...) {
+            const std::scoped_lock lock(m_errorMutex);
+            if (!m_error) {
+                m_error = std::current_exception();
+            }
+            m_stop = true;
+        }
+    }
+
+    /// @brief Pops the newest node of the own stack, or steals the oldest node of another one
+    std::optional<BranchBoundNode> take(std::size_t id) {
+        auto &own = m_workers[id];
+        {
+            const std::scoped_lock lock(own.mutex);
+            if (!own.nodes.empty()) {
+                auto node = std::move(own.nodes.back());
+                own.nodes.pop_back();
+                return node;
+            }
+        }
+
+        for (std::size_t i = 1; i < m_workers.size(); ++i) {
+            auto &victim = m_workers[(id + i) % m_workers.size()];
+            const std::scoped_lock lock(victim.mutex);
+            if (!victim.nodes.empty()) {
+                auto node = std::move(victim.nodes.front());
+                victim.nodes.pop_front();
+                own.statistics.stolen++;
+                return node;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void expand(std::size_t id, const BranchBoundNode &node) {
+        auto &worker = m_workers[id];
+
+        if (node.getLowerbound() >= m_bestMakespan.load(std::memory_order_relaxed)) {
+            // ignore this branch, as it can never become optimal
+            worker.statistics.pruned++;
+            return;
+        }
+
+        PartialSolution solution = node.getSolution();
+        const auto ASAPST = std::make_shared<const algorithms::paths::PathTimes>(
+                node.getASAPST(m_problem, m_graph, m_csr));
+        solution.setASAPST(*ASAPST);
+
+        worker.statistics.expanded++;
+        auto [newSolutions, complete] = branch(m_graph, m_csr, m_problem, m_ops, solution);
+        if (complete) {
+            for (const auto &s : newSolutions) {
+                BranchBoundNode leaf(
+                        m_problem, m_graph, m_csr, node, ASAPST, s, m_trivialLowerBound);
+                worker.statistics.addChild(leaf);
+                worker.statistics.complete++;
+                offer(std::move(leaf));
+            }
+            return;
+        }
+
+        const auto reentrantMachine = m_problem.getReEntrantMachines().front();
+        std::vector<BranchBoundNode> children;
+        children.reserve(newSolutions.size());
+        for (const PartialSolution &s : newSolutions) {
+            BranchBoundNode newNode(
+                    m_problem, m_graph, m_csr, node, ASAPST, s, m_trivialLowerBound);
+            worker.statistics.addChild(newNode);
+            checkChildLowerBound(node, newNode, reentrantMachine);
+
+            if (newNode.getLowerbound() < m_bestMakespan.load(std::memory_order_relaxed)) {
+                children.push_back(std::move(newNode));
+            } else {
+                worker.statistics.pruned++;
+            }
+        }
+
+        // The children are counted before they can be stolen, and their parent is still counted
+        m_pending.fetch_add(children.size(), std::memory_order_acq_rel);
+        const std::scoped_lock lock(worker.mutex);
+        // the one that is more likely to be optimal is added last, so it is expanded first
+        std::move(children.begin(), children.end(), std::back_inserter(worker.nodes));
+    }
+
+    /// @brief Replaces the best solution by @p node if it has a smaller makespan
+    void offer(BranchBoundNode node) {
+        if (node.getMakespan() >= m_bestMakespan.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        const std::scoped_lock lock(m_bestMutex);
+        if (node.getMakespan() < m_best.getMakespan()) {
+            LOG_W("Found a better solution {} is smaller than {} ",
+                  node.getMakespan(),
+                  m_best.getMakespan());
+            m_bestMakespan.store(node.getMakespan(), std::memory_order_relaxed);
+            m_best = std::move(node);
+            m_bestTime = Clock::now();
+        }
+    }
+
+    const problem::Instance &m_problem;
+    const std::vector<unsigned int> &m_ops;
+    std::chrono::milliseconds m_timeOut;
+    delay m_trivialLowerBound;
+
+    std::vector<Worker> m_workers;
+    const cg::ConstraintGraph &m_graph;
+    const cg::CSRGraph &m_csr;
+
+    std::mutex m_bestMutex;
+    BranchBoundNode m_best;
+    std::optional<Clock::time_point> m_bestTime;
+    std::atomic<delay> m_bestMakespan;
+
+    Clock::time_point m_start;
+    std::atomic<std::size_t> m_pending{0};
+    std::atomic<bool> m_stop{false};
+
+    std::mutex m_errorMutex;
+    std::exception_ptr m_error;
+};
+
+} // namespace
+
+std::tuple<PartialSolution, nlohmann::json> solve(problem::Instance &problemInstance,
+                                                  const cli::CLIArgs &args) {
+    // solve the instance
+    LOG("Started branch and bound");
+
+    // make a copy of the delaygraph
+    if (!problemInstance.isGraphInitialized()) {
+        problemInstance.updateDelayGraph(cg::Builder::FORPFSSPSD(problemInstance));
+    }
+    auto dg = problemInstance.getDelayGraph();
+    // The graph does not change during the search, all the nodes traverse this snapshot of it
+    const cg::CSRGraph csr(dg);
+
+    if (args.verbose >= utils::LOGGER_LEVEL::DEBUG) {
+        cg::exports::saveAsTikz(problemInstance, dg, "input_graph.tex");
+    }
+
+    std::vector<delay> ASAPST = algorithms::paths::initializeASAPST(csr);
+    auto result = algorithms::paths::computeASAPST(csr, ASAPST);
+
+    // check wether the input graph is feasible or not
+    if (!result.positiveCycle.empty()) {
+        LOG_C("The input graph is infeasible. Aborting.");
+        throw FmsSchedulerException("The input graph is infeasible. Aborting.");
+    }
+
+    LOG(std::string() + "Number of vertices in the delay graph is "
+        + std::to_string(dg.getNumberOfVertices()));
+
+    // find out which machine is the re-entrant machine
+    problem::MachineId reentrant_machine = problemInstance.getReEntrantMachines().front();
+
+    auto initial_sequence = forward::createInitialSequence(problemInstance, reentrant_machine);
+
+    auto trivialLowerBound = createTrivialCompletionLowerBound(problemInstance);
+
+    BranchBoundNode root(problemInstance,
+                         dg,
+                         csr,
+                         PartialSolution({{reentrant_machine, initial_sequence}}, ASAPST),
+                         trivialLowerBound);
+
+    LOG_I("Using INITIAL SCHEDULING to get initial result");
+
+    // The Branch & Bound algorithm can be seeded by creating any initial schedule (e.g., the
+    // 'stupid schedule', a bhcs/md-bhcs result)
+    BranchBoundNode stupidScheduleNode(
+            createStupidSchedule(problemInstance, reentrant_machine, trivialLowerBound));
+    BranchBoundNode bhcsNode(
+            problemInstance, dg, csr, forward::solve(problemInstance, args), trivialLowerBound);
+    LOG_C("Seed with BHCS completed with makespan of {}", bhcsNode.getMakespan());
+
+    // The Branch & Bound algorithm is seeded with the best result from the Pareto scheduler
+    cli::CLIArgs argss = args;
+    argss.maxPartialSolutions = 20;
+    std::vector<PartialSolution> solutions = ParetoHeuristic::solve(problemInstance, argss);
+    PartialSolution best = solutions.back();
+    for (const PartialSolution &sol : solutions) {
+        if (best.getMakespan() > sol.getMakespan()) {
+            best = sol;
         }
     }
+    LOG_C("Seed with MD-BHCS completed with makespan of {}", best.getMakespan());
+
+    BranchBoundNode mdbhcsNode(problemInstance, dg, csr, best, trivialLowerBound);
+
+    BranchBoundNode bestFoundNode = mdbhcsNode; // Choose which algorithm's result to seed with
+    if (bestFoundNode.getMakespan() > bhcsNode.getMakespan()) {
+        bestFoundNode = bhcsNode;
+    }
+    if (bestFoundNode.getMakespan() < root.getLowerbound()) {
+        LOG_C("{} is smaller than initial lowerbound {}",
+              bestFoundNode.getMakespan(),
+              root.getLowerbound());
+        throw FmsSchedulerException(
+                "Either the initial lowerbound or the initial solution is incorrect; found a "
+                "(valid?) solution that is lower than the initial lower bound");
+    }
+    LOG_C("Finished INITIAL SCHEDULING heuristic with makespan {}", bestFoundNode.getMakespan());
+
+    const auto searchStart = Clock::now();
+    auto bestFoundTime = searchStart;
+    SearchStatistics statistics;
+    nlohmann::json data = {{"threads", std::max<std::uint32_t>(args.threads, 1)}};
+
+    delay lowerBound = 0;
+    if (args.threads <= 1) {
+        NodeTree tree(problemInstance,
+                      root,
+                      args.nodeSelection,
+                      std::size_t{args.nodeMemory} << 20U);
+        lowerBound = searchSequential(problemInstance,
+                                      dg,
+                                      csr,
+                                      args,
+                                      trivialLowerBound,
+                                      tree,
+                                      bestFoundNode,
+                                      bestFoundTime,
+                                      statistics);
+        data["nodeSelection"] = std::string{args.nodeSelection.shortName()};
+        data["nodeMemory"] = {{"budget", std::size_t{args.nodeMemory} << 20U},
+                              {"peakBytes", tree.peakBytes()},
+                              {"peakOpenNodes", tree.peakOpenNodes()},
+                              {"evictedTimes", tree.evictions()},
+                              {"dives", tree.dives()}};
+    } else {
+        if (args.nodeSelection != cli::NodeSelectionType::DEPTH
+            || args.nodeMemory != cli::CLIArgs{}.nodeMemory) {
+            throw FmsSchedulerException(
+                    fmt::format("The parallel branch and bound only explores depth-first without "
+                                "a memory budget, it does not support the '{}' node selection "
+                                "with {} MiB of node memory",
+                                args.nodeSelection.shortName(),
+                                args.nodeMemory));
+        }
+        WorkStealingSearch search(
+                problemInstance, dg, csr, args, trivialLowerBound, bestFoundNode);
+        lowerBound = search.run(std::move(root));
+        bestFoundNode = search.best();
+        bestFoundTime = search.bestTime().value_or(searchStart);
+        statistics = search.statistics();
+        data["expandedNodesPerThread"] = search.expandedPerThread();
+        LOG_C("Explored {} nodes with {} threads, {} of them stolen",
+              statistics.expanded,
+              args.threads,
+              statistics.stolen);
+    }
+    const auto searchEnd = Clock::now();
 
     if (IS_LOG_D()) {
         cg::exports::saveAsTikz(problemInstance, dg, "output_graph.tex");
     }
 
     std::ofstream stream(args.outputFile + ".lb");
-    stream << bestFoundNode.getMakespan();
+    stream << std::min(lowerBound, bestFoundNode.getMakespan());
     stream.close();
 
-    LOG_C("Optimal solution found (no more branches left to explore)");
-    return {bestFoundNode.getSolution().getChosenSequencesPerMachine(),
-            bestFoundNode.getASAPST(problemInstance, dg)};
+    const bool optimal = lowerBound >= bestFoundNode.getMakespan();
+    data["terminationReason"] = optimal ? kTerminationOptimal : kTerminationTimeOut;
+    data["lowerBound"] = std::min(lowerBound, bestFoundNode.getMakespan());
+    data["upperBound"] = bestFoundNode.getMakespan();
+    data["nodes"] = {{"expanded", statistics.expanded},
+                     {"pruned", statistics.pruned},
+                     {"complete", statistics.complete},
+                     {"stolen", statistics.stolen}};
+    data["nodeTimes"] = {
+            {"incrementalNodes", statistics.incremental},
+            {"touchedVertices", statistics.touchedVertices},
+            {"touchedVerticesPerNode",
+             statistics.touchedVertices / std::max<std::uint64_t>(statistics.incremental, 1)},
+            {"graphVertices", dg.getNumberOfVertices()}};
+    // Wall clock time since the end of the seeding heuristics, in seconds
+    data["bestSolutionTime"] = std::chrono::duration<float>(bestFoundTime - searchStart).count();
+    data["searchTime"] = std::chrono::duration<float>(searchEnd - searchStart).count();
+
+    return {PartialSolution{bestFoundNode.getSolution().getChosenSequencesPerMachine(),
+                            bestFoundNode.getASAPST(problemInstance, dg, csr)},
+            std::move(data)};
 }
 
 delay createTrivialCompletionLowerBound(const problem::Instance &problem) {
@@ -385,7 +941,7 @@ delay createTrivialCompletionLowerBound(const problem::Instance &problem) {
 }
 
 std::vector<PartialSolution>
-ranked(cg::ConstraintGraph &dg,
+ranked(const cg::ConstraintGraph &dg,
        const problem::Instance &problemInstance,
        const std::vector<std::pair<PartialSolution, SchedulingOption>> &generationOfSolutions,
        const std::vector<delay> &ASAPTimes) {
@@ -507,7 +1063,8 @@ BranchBoundNode createStupidSchedule(const problem::Instance &problem,
     const auto firstPass = problem.getOperationsMappedOnMachine().at(reentrant_machine).at(0);
     const auto secondPass = problem.getOperationsMappedOnMachine().at(reentrant_machine).at(1);
 
-    auto dg = problem.getDelayGraph();
+    const auto &dg = problem.getDelayGraph();
+    const cg::CSRGraph csr(dg);
 
     // Do STUPID SCHEDULING: i.e. one product at a time in the re-entrant loop
     // for each except the last job
@@ -519,13 +1076,15 @@ BranchBoundNode createStupidSchedule(const problem::Instance &problem,
 
     return BranchBoundNode(problem,
                            dg,
+                           csr,
                            PartialSolution({{reEntrantMachine, stupidSequence}},
                                            {},
                                            {{reEntrantMachine, stupidSequence.size() - 1}}),
                            trivialLowerBound);
 }
 
-std::vector<PartialSolution> scheduleOneOperation(cg::ConstraintGraph &dg,
+std::vector<PartialSolution> scheduleOneOperation(const cg::ConstraintGraph &dg,
+                                                  const cg::CSRGraph &csr,
                                                   const problem::Instance &problem,
                                                   const PartialSolution &solution,
                                                   const cg::Vertex &eligibleOperation) {
@@ -542,7 +1101,7 @@ std::vector<PartialSolution> scheduleOneOperation(cg::ConstraintGraph &dg,
     const auto job_start = eligibleOperation.operation.jobId;
     std::vector<delay> ASAPTimes = solution.getASAPST();
     algorithms::paths::computeASAPST(
-            dg,
+            csr,
             ASAPTimes,
             dg.getVerticesC(std::max(job_start, problem::JobId(1)) - 1),
             dg.getVerticesC(job_start, last_potentially_feasible_option.jobId));
@@ -557,7 +1116,7 @@ std::vector<PartialSolution> scheduleOneOperation(cg::ConstraintGraph &dg,
 
     std::vector<std::pair<PartialSolution, SchedulingOption>> newGenerationOfSolutions =
             forward::evaluateOptionFeasibility(
-                    dg, problem, solution, options, ASAPTimes, reEntrantMachine);
+                    dg, csr, problem, solution, options, ASAPTimes, reEntrantMachine);
     if (newGenerationOfSolutions.empty()) {
         throw FmsSchedulerException("No feasible options; not possible for Canon case!");
     }
@@ -0,0 +1,282 @@
+#include "fms/pch/containers.hpp"
+#include "fms/pch/utils.hpp"
+
+#include "fms/solvers/branch_bound_tree.hpp"
+
+#include "fms/scheduler_exception.hpp"
+
+#include <algorithm>
+
+using namespace fms;
+using namespace fms::solvers;
+using namespace fms::solvers::branch_bound;
+
+NodeTree::NodeTree(const problem::Instance &problem,
+                   const BranchBoundNode &root,
+                   cli::NodeSelectionType selection,
+                   std::size_t budget) :
+    m_problem(problem),
+    m_machine(problem.getReEntrantMachines().front()),
+    m_root(root.getSolution()),
+    m_selection(selection),
+    m_budget(budget),
+    m_diving(selection == cli::NodeSelectionType::HYBRID),
+    // The first dive starts at the root
+    m_childrenSinceLastPop(1),
+    m_dives(m_diving ? 1 : 0) {
+    const auto &sequence = m_root.getMachineSequence(m_machine);
+    const auto firstFeasible = m_root.firstPossibleOp(m_machine) - sequence.begin();
+    add(Record{.parent = kNoParent,
+               .order = 0,
+               .operation = {},
+               .position = 0,
+               .firstFeasible = static_cast<std::uint32_t>(firstFeasible),
+               .depth = 0,
+               .references = 1,
+               .lowerbound = root.getLowerbound(),
+               .makespan = root.getMakespan(),
+               .open = true,
+               .incremental = false,
+               .addedEdges = {},
+               .times = nullptr});
+}
+
+NodeTree::Index NodeTree::add(Record record) {
+    record.order = m_order++;
+    m_edgeBytes += record.addedEdges.capacity() * sizeof(cg::Edge);
+
+    Index index = m_records.size();
+    if (m_free.empty()) {
+        m_records.push_back(std::move(record));
+    } else {
+        index = m_free.back();
+        m_free.pop_back();
+        m_records[index] = std::move(record);
+    }
+
+    const auto &r = m_records[index];
+    const OpenEntry entry{r.lowerbound, r.depth, r.order, index};
+    if (m_selection != cli::NodeSelectionType::BEST) {
+        m_newest.push_back(entry);
+    }
+    if (m_selection != cli::NodeSelectionType::DEPTH) {
+        m_best.push_back(entry);
+        std::push_heap(m_best.begin(), m_best.end());
+    }
+    m_openBounds[r.lowerbound]++;
+    m_open++;
+    m_peakOpen = std::max(m_peakOpen, m_open);
+    updatePeak();
+    return index;
+}
+
+std::optional<NodeTree::Index> NodeTree::pop() {
+    evictTimes();
+
+    if (m_selection == cli::NodeSelectionType::HYBRID) {
+        if (bytes() > m_budget) {
+            // Diving completes the newest subtree, which bounds the number of open nodes
+            if (!m_diving) {
+                m_dives++;
+            }
+            m_diving = true;
+        } else if (m_diving && m_childrenSinceLastPop == 0) {
+            // The dive reached a complete schedule or all its children were pruned
+            m_diving = false;
+        }
+    }
+    m_childrenSinceLastPop = 0;
+
+    const bool newest = m_selection == cli::NodeSelectionType::DEPTH
+                        || (m_selection == cli::NodeSelectionType::HYBRID && m_diving);
+    const auto index = newest ? popNewest() : popBest();
+    if (!index) {
+        return std::nullopt;
+    }
+
+    auto &record = m_records[*index];
+    record.open = false;
+    if (auto it = m_openBounds.find(record.lowerbound); --it->second == 0) {
+        m_openBounds.erase(it);
+    }
+    m_open--;
+    compactOpenLists();
+    return index;
+}
+
+bool NodeTree::isOpen(const OpenEntry &entry) const {
+    const auto &record = m_records[entry.index];
+    return record.open && record.order == entry.order;
+}
+
+std::optional<NodeTree::Index> NodeTree::popNewest() {
+    // The entries of the nodes taken best-first are only removed here
+    while (!m_newest.empty()) {
+        const auto entry = m_newest.back();
+        m_newest.pop_back();
+        if (isOpen(entry)) {
+            return entry.index;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<NodeTree::Index> NodeTree::popBest() {
+    while (!m_best.empty()) {
+        std::pop_heap(m_best.begin(), m_best.end());
+        const auto entry = m_best.back();
+        m_best.pop_back();
+        if (isOpen(entry)) {
+            return entry.index;
+        }
+    }
+    return std::nullopt;
+}
+
+void NodeTree::compactOpenLists() {
+    // With the hybrid selection a node taken from one list stays in the other one
+    const auto isClosed = [this](const OpenEntry &entry) { return !isOpen(entry); };
+    if (m_newest.size() > 2 * m_open) {
+        std::erase_if(m_newest, isClosed);
+    }
+    if (m_best.size() > 2 * m_open) {
+        std::erase_if(m_best, isClosed);
+        std::make_heap(m_best.begin(), m_best.end());
+    }
+}
+
+BranchBoundNode NodeTree::restore(Index index) const {
+    std::vector<Index> path;
+    for (auto i = index; m_records[i].parent != kNoParent; i = m_records[i].parent) {
+        path.push_back(i);
+    }
+
+    auto sequence = m_root.getMachineSequence(m_machine);
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        const auto &record = m_records[*it];
+        const auto position = static_cast<PartialSolution::SequenceDiff>(record.position);
+        sequence.insert(sequence.begin() + position, record.operation);
+    }
+
+    const auto &record = m_records[index];
+    PartialSolution solution = m_root;
+    solution.setMachineSequence(m_machine, std::move(sequence));
+    solution.setFirstFeasibleEdge(m_machine, record.firstFeasible);
+
+    std::shared_ptr<const algorithms::paths::PathTimes> parentTimes;
+    if (record.incremental) {
+        parentTimes = m_records[record.parent].times;
+    }
+    return {m_problem,
+            std::move(solution),
+            record.lowerbound,
+            record.makespan,
+            std::move(parentTimes),
+            record.addedEdges};
+}
+
+void NodeTree::setTimes(Index index, std::shared_ptr<const algorithms::paths::PathTimes> times) {
+    auto &record = m_records[index];
+    dropTimes(record);
+    m_timeBytes += times->size() * sizeof(delay);
+    record.times = std::move(times);
+
+    while (!m_timesOrder.empty()) {
+        const auto [i, order] = m_timesOrder.front();
+        if (m_records[i].order == order && m_records[i].times) {
+            break;
+        }
+        m_timesOrder.pop_front();
+    }
+    m_timesOrder.emplace_back(index, record.order);
+    updatePeak();
+}
+
+void NodeTree::addChild(Index parent,
+                        const PartialSolution &parentSolution,
+                        const BranchBoundNode &child) {
+    const auto &before = parentSolution.getMachineSequence(m_machine);
+    const auto &after = child.getSolution().getMachineSequence(m_machine);
+    const auto [mismatch, _] = std::ranges::mismatch(before, after);
+    const auto position = mismatch - before.begin();
+    if (after.size() != before.size() + 1
+        || !std::equal(mismatch, before.end(), after.begin() + position + 1)) {
+        throw FmsSchedulerException(
+                "A child of a branch and bound node must insert one operation in the sequence "
+                "of its parent");
+    }
+    const auto firstFeasible = child.getSolution().firstPossibleOp(m_machine) - after.begin();
+
+    auto &record = m_records[parent];
+    record.references++;
+    m_childrenSinceLastPop++;
+
+    const bool incremental = child.getTouchedVertices().has_value() && record.times;
+    cg::Edges addedEdges;
+    if (incremental) {
+        addedEdges.assign(child.getAddedEdges().begin(), child.getAddedEdges().end());
+    }
+    add(Record{.parent = parent,
+               .order = 0,
+               .operation = after[position],
+               .position = static_cast<std::uint32_t>(position),
+               .firstFeasible = static_cast<std::uint32_t>(firstFeasible),
+               .depth = record.depth + 1,
+               .references = 1,
+               .lowerbound = child.getLowerbound(),
+               .makespan = child.getMakespan(),
+               .open = true,
+               .incremental = incremental,
+               .addedEdges = std::move(addedEdges),
+               .times = nullptr});
+}
+
+void NodeTree::release(Index index) {
+    while (index != kNoParent) {
+        auto &record = m_records[index];
+        if (--record.references > 0) {
+            return;
+        }
+
+        m_edgeBytes -= record.addedEdges.capacity() * sizeof(cg::Edge);
+        record.addedEdges = {};
+        dropTimes(record);
+        m_free.push_back(index);
+        index = record.parent;
+    }
+}
+
+std::optional<delay> NodeTree::lowerBound() const {
+    if (m_openBounds.empty()) {
+        return std::nullopt;
+    }
+    return m_openBounds.begin()->first;
+}
+
+std::size_t NodeTree::bytes() const noexcept {
+    return (m_records.size() - m_free.size()) * sizeof(Record) + m_edgeBytes + m_timeBytes
+           + (m_newest.size() + m_best.size()) * sizeof(OpenEntry)
+           + m_timesOrder.size() * sizeof(decltype(m_timesOrder)::value_type);
+}
+
+void NodeTree::evictTimes() {
+    while (bytes() > m_budget && !m_timesOrder.empty()) {
+        const auto [index, order] = m_timesOrder.front();
+        m_timesOrder.pop_front();
+
+        auto &record = m_records[index];
+        if (record.order == order && record.times) {
+            dropTimes(record);
+            m_evictions++;
+        }
+    }
+}
+
+void NodeTree::dropTimes(Record &record) {
+    if (record.times) {
+        m_timeBytes -= record.times->size() * sizeof(delay);
+        record.times.reset();
+    }
+}
+
+void NodeTree::updatePeak() { m_peakBytes = std::max(m_peakBytes, bytes()); }
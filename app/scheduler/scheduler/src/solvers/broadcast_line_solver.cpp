@@ -4,6 +4,8 @@
 
 #include "fms/algorithms/longest_path.hpp"
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
+#include "fms/cg/graph_overlay.hpp"
 #include "fms/delay.hpp"
 #include "fms/math/interval.hpp"
 #include "fms/problem/boundary.hpp"
@@ -94,36 +96,58 @@ void updateUpperBounds(problem::IntervalSpec &intervals,
     }
 }
 
+/// @brief Number of jobs whose longest paths are computed together by @ref computeAndAddBounds
+constexpr std::size_t kBoundsBlockSize = 8;
+
+/**
+ * @brief Computes the bounds of the jobs in [ @p firstJobIndex , @p lastJobIndex )
+ * @details The longest paths from all the jobs of the block are computed in one batch, then the
+ * bounds are added in the same order as if each job was computed on its own.
+ */
 template <VectorSideFunc side>
 void computeAndAddBounds(problem::IntervalSpec &bounds,
                          const problem::Module &problem,
-                         cg::ConstraintGraph &dg,
-                         const PartialSolution &solution,
-                         const size_t jobIndex,
+                         const cg::CSRGraph &dg,
+                         const cg::ExtraEdges &solutionEdges,
+                         const std::size_t firstJobIndex,
+                         const std::size_t lastJobIndex,
                          const bool upperBound = false) {
     const auto &jobsOut = problem.getJobsOutput();
 
     // Gets the first or last operation depending on Side()
-    const auto &opCurr = side(problem.jobs(jobsOut[jobIndex]));
-    const auto vertexCurr = dg.getVertexId(opCurr);
-    const bool isNotLast = jobIndex + 1 < jobsOut.size();
-    const bool isNotFirst = jobIndex > 0;
-
-    if (isNotFirst && !upperBound) {
-        // Upper bound is static only
-        const auto ASAPSTStatic = algorithms::paths::computeASAPSTFromNode(dg, vertexCurr);
-        updateUpperBounds<side>(bounds, vertexCurr, jobIndex, problem, ASAPSTStatic);
+    cg::VerticesIds vertices;
+    vertices.reserve(lastJobIndex - firstJobIndex);
+    for (std::size_t jobIndex = firstJobIndex; jobIndex < lastJobIndex; ++jobIndex) {
+        const auto &opCurr = side(problem.jobs(jobsOut[jobIndex]));
+        vertices.push_back(problem.getDelayGraph().getVertexId(opCurr));
     }
 
-    if (isNotLast || upperBound) {
-        const auto edges = solution.getAllChosenEdges(problem);
-        const auto ASAPST = algorithms::paths::computeASAPSTFromNode(dg, vertexCurr, edges);
-        if (isNotLast) {
-            updateLowerBounds<side>(bounds, vertexCurr, jobIndex, problem, ASAPST);
+    // Upper bound is static only
+    const auto ASAPSTStatic = upperBound
+                                      ? algorithms::paths::MultiSourcePathTimes{}
+                                      : algorithms::paths::computeASAPSTFromNodes(dg, vertices);
+    const auto ASAPST = algorithms::paths::computeASAPSTFromNodes(dg, vertices, solutionEdges);
+
+    for (std::size_t jobIndex = firstJobIndex; jobIndex < lastJobIndex; ++jobIndex) {
+        const auto lane = jobIndex - firstJobIndex;
+        const auto vertexCurr = vertices[lane];
+        const bool isNotLast = jobIndex + 1 < jobsOut.size();
+        const bool isNotFirst = jobIndex > 0;
+
+        if (isNotFirst && !upperBound) {
+            updateUpperBounds<side>(
+                    bounds, vertexCurr, jobIndex, problem, ASAPSTStatic.getSource(lane));
         }
 
-        if (upperBound && isNotFirst) {
-            updateUpperBounds<side>(bounds, vertexCurr, jobIndex, problem, ASAPST);
+        if (isNotLast || upperBound) {
+            const auto ASAPSTJob = ASAPST.getSource(lane);
+            if (isNotLast) {
+                updateLowerBounds<side>(bounds, vertexCurr, jobIndex, problem, ASAPSTJob);
+            }
+
+            if (upperBound && isNotFirst) {
+                updateUpperBounds<side>(bounds, vertexCurr, jobIndex, problem, ASAPSTJob);
+            }
         }
     }
 }
@@ -164,6 +188,14 @@ BroadcastLineSolver::solve(problem::ProductionLine &problem, const cli::CLIArgs
                         Scheduler::runAlgorithm(problem, m, args, iterations);
                 history.addAlgorithmData(moduleId, std::move(algorithmData));
 
+                // e.g. a width-bounded DD that only reports bounds
+                if (result.empty()) {
+                    LOG_E("Broadcast: The algorithm found no solution for module {}", moduleId);
+                    auto resultData = baseResultData(history, problem, iterations);
+                    resultData["error"] = ErrorStrings::kNoLocalSolution;
+                    return {ProductionLineSolutions{}, std::move(resultData)};
+                }
+
                 auto bounds = getBounds(m, result.front(), upperBound);
 
                 if (argsMod.selfBounds) {
@@ -189,7 +221,8 @@ BroadcastLineSolver::solve(problem::ProductionLine &problem, const cli::CLIArgs
         ++iterations;
 
         if (converged && upperBound) {
-            return {ProductionLineSolutions{mergeSolutions(problem, moduleResults)},
+            return {ProductionLineSolutions{
+                            mergeSolutions(problem, moduleResults, args.pathThreads)},
                     baseResultData(history, problem, iterations)};
         }
     }
@@ -209,15 +242,22 @@ problem::ModuleBounds BroadcastLineSolver::getBounds(const problem::Module &prob
                                                      const bool upperBound,
                                                      const BoundsSide intervalSide) {
     problem::ModuleBounds result;
-    auto dg = problem.getDelayGraph(); // Copy delay graph because we are going to modify it
-    // Find the bounds for each job
-    for (size_t i = 0; i < problem.getJobsOutput().size(); ++i) {
+    // All the bounds are computed on the same graph and sequence so both are frozen once
+    const cg::CSRGraph dg(problem.getDelayGraph());
+    const cg::ExtraEdges solutionEdges(dg, solution.getAllChosenEdges(problem));
+
+    // Find the bounds for each job, the longest paths are computed by blocks of jobs
+    const auto nrJobs = problem.getJobsOutput().size();
+    for (std::size_t first = 0; first < nrJobs; first += kBoundsBlockSize) {
+        const auto last = std::min(first + kBoundsBlockSize, nrJobs);
         if (intervalSide == BoundsSide::INPUT || intervalSide == BoundsSide::BOTH) {
-            computeAndAddBounds<front>(result.in, problem, dg, solution, i, upperBound);
+            computeAndAddBounds<front>(
+                    result.in, problem, dg, solutionEdges, first, last, upperBound);
         }
 
         if (intervalSide == BoundsSide::OUTPUT || intervalSide == BoundsSide::BOTH) {
-            computeAndAddBounds<back>(result.out, problem, dg, solution, i, upperBound);
+            computeAndAddBounds<back>(
+                    result.out, problem, dg, solutionEdges, first, last, upperBound);
         }
     }
 
@@ -268,7 +308,8 @@ void BroadcastLineSolver::propagateIntervals(problem::ProductionLine &problem,
 }
 
 ProductionLineSolution BroadcastLineSolver::mergeSolutions(const problem::ProductionLine &problem,
-                                                           ModulesSolutions &modulesSolutions) {
+                                                           ModulesSolutions &modulesSolutions,
+                                                           std::size_t nrThreads) {
     ModulesSolutions result;
     const auto &modulesIds = problem.moduleIds();
     result.reserve(modulesIds.size());
@@ -297,8 +338,10 @@ ProductionLineSolution BroadcastLineSolver::mergeSolutions(const problem::Produc
         }
 
         // Check for positive cycles with the new ASAPST
-        const auto edgesSequence = solution.getAllChosenEdges(module);
-        const auto pathResult = algorithms::paths::computeASAPST(dg, ASAPST, edgesSequence);
+        cg::GraphOverlay overlay(dg);
+        overlay.addEdges(solution.getAllChosenEdges(module));
+        const auto pathResult =
+                algorithms::paths::computeASAPSTParallel(overlay, ASAPST, nrThreads);
 
         if (!pathResult.positiveCycle.empty()) {
             throw FmsSchedulerException(
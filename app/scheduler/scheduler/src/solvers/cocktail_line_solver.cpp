@@ -52,6 +52,12 @@ SingleIterationResult singleIteration(problem::ProductionLine &instance,
                     Scheduler::runAlgorithm(instance, module, args, 2 * iterations);
             history.addAlgorithmData(moduleId, std::move(algorithmData));
 
+            // e.g. a width-bounded DD that only reports bounds
+            if (result.empty()) {
+                LOG_E("Cocktail: The algorithm found no solution for module {}", currentModuleId);
+                return {{}, false, BroadcastLineSolver::ErrorStrings::kNoLocalSolution};
+            }
+
             auto &modResult = result.front();
 
             bounds = BroadcastLineSolver::getBounds(module, modResult, upperBound, side);
@@ -103,6 +109,10 @@ SingleIterationResult singleIteration(problem::ProductionLine &instance,
             auto [result, algorithmData] =
                     Scheduler::runAlgorithm(instance, module, args, 2 * iterations + 1);
             history.addAlgorithmData(moduleId, std::move(algorithmData));
+            if (result.empty()) {
+                LOG_E("Cocktail: The algorithm found no solution for module {}", currentModuleId);
+                return {{}, false, BroadcastLineSolver::ErrorStrings::kNoLocalSolution};
+            }
             auto &modResult = result.front();
 
             // We use both sides because one side is used for propagation and the other for
@@ -172,7 +182,8 @@ solve(problem::ProductionLine &problemInstance, const cli::CLIArgs &args) {
         ++iterations;
 
         if (converged && convergedLowerBound) {
-            return {{BroadcastLineSolver::mergeSolutions(problemInstance, moduleResults)},
+            return {{BroadcastLineSolver::mergeSolutions(
+                             problemInstance, moduleResults, args.pathThreads)},
                     BroadcastLineSolver::baseResultData(history, problemInstance, iterations)};
         }
 
@@ -41,7 +41,8 @@ solve(problem::ProductionLine &problemInstance, const cli::CLIArgs &args) {
         }
 
         if (converged && convergedLowerBound) {
-            return {{BroadcastLineSolver::mergeSolutions(problemInstance, moduleResults)},
+            return {{BroadcastLineSolver::mergeSolutions(
+                             problemInstance, moduleResults, args.pathThreads)},
                     BroadcastLineSolver::baseResultData(history, problemInstance, iterations)};
         }
 
@@ -3,6 +3,7 @@
 #include "fms/pch/fmt.hpp"
 
 #include "fms/solvers/dd.hpp"
+#include "fms/solvers/dd_checkpoint.hpp"
 
 #include "fms/cg/builder.hpp"
 #include "fms/cg/constraint_graph.hpp"
@@ -14,34 +15,166 @@
 #include "fms/problem/indices.hpp"
 #include "fms/solvers/sequence.hpp"
 #include "fms/solvers/utils.hpp"
+#include "fms/utils/task_workers.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 
 static constexpr float kDefaultRankFactor = 0.8;
 
+/// States popped per thread when expanding in parallel. More than one lets the threads balance
+/// states with different numbers of ready jobs.
+static constexpr std::size_t kBatchStatesPerThread = 2;
+
 namespace {
 
 void updateBounds(fms::solvers::dd::DDSolverData &data) {
-    const auto &states = data.states;
-    const auto bestLowerBoundElement =
-            std::min_element(states.begin(), states.end(), fms::dd::CompareVerticesLowerBoundMin());
-    auto minLowerBound = bestLowerBoundElement == states.end()
-                                 ? data.solution.bestUpperBound()
-                                 : std::min((*bestLowerBoundElement)->lowerBound(),
-                                            data.solution.bestUpperBound());
+    auto minLowerBound = std::min(data.discardedLowerBound, data.solution.bestUpperBound());
+    if (!data.states.empty()) {
+        minLowerBound = std::min(data.states.minLowerBound(), minLowerBound);
+    }
     fms::LOG_D("Lower is {} and upper is {}", minLowerBound, data.solution.bestUpperBound());
     data.solution.setBestLowerBound(minLowerBound);
 }
 
+/// @brief Average memory used by the states left in the queue. Times shared by several states
+/// (including the ones of already expanded states) are only counted once.
+nlohmann::json getStateMemory(const fms::solvers::dd::DDSolverData &data) {
+    std::size_t verticesBytes = 0;
+    std::size_t timesBytes = 0;
+    std::unordered_set<const fms::dd::StateTimes *> counted;
+    data.states.forEach([&](const fms::dd::SharedVertex &state) {
+        verticesBytes += state->memoryUsage();
+        for (const auto *times = state->getTimes().get();
+             times != nullptr && counted.insert(times).second;
+             times = times->parent().get()) {
+            timesBytes += times->memoryUsage();
+        }
+    });
+
+    const auto nrStates = std::max<std::size_t>(data.states.size(), 1);
+    return {{"openStates", data.states.size()},
+            {"bytesPerState", (verticesBytes + timesBytes) / nrStates},
+            {"timesBytesPerState", timesBytes / nrStates},
+            {"fullTimesBytes", 2 * data.dg.getNumberOfVertices() * sizeof(fms::delay)},
+            {"poolLiveStates", data.pool->liveVertices()},
+            {"poolReservedBytes", data.pool->reservedBytes()}};
+}
+
+/**
+ * @brief Pops up to @p maxStates states and expands them in parallel
+ * @details Only the times of the children are computed by the threads. The vertices, the
+ * dominance checks and the queue are handled by the calling thread in the order in which the
+ * states were popped, so the search does not depend on the scheduling of the threads. The bounds
+ * only change here, between two batches, so the threads never see them change.
+ * @return Number of popped states
+ */
+std::size_t batchIteration(fms::solvers::dd::DDSolverData &data,
+                           const fms::problem::Instance &problemInstance,
+                           fms::utils::TaskWorkers &workers,
+                           std::size_t maxStates) {
+    using namespace fms::solvers::dd;
+
+    std::size_t popped = 0;
+    std::vector<SharedVertex> batch;
+    while (popped < maxStates && !data.states.empty() && !data.solution.isOptimal()) {
+        if (isLayerDone(data)) {
+            // The children of the batch belong to the next layer, which must be complete first
+            if (popped > 0) {
+                break;
+            }
+            startLayer(data, problemInstance);
+        }
+
+        auto s = pop(data);
+        ++popped;
+
+        // The vertex becomes inactive after expansion so we remove it
+        if (data.keepActiveVerticesSparse) {
+            removeActiveVertex(data.activeVertices, *s);
+        }
+
+        if (isTerminal(*s, problemInstance)) {
+            addTerminal(data, *s);
+            continue;
+        }
+        if (data.isTransposition(s, problemInstance)) {
+            continue;
+        }
+        batch.push_back(std::move(s));
+    }
+
+    // The handles are not shared with the threads, only the vertices they point to
+    std::vector<const Vertex *> states;
+    states.reserve(batch.size());
+    for (const auto &s : batch) {
+        states.push_back(s.get());
+    }
+
+    std::vector<std::vector<Expansion>> expansions(batch.size());
+    workers.run(states.size(), [&](std::size_t i) {
+        fms::cg::GraphOverlay stateGraph(data.dg, data.csr);
+        stateGraph.addEdges(states[i]->getAllEdges(problemInstance));
+        expansions[i] = computeExpansions(data.dg, stateGraph, *states[i], problemInstance);
+    });
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        addChildren(data, *batch[i], std::move(expansions[i]), problemInstance);
+    }
+
+    ::updateBounds(data);
+    fms::LOG_D("Queue is {} elements long", data.states.size());
+    return popped;
+}
+
+/// @brief Saves the search every checkpoint interval of the arguments, if a checkpoint file is
+/// given
+/// @details The interval is measured in wall-clock time: the CPU time of the process grows with
+/// the number of DD threads and stalls while the process waits.
+class CheckpointTimer {
+public:
+    explicit CheckpointTimer(const fms::cli::CLIArgs &args) :
+        m_args(args), m_next(std::chrono::steady_clock::now() + args.checkpointInterval) {}
+
+    void update(const fms::solvers::dd::DDSolverData &data,
+                const fms::problem::Instance &problemInstance) {
+        if (m_args.checkpointFile.empty() || m_args.checkpointInterval.count() <= 0
+            || std::chrono::steady_clock::now() < m_next) {
+            return;
+        }
+        fms::solvers::dd::saveCheckpoint(data, problemInstance, m_args.checkpointFile);
+        m_next = std::chrono::steady_clock::now() + m_args.checkpointInterval;
+    }
+
+private:
+    const fms::cli::CLIArgs &m_args;
+    std::chrono::steady_clock::time_point m_next;
+};
+
 } // namespace
 
 namespace fms::solvers::dd {
 
-void DDSolverData::storeState(const SharedVertex &newVertex) {
+void DDSolverData::storeState(const SharedVertex &newVertex, StateFate fate) {
     if (storeAllStates) {
         allStates.push_back(newVertex);
     }
+    if (history) {
+        history->write(HistoryRecord::create(*newVertex, dg, fate));
+    }
+}
+
+bool DDSolverData::isTransposition(const SharedVertex &state,
+                                   const problem::Instance &problemInstance) {
+    if (!transpositions) {
+        return false;
+    }
+    if (transpositions->isDominated(*state, problemInstance)) {
+        return true;
+    }
+    transpositions->insert(state, problemInstance);
+    return false;
 }
 
 /* Input: Problem instance and command line arguments.
@@ -51,6 +184,9 @@ void DDSolverData::storeState(const SharedVertex &newVertex) {
  */
 std::tuple<Solutions, nlohmann::json> solve(problem::Instance &problemInstance,
                                             const cli::CLIArgs &args) {
+    // A width-bounded diagram may end without any solution, e.g. a relaxed one whose terminal
+    // states all come from a merge. Its bounds are still in the data and the callers check for
+    // the empty result.
     auto [solutions, dataJSON, _] = solveWrap(problemInstance, args, nullptr);
     return {std::move(solutions), std::move(dataJSON)};
 }
@@ -69,6 +205,9 @@ initialize(const cli::CLIArgs &args, problem::Instance &instance, DDSolverDataPt
     if (dataOld != nullptr) {
         return std::move(dataOld);
     }
+    if (!args.resumeFile.empty()) {
+        return loadCheckpoint(args.resumeFile, args, instance);
+    }
 
     bool storeAllStates = false;
     for (const auto &arg : args.algorithmOptions) {
@@ -77,7 +216,8 @@ initialize(const cli::CLIArgs &args, problem::Instance &instance, DDSolverDataPt
         }
     }
 
-    DDSolution solution(utils::time::getCpuTime(), kDefaultRankFactor, instance.getTotalOps());
+    DDSolution solution(
+            std::chrono::steady_clock::now(), kDefaultRankFactor, instance.getTotalOps());
 
     // Generate the base graph
     auto dg = cg::Builder::jobShop(instance);
@@ -88,7 +228,7 @@ initialize(const cli::CLIArgs &args, problem::Instance &instance, DDSolverDataPt
         cg::exports::saveAsDot(dg, name);
     }
 
-    auto [result, ASAPST] = SolversUtils::checkSolutionAndOutputIfFails(instance);
+    auto [result, ASAPST] = SolversUtils::checkSolutionAndOutputIfFails(instance, args.pathThreads);
     auto [_, ALAPST] = algorithms::paths::computeALAPST(dg);
 
     LOG("Number of vertices in the delay graph is {} ", dg.getNumberOfVertices());
@@ -109,22 +249,36 @@ initialize(const cli::CLIArgs &args, problem::Instance &instance, DDSolverDataPt
                                                std::move(dg),
                                                keepActiveVerticesSparse,
                                                storeAllStates);
+    if (args.explorationType.isWidthBounded()) {
+        if (args.maxWidth == 0) {
+            throw std::runtime_error("FmsScheduler::the maximum width of the DD must be positive");
+        }
+        data->maxWidth = args.maxWidth;
+    }
     // Initialize the root state
     // ASAPST is the earliest start time for each operation
     // ALAPST is the latest start time for each operation
-    auto root = std::make_shared<Vertex>(data->nextVertexId++,
-                                         0,
-                                         MachinesSequences{},
-                                         ASAPST,
-                                         ALAPST,
-                                         JobIdxToOpIdx(jobs.size(), 0),
-                                         std::vector<problem::JobId>{},
-                                         MachineToVertex{},
-                                         cg::VerticesIds{});
+    auto root = data->pool->make(Vertex(data->nextVertexId++,
+                                        0,
+                                        MachinesSequences{},
+                                        StateTimes::create(std::move(ASAPST), std::move(ALAPST)),
+                                        JobIdxToOpIdx(jobs.size(), 0),
+                                        std::vector<problem::JobId>{},
+                                        MachineToVertex{},
+                                        cg::VerticesIds{}));
     root->setReadyOperations(instance);
+    root->setTranspositionHash(zobrist::hash(*root));
+
+    if (!args.historyFile.empty()) {
+        data->history = std::make_shared<HistoryWriter>(args.historyFile);
+    }
+    if (args.transpositionMemory > 0) {
+        data->transpositions =
+                std::make_shared<TranspositionTable>(std::size_t{args.transpositionMemory} << 20U);
+    }
 
     // Add root to the queue. It will the be first state to be explored unless we provide a seed
-    push(data->states, args.explorationType, root, solution, true);
+    push(*data, root);
     data->storeState(root);
 
     // get seed solution if available
@@ -145,12 +299,14 @@ initialize(const cli::CLIArgs &args, problem::Instance &instance, DDSolverDataPt
 }
 
 bool shouldStop(const DDSolverData &data, const cli::CLIArgs &args, const std::size_t iterations) {
-    const auto timeElapsed = utils::time::getCpuTime() - data.solution.start();
-    return data.states.empty() || timeElapsed >= args.timeOut || iterations >= args.maxIterations
-           || data.solution.isOptimal();
+    return data.states.empty() || data.solution.elapsed() >= args.timeOut
+           || iterations >= args.maxIterations || data.solution.isOptimal();
 }
 
 void singleIteration(DDSolverData &data, const problem::Instance &problemInstance) {
+    if (isLayerDone(data)) {
+        startLayer(data, problemInstance);
+    }
     SharedVertex s = pop(data);
 
     const auto &sLastOperation = s->getLastOperation();
@@ -164,21 +320,121 @@ void singleIteration(DDSolverData &data, const problem::Instance &problemInstanc
     if (isTerminal(*s, problemInstance)) {
         // if terminal we should update upper bound and add state to another queue otherwise we
         // lose it
-        data.solution.addNewSolution(*s);
-        if (data.solution.isOptimal()) {
-            LOG("Solution is optimal");
-        }
+        addTerminal(data, *s);
+        return;
+    }
+    if (data.isTransposition(s, problemInstance)) {
+        LOG("State is dominated by an expanded state");
         return;
     }
-    const auto addedEdges = data.dg.addEdges(s->getAllEdges(problemInstance));
+    // The edges of the state are layered on top of the shared graph instead of being inserted
+    cg::GraphOverlay stateGraph(data.dg, data.csr);
+    stateGraph.addEdges(s->getAllEdges(problemInstance));
 
     LOG("Expanding state");
-    auto expandedStates = expandVertex(data, *s, problemInstance);
+    auto expansions = computeExpansions(data.dg, stateGraph, *s, problemInstance);
+    addChildren(data, *s, std::move(expansions), problemInstance);
 
+    // update best lower bound
+    ::updateBounds(data);
+
+    LOG_D("Queue is {} elements long", data.states.size());
+
+    if (data.solution.isOptimal()) {
+        LOG("Solution is optimal");
+        return;
+    }
+
+    if (data.states.empty()) {
+        LOG("States is empty");
+    }
+}
+
+void addTerminal(DDSolverData &data, const Vertex &vertex) {
+    if (vertex.isRelaxed()) {
+        // Its times are only a bound of the schedules of the states that were merged into it
+        data.discardedLowerBound = std::min(data.discardedLowerBound, vertex.lowerBound());
+        return;
+    }
+
+    data.solution.addNewSolution(vertex);
+    if (data.solution.isOptimal()) {
+        LOG("Solution is optimal");
+    }
+}
+
+void startLayer(DDSolverData &data, const problem::Instance &problemInstance) {
+    if (data.states.size() > data.maxWidth) {
+        // Best ranked states first. The ranking is the same as the one of the static exploration.
+        auto states = data.states.takeAll();
+        const CompareVerticesRanking ranking(data.solution);
+        std::sort(states.begin(), states.end(), [&ranking](const auto &a, const auto &b) {
+            return ranking(b, a);
+        });
+
+        const auto firstExcess =
+                states.begin()
+                + static_cast<std::ptrdiff_t>(
+                        data.explorationType == cli::DDExplorationType::RELAXED ? data.maxWidth - 1
+                                                                                : data.maxWidth);
+        for (auto it = firstExcess; it != states.end(); ++it) {
+            removeActiveVertex(data.activeVertices, **it);
+        }
+
+        SharedVertex merged;
+        if (data.explorationType == cli::DDExplorationType::RESTRICTED) {
+            // The dropped states are never expanded but their bounds still hold
+            for (auto it = firstExcess; it != states.end(); ++it) {
+                data.discardedLowerBound = std::min(data.discardedLowerBound, (*it)->lowerBound());
+            }
+        } else {
+            merged = *firstExcess;
+            for (auto it = std::next(firstExcess); it != states.end(); ++it) {
+                merged = mergeOperator(
+                        *data.pool, *merged, **it, data.nextVertexId, problemInstance, data.dg);
+            }
+        }
+
+        states.erase(firstExcess, states.end());
+        for (auto &state : states) {
+            push(data, std::move(state));
+        }
+        if (merged) {
+            const auto dominated =
+                    findVertexDominance(data.activeVertices, merged, problemInstance);
+            data.storeState(merged, dominated ? StateFate::DOMINATED : StateFate::QUEUED);
+            if (!dominated) {
+                push(data, std::move(merged));
+            }
+        }
+    }
+
+    data.layerStatesLeft = data.states.size();
+    LOG_D("Starting a layer of {} states", data.states.size());
+}
+
+void addChildren(DDSolverData &data,
+                 const Vertex &state,
+                 std::vector<Expansion> expansions,
+                 const problem::Instance &problemInstance) {
     // For each ready operation(s), attempt to schedule and extend to a new state
     // If dominated, discard
     // If dominates, replace and propagate release to child nodes
-    for (auto newState : expandedStates) {
+    for (auto &expansion : expansions) {
+        if (expansion.touchedVertices) {
+            ++data.incrementalChildren;
+            data.touchedVertices += *expansion.touchedVertices;
+        }
+
+        auto newState = createNewVertex(*data.pool,
+                                        data.nextVertexId,
+                                        state,
+                                        problemInstance,
+                                        expansion.vOps,
+                                        expansion.ops,
+                                        std::move(expansion.ASAPST),
+                                        std::move(expansion.ALAPST),
+                                        state.isRelaxed());
 
         // First check if it is dominated upper bound wise and discard if it is
         // Then check if it dominates another state or it is not dominated we create a new state
@@ -187,37 +443,25 @@ void singleIteration(DDSolverData &data, const problem::Instance &problemInstanc
         // causing a pointer error.
 
         if (newState->lowerBound() > data.solution.bestUpperBound()) {
-            data.storeState(newState);
+            data.storeState(newState, StateFate::PRUNED);
+            continue;
+        }
+        // The same state reached through another path was already expanded
+        if (data.transpositions && data.transpositions->isDominated(*newState, problemInstance)) {
+            data.storeState(newState, StateFate::DOMINATED);
             continue;
         }
         if (findVertexDominance(data.activeVertices, newState, problemInstance)) {
             // comment the following line to prune the tree
-            data.storeState(newState);
+            data.storeState(newState, StateFate::DOMINATED);
             continue;
         }
 
         // s->addChild(newState);
-        push(data, newState, false);
+        push(data, newState);
 
         data.storeState(newState);
     }
-
-    // update best lower bound
-    ::updateBounds(data);
-
-    // Remove the edges that were added
-    data.dg.removeEdges(addedEdges);
-
-    LOG_D("Queue is {} elements long", data.states.size());
-
-    if (data.solution.isOptimal()) {
-        LOG("Solution is optimal");
-        return;
-    }
-
-    if (data.states.empty()) {
-        LOG("States is empty");
-    }
 }
 
 /*Input: a problem instance, command line arguments and oldData
@@ -247,29 +491,87 @@ solveWrap(problem::Instance &problemInstance, const cli::CLIArgs &args, DDSolver
 
     // Count iterations
     std::uint32_t iterations = 0;
+    ::CheckpointTimer checkpointTimer(args);
+
+    if (args.threads <= 1) {
+        while (!shouldStop(*data, args, iterations)) {
+            singleIteration(*data, problemInstance);
+            ++iterations;
+            checkpointTimer.update(*data, problemInstance);
+        }
+    } else {
+        utils::TaskWorkers workers(args.threads);
+        const std::size_t batchSize = kBatchStatesPerThread * args.threads;
+        while (!shouldStop(*data, args, iterations)) {
+            // Every popped state counts as an iteration, as in the sequential search
+            const auto maxStates =
+                    std::min<std::uint64_t>(batchSize, args.maxIterations - iterations);
+            iterations += ::batchIteration(*data, problemInstance, workers, maxStates);
+            checkpointTimer.update(*data, problemInstance);
+        }
+    }
 
-    while (!shouldStop(*data, args, iterations)) {
-        singleIteration(*data, problemInstance);
-        ++iterations;
+    // A search that stopped early can be resumed from the checkpoint
+    if (!args.checkpointFile.empty() && !data->states.empty() && !data->solution.isOptimal()) {
+        saveCheckpoint(*data, problemInstance, args.checkpointFile);
     }
 
     return solveTerminate(std::move(data));
 }
 
 ResumableSolverOutput solveTerminate(DDSolverDataPtr data) {
+    if (data->history) {
+        data->history->flush();
+    }
+
     auto dataJSON = data->solution.getSolveData();
 
     // Find termination reason
     if (data->solution.isOptimal()) {
         dataJSON["terminationReason"] = TerminationStrings::kOptimal;
     } else if (data->states.empty()) {
-        dataJSON["terminationReason"] = TerminationStrings::kNoSolution;
+        dataJSON["terminationReason"] = data->solution.getStatesTerminated().empty()
+                                                ? TerminationStrings::kNoSolution
+                                                : TerminationStrings::kCompleted;
     } else {
         dataJSON["terminationReason"] = TerminationStrings::kTimeOut;
         // The other two reasons already print a message inside the loop
         LOG("DD: Time out");
     }
 
+    // The bounds are also reported when the search stops without a solution, they are the result
+    // of a relaxed diagram
+    const auto &solution = data->solution;
+    if (solution.bestLowerBound() != std::numeric_limits<delay>::min()) {
+        dataJSON["lowerBound"] = solution.bestLowerBound();
+    }
+    if (solution.bestUpperBound() != std::numeric_limits<delay>::max()) {
+        dataJSON["upperBound"] = solution.bestUpperBound();
+    }
+    if (data->explorationType.isWidthBounded()) {
+        dataJSON["maxWidth"] = data->maxWidth;
+        if (data->discardedLowerBound != std::numeric_limits<delay>::max()) {
+            dataJSON["discardedLowerBound"] = data->discardedLowerBound;
+        }
+    }
+
+    dataJSON["searchTime"] = std::chrono::duration<float>(data->solution.elapsed()).count();
+    dataJSON["stateMemory"] = ::getStateMemory(*data);
+    dataJSON["childTimes"] = {
+            {"incrementalChildren", data->incrementalChildren},
+            {"touchedVertices", data->touchedVertices},
+            {"touchedVerticesPerChild",
+             data->touchedVertices / std::max<std::uint64_t>(data->incrementalChildren, 1)},
+            {"graphVertices", data->dg.getNumberOfVertices()}};
+    if (data->transpositions) {
+        const auto &transpositions = *data->transpositions;
+        dataJSON["transpositionTable"] = {{"hits", transpositions.hits()},
+                                          {"misses", transpositions.misses()},
+                                          {"entries", transpositions.size()},
+                                          {"bytes", transpositions.bytes()},
+                                          {"evictions", transpositions.evictions()}};
+    }
+
     const auto &solutions = data->solution.getStatesTerminated();
     return {extractSolutions(solutions), std::move(dataJSON), std::move(data)};
 }
@@ -372,16 +674,22 @@ void initialiseStates(const problem::Instance &problem,
 
             // Check whether updating the path with a new edge is feasible while also inferring
             // lower bound
-            if (algorithms::paths::addEdgesIncrementalASAPST(data.dg, inferredEdges, stateASAPST)) {
+            if (algorithms::paths::addEdgesIncrementalASAPST(
+                        cg::GraphOverlay(data.dg, data.csr), inferredEdges, stateASAPST)) {
                 // No, adding one edge creates a cycle - simultaneously updates ASAPST
                 // Throw error because seed solution should always be feasible
                 throw FmsSchedulerException("The seed solution is infeasible");
             }
 
-            updateVertexALAPST(
-                    stateASAPST, stateALAPST, data.dg, oldVertex->scheduledOps(), {edge}, {op});
+            updateVertexALAPST(stateASAPST,
+                               stateALAPST,
+                               cg::GraphOverlay(data.dg, data.csr),
+                               oldVertex->scheduledOps(),
+                               {edge},
+                               {op});
 
-            auto newVertex = createNewVertex(data.nextVertexId,
+            auto newVertex = createNewVertex(*data.pool,
+                                             data.nextVertexId,
                                              *oldVertex,
                                              problem,
                                              {vOp.id},
@@ -389,7 +697,7 @@ void initialiseStates(const problem::Instance &problem,
                                              std::move(stateASAPST),
                                              std::move(stateALAPST));
 
-            push(data.states, args.explorationType, newVertex, data.solution, true);
+            push(data, newVertex);
             data.storeState(newVertex);
             oldVertex = newVertex;
         }
@@ -404,21 +712,13 @@ void initialiseStates(const problem::Instance &problem,
 
 /*
  *
- * input: Jobidxtovertices, vertex
+ * input: activevertices, vertex
  * We search for a vertex in activevertices that matches the vertexjobcompletionstatus
  * If vertex v is not found, then the function just returns because there is nothing to remove
  * Else it removes that vertex
  */
-void removeActiveVertex(JobIdxToVertices &activeVertices, const Vertex &v) {
-    auto it = activeVertices.find(v.getJobsCompletion());
-    if (it == activeVertices.end()) {
-        return;
-    }
-
-    it->second.erase(v.id());
-    if (it->second.empty()) {
-        activeVertices.erase(it);
-    }
+void removeActiveVertex(DominanceStore &activeVertices, const Vertex &v) {
+    activeVertices.erase(v);
 }
 
 /*
@@ -533,7 +833,8 @@ inferEdges(const Vertex &s, const problem::Instance &problem, const cg::Constrai
  * specified depth and whether operations are set as ready based on the relaxed state of the graph.
  *
  */
-SharedVertex createNewVertex(std::uint64_t &nextVertexId,
+SharedVertex createNewVertex(VertexPool &pool,
+                             std::uint64_t &nextVertexId,
                              const Vertex &oldVertex,
                              const problem::Instance &problemInstance,
                              const cg::VerticesIds &vOps,
@@ -545,215 +846,150 @@ SharedVertex createNewVertex(std::uint64_t &nextVertexId,
     auto newJobOrder = oldVertex.getJobOrder();
     auto newJobsCompletion = oldVertex.getJobsCompletion();
     auto newMachinesSequences = oldVertex.getMachinesSequences();
-    auto newScheduledOps = oldVertex.scheduledOps();
     auto newLastOperation = oldVertex.getLastOperation();
+    auto newHash = oldVertex.transpositionHash();
+
+    // The vectors are kept at their exact size because growing them would double the memory of
+    // states that stay in the queue
+    cg::VerticesIds newScheduledOps;
+    newScheduledOps.reserve(oldVertex.scheduledOps().size() + vOps.size());
+    newScheduledOps.assign(oldVertex.scheduledOps().begin(), oldVertex.scheduledOps().end());
 
     for (std::size_t i = 0; i < ops.size(); i++) {
         const auto &op = ops[i];
         const auto &mId = problemInstance.getMachine(op);
         newMachinesSequences[mId].push_back(op);
         newScheduledOps.push_back(vOps[i]);
-        newLastOperation[mId] = vOps[i];
+
+        // The keys of the parts that change are swapped in the hash of the parent
+        auto [lastOp, firstOnMachine] = newLastOperation.try_emplace(mId, vOps[i]);
+        if (!firstOnMachine) {
+            newHash ^= zobrist::lastOperationKey(lastOp->second);
+            lastOp->second = vOps[i];
+        }
+        newHash ^= zobrist::lastOperationKey(vOps[i]);
 
         const auto jobOutOrder = problemInstance.getJobOutputPosition(op.jobId);
-        newJobsCompletion[jobOutOrder] += 1;
+        auto &completion = newJobsCompletion[jobOutOrder];
+        newHash ^= zobrist::completionKey(jobOutOrder, completion)
+                   ^ zobrist::completionKey(jobOutOrder, completion + 1);
+        completion += 1;
 
         if (op.operationId <= 0) {
             // first operation
+            newHash ^= zobrist::jobOrderKey(newJobOrder.size(), op.jobId);
             newJobOrder.push_back(op.jobId);
         }
     }
+    for (const auto &op : ops) {
+        newMachinesSequences[problemInstance.getMachine(op)].shrink_to_fit();
+    }
+    newJobOrder.shrink_to_fit();
     auto depth = oldVertex.vertexDepth() + 1; // you are a direct child of the old vertex
 
-    // encountered ops same as scheduled ops unless we merge
-    auto encounteredOps = newScheduledOps;
-
-    auto newVertex = std::make_shared<Vertex>(nextVertexId++,
-                                              oldVertex.id(),
-                                              std::move(newMachinesSequences),
-                                              std::move(ASAPST),
-                                              std::move(ALAPST),
-                                              std::move(newJobsCompletion),
-                                              std::move(newJobOrder),
-                                              std::move(newLastOperation),
-                                              std::move(newScheduledOps),
-                                              depth,
-                                              std::move(encounteredOps));
+    // Only the times that differ from the parent are stored. The encountered ops are the same as
+    // the scheduled ops unless we merge, so they are left empty.
+    auto newVertex = pool.make(Vertex(
+            nextVertexId++,
+            oldVertex.id(),
+            std::move(newMachinesSequences),
+            StateTimes::create(oldVertex.getTimes(), std::move(ASAPST), std::move(ALAPST)),
+            std::move(newJobsCompletion),
+            std::move(newJobOrder),
+            std::move(newLastOperation),
+            std::move(newScheduledOps),
+            depth));
     newVertex->setReadyOperations(problemInstance, graphIsRelaxed);
+    newVertex->setRelaxed(graphIsRelaxed);
+    newVertex->setTranspositionHash(newHash);
     return newVertex;
 }
 
 /*
- * Input: data, state (queue of vertices to be explored), probleminstance and expandedstates
+ * Input: base graph, state graph, state and probleminstance
  * It iterates over each set of the ready operations in the current state.
  * It generates new potential edges for the scheduling graph based on the current ready operations.
  * We duplicate the asap and alap scheduling times to update them for a new state, and then
- * we check if adding these edges to the graph is feasible without creating cycles.
+ * we check if adding these edges to the graph is feasible without creating cycles. The times of
+ * the state are consistent with its graph, so only the vertices downstream of the new edges are
+ * updated.
  * Then we update the alap times based on the new edges and the current set of scheduled operations.
- * We create a new vertex representing the state derived from the current state with the newly
- * inferred schedule. Then we add the newly created state to the list of expanded states. This
- * method returns all newly created states. (expanded states)
+ * The vertices of the new states are created later by addChildren, so this method only returns
+ * the scheduled operations and times of every feasible option.
  */
 
-std::vector<SharedVertex>
-expandVertex(auto &data, const Vertex &state, const problem::Instance &problemInstance) {
-    std::vector<SharedVertex> expandedStates;
+std::vector<Expansion> computeExpansions(const cg::ConstraintGraph &baseGraph,
+                                         const cg::GraphOverlay &dg,
+                                         const Vertex &state,
+                                         const problem::Instance &problemInstance) {
+    std::vector<Expansion> expansions;
+    const auto times = state.getTimes()->decode();
+
+    // The inferred edges only depend on the state, they are the same for all its children
+    const auto stateInferredEdges = inferEdges(state, problemInstance, baseGraph);
 
     for (const auto &[jId, ops] : state.readyOps()) {
         auto [newEdges, readyVIDs] =
-                createSchedulingOptionEdges(problemInstance, data.dg, state, ops);
-
-        auto newASAPST = state.getASAPST();
-        auto newALAPST = state.getALAPST();
-
-        auto inferredEdges = inferEdges(state, problemInstance, data.dg);
-        inferredEdges.insert(inferredEdges.end(), newEdges.begin(), newEdges.end());
-
-        // Check if updating the path with a new edge is feasible while also inferring lower bound
-        if (!algorithms::paths::addEdgesSuccessful(data.dg, inferredEdges, newASAPST)) {
-            LOG_T("welp, infeasible {} \n", data.nextVertexId);
-            continue;
+                createSchedulingOptionEdges(problemInstance, baseGraph, state, ops);
+
+        auto newASAPST = times->ASAPST;
+        auto newALAPST = times->ALAPST;
+
+        // The scheduled edges come first so that an inferred edge between the same operations,
+        // which only has the processing time as weight, does not replace them
+        auto inferredEdges = newEdges;
+        inferredEdges.insert(
+                inferredEdges.end(), stateInferredEdges.begin(), stateInferredEdges.end());
+
+        // Check if updating the path with a new edge is feasible while also inferring lower bound.
+        // The times of a merged state are the minimum of the times of different graphs, so they
+        // are not consistent with its own graph and need a full computation.
+        std::optional<std::size_t> touchedVertices;
+        if (state.isRelaxed()) {
+            if (!algorithms::paths::addEdgesSuccessful(dg, inferredEdges, newASAPST)) {
+                LOG_T("welp, infeasible child of {} \n", state.id());
+                continue;
+            }
+        } else {
+            // The expansions run on the worker threads, each one keeps its own buffers
+            thread_local algorithms::paths::IncrementalASAPScratch scratch;
+            const auto result = algorithms::paths::computeIncrementalASAPST(
+                    dg, inferredEdges, newASAPST, scratch);
+            if (result.positiveCycle) {
+                LOG_T("welp, infeasible child of {} \n", state.id());
+                continue;
+            }
+            touchedVertices = result.touchedVertices;
+            LOG_T("Child of {} touched {} vertices", state.id(), result.touchedVertices);
         }
 
-        updateVertexALAPST(newASAPST, newALAPST, data.dg, state.scheduledOps(), newEdges, ops);
+        updateVertexALAPST(newASAPST, newALAPST, dg, state.scheduledOps(), newEdges, ops);
 
-        auto newState = createNewVertex(data.nextVertexId,
-                                        state,
-                                        problemInstance,
-                                        readyVIDs,
-                                        ops,
-                                        std::move(newASAPST),
-                                        std::move(newALAPST),
-                                        false);
-        expandedStates.push_back(newState);
-    }
-    return expandedStates;
+        expansions.push_back({std::move(readyVIDs),
+                              ops,
+                              std::move(newASAPST),
+                              std::move(newALAPST),
+                              touchedVertices});
+    }
+    return expansions;
 }
 
-bool findVertexDominance(JobIdxToVertices &activeVertices,
+bool findVertexDominance(DominanceStore &activeVertices,
                          const SharedVertex &newVertex,
                          const problem::Instance &problemInstance) {
-
-    // this selects those active vertices that have reached the same level of job completion as the
-    // new vertex being considered
-    auto &possibleVertices = activeVertices[newVertex->getJobsCompletion()];
-
-    for (const auto &[id, v] : possibleVertices) {
-        if (isDominated(*newVertex, *v, problemInstance)) {
-            // It is dominated we can discard it
-            LOG("state is dominated");
-            return true;
-        }
-    }
-
-    // Iterators become invalid after removing elements from the map so we first make a list of
-    // the elements to remove
-    std::vector<std::size_t> toRemove;
-    for (const auto &[id, v] : possibleVertices) {
-        if (isDominated(*v, *newVertex, problemInstance)) {
-            // It dominates the vertex so we remove it
-            LOG("state dominates");
-            toRemove.push_back(id);
-        }
-    }
-
-    for (const auto &id : toRemove) {
-        possibleVertices.erase(id);
-    }
-
-    // If it is not dominated, we add it
-    LOG("state is added");
-    possibleVertices.emplace(newVertex->id(), newVertex);
-    return false;
-};
+    // Only the active vertices that have reached the same level of job completion as the new
+    // vertex are considered
+    return activeVertices.addIfNotDominated(newVertex, problemInstance);
+}
 
 bool isDominated(const Vertex &newVertex,
                  const Vertex &oldVertex,
                  const problem::Instance &problem) {
-    const auto &dg = problem.getDelayGraph();
-    const auto &allSequencesNew = newVertex.getMachinesSequences();
-    const auto &allSequencesOld = oldVertex.getMachinesSequences();
-
-    if (allSequencesNew.size() != allSequencesOld.size()) {
-        return false;
-    }
-
-    const auto &newASAPST = newVertex.getASAPST();
-    const auto &oldASAPST = oldVertex.getASAPST();
-    const auto &newALAPST = newVertex.getALAPST();
-    const auto &oldALAPST = oldVertex.getALAPST();
-
-    bool unscheduledOpsDominance = false;
-    bool readyDone = false;
-    problem::OperationsVector allReadyOps;
-
-    // If it is dominated, possible start time (machine availability + sequence dependent setup
-    // times) are always higher for the old than for the new
-    const bool opStartTimeDominance = std::all_of(
-            allSequencesNew.begin(), allSequencesNew.end(), [&](const auto &machineSequenceNew) {
-                const auto &mId = machineSequenceNew.first;
-                const auto &sequenceOld = allSequencesOld.at(mId);
-                const auto &sequenceNew = machineSequenceNew.second;
-                if (machineSequenceNew.second.empty() || sequenceOld.empty()) {
-                    LOG_W("Empty edges for machine {}", machineSequenceNew.first);
-                    return false;
-                }
-
-                // We cache this value because we only need to compute it once
-                if (!readyDone) {
-                    allReadyOps = newVertex.immediatelyReadyOps();
-                    readyDone = true;
-                }
-
-                problem::OperationsVector readyOps;
-                std::copy_if(allReadyOps.begin(),
-                             allReadyOps.end(),
-                             back_inserter(readyOps),
-                             [&](const auto &op) { return problem.getMachine(op) == mId; });
-
-                const auto vIdDstNew = dg.getVertexId(sequenceNew.back());
-                const auto vIdDstOld = dg.getVertexId(sequenceOld.back());
-                if (readyOps.empty()) {
-                    return newASAPST.at(vIdDstNew) + problem.getProcessingTime(vIdDstNew)
-                           >= oldASAPST.at(vIdDstOld) + problem.getProcessingTime(vIdDstOld);
-                }
-
-                const auto &opDstNew = dg.getVertex(vIdDstNew).operation;
-                const auto &opDstOld = dg.getVertex(vIdDstOld).operation;
-
-                return std::all_of(readyOps.begin(), readyOps.end(), [&](const auto &op) {
-                    return newASAPST.at(vIdDstNew) + problem.query(opDstNew, op)
-                           >= oldASAPST.at(vIdDstOld) + problem.query(opDstOld, op);
-                });
-            });
-
-    if (opStartTimeDominance) {
-        unscheduledOpsDominance = true;
-        const auto &opsSched = newVertex.scheduledOps();
-        const auto &opsReady = newVertex.immediatelyReadyOps();
-
-        for (std::size_t vId = 0; vId < newASAPST.size() && unscheduledOpsDominance; ++vId) {
-            if (std::find(opsSched.begin(), opsSched.end(), vId) != opsSched.end()) {
-                // it is always dominated based on this operation because we only check yet to be
-                // scheduled ops
-                continue;
-            }
-            // if it is in ready ops then the check is already handled by opDom
-
-            if (std::find(opsReady.begin(), opsReady.end(), dg.getVertex(vId).operation)
-                != opsReady.end()) {
-
-                unscheduledOpsDominance =
-                        (oldALAPST[vId] - oldASAPST[vId]) <= (newALAPST[vId] - newASAPST[vId]);
-                continue;
-            }
-            unscheduledOpsDominance =
-                    (oldASAPST[vId] >= newASAPST[vId])
-                    && ((oldALAPST[vId] - oldASAPST[vId]) <= (newALAPST[vId] - newASAPST[vId]));
-        }
-    }
-
-    return opStartTimeDominance && unscheduledOpsDominance;
+    return fms::dd::isDominated(newVertex,
+                                DominanceSummary(newVertex, problem),
+                                oldVertex,
+                                DominanceSummary(oldVertex, problem),
+                                problem);
 }
 
 bool isTerminal(const Vertex &vertex, const problem::Instance &instance) {
@@ -769,120 +1005,63 @@ bool isTerminal(const Vertex &vertex, const problem::Instance &instance) {
 
 void updateVertexALAPST(const algorithms::paths::PathTimes &ASAPST,
                         algorithms::paths::PathTimes &ALAPST,
-                        cg::ConstraintGraph &dg,
+                        const cg::GraphOverlay &dg,
                         const cg::VerticesIds &scheduledOps,
                         const cg::Edges &newestEdges,
                         const std::vector<problem::Operation> &newestOps) {
-    // TO DO: Can we have a version of this function that increments based on adding one new edge?
-    // Tricky because apart from adding an edge, we also update some values
-
     for (auto i : scheduledOps) {
         ALAPST[i] = ASAPST[i];
     }
     for (auto op : newestOps) {
-        ALAPST[dg.getVertexId(op)] = ASAPST[dg.getVertexId(op)];
+        const auto vId = dg.getBase().getVertexId(op);
+        ALAPST[vId] = ASAPST[vId];
     }
-    dg.addEdges(newestEdges);
+
+    // The times of the parent state are already propagated, so only the fixed operations and the
+    // new edges need to be propagated backwards. The newest operations can also be moved earlier
+    // by their successors.
+    cg::VerticesIds changed(scheduledOps);
+    for (auto op : newestOps) {
+        const auto vId = dg.getBase().getVertexId(op);
+        dg.anyOutgoing(vId, [&](cg::VertexId dst, delay weight) {
+            if (ALAPST[dst] != algorithms::paths::kALAPStartValue) {
+                ALAPST[vId] = std::min(ALAPST[vId], ALAPST[dst] - weight);
+            }
+            return false;
+        });
+        changed.push_back(vId);
+    }
+
     // Note that newestOp should bed part of scheduledOps passed to this function
     // It doesnt matter at the moment because the ASAPST check already guarntees this is efasible
     // But if it were infeasible we may lose chance to spot it
-    auto newALAPresult = algorithms::paths::computeALAPST(dg, ALAPST, scheduledOps);
-    dg.removeEdges(newestEdges);
-}
-
-void push(auto &states,
-          cli::DDExplorationType explorationType,
-          SharedVertex &newVertex,
-          const DDSolution &solution,
-          bool reOrder) {
-    switch (explorationType) {
-    case cli::DDExplorationType::DEPTH:
-        states.push_front(newVertex);
-        break;
-
-    case cli::DDExplorationType::STATIC:
-    case cli::DDExplorationType::ADAPTIVE:
-        if (reOrder) {
-            orderQueue(states, CompareVerticesRanking(solution));
-        }
-        states.push_back(newVertex);
-        std::push_heap(states.begin(), states.end(), CompareVerticesRanking(solution));
-        break;
-    case cli::DDExplorationType::BREADTH:
-        states.push_back(newVertex);
-        break;
-    case cli::DDExplorationType::BEST:
-        if (reOrder) {
-            orderQueue(states, CompareVerticesLowerBound());
-        }
-        states.push_back(newVertex);
-        std::push_heap(states.begin(), states.end(), CompareVerticesLowerBound());
-        break;
-    default:
-        throw std::runtime_error("FmsScheduler::unknown graph exploration heuristic supplied -- "
-                                 "only depth and static currently accepted for DD seed scheduler");
-    }
+    // The expansions run on the worker threads, each one keeps its own buffers across children
+    thread_local algorithms::paths::IncrementalALAPScratch scratch;
+    algorithms::paths::updateIncrementalALAPST(dg, changed, ALAPST, scheduledOps, scratch);
+    algorithms::paths::addEdgesIncrementalALAPST(dg, newestEdges, ALAPST, scheduledOps, scratch);
 }
 
 SharedVertex pop(DDSolverData &data) {
-    auto v = data.states.front();
-    switch (data.explorationType) {
-    case cli::DDExplorationType::DEPTH:
-    case cli::DDExplorationType::BREADTH:
-        data.states.pop_front();
-        break;
-    case cli::DDExplorationType::BEST:
-        std::pop_heap(data.states.begin(), data.states.end(), CompareVerticesLowerBound());
-        data.states.pop_back();
-        break;
-    case cli::DDExplorationType::STATIC:
-    case cli::DDExplorationType::ADAPTIVE:
-        std::pop_heap(
-                data.states.begin(), data.states.end(), CompareVerticesRanking(data.solution));
-        data.states.pop_back();
-        break;
-    default:
-        throw std::runtime_error("FmsScheduler::unknown graph exploration heuristic supplied -- "
-                                 "only depth and static currently accepted for DD seed scheduler");
-    }
-
-    return v;
-}
-
-// Merge operator to create a relaxed diagram
-template <typename T, class F>
-void mergeLoop(T &states,
-               std::uint64_t &vertexId,
-               const problem::Instance &problemInstance,
-               const cg::ConstraintGraph &dg) {
-    constexpr std::uint32_t MAX_WIDTH = 100;
-    while (states.size() > MAX_WIDTH) { // fix width to 100 for now
-        // select vertices to merge
-        // remove them from states
-
-        std::uint32_t firstIndex = chooseVertexToMerge(states.size());
-        const auto firstVertex = states[firstIndex];
-        states.erase(states.begin() + firstIndex);
-
-        std::uint32_t secondIndex = chooseVertexToMerge(states.size());
-        const auto secondVertex = states[secondIndex];
-        states.erase(states.begin() + secondIndex); // find element and remove it from vector
-
-        // perform merge
-        auto newVertex = mergeOperator(firstVertex, secondVertex, vertexId, problemInstance, dg);
-        states.emplace_back(std::move(newVertex));
+    if (data.explorationType.isWidthBounded()) {
+        --data.layerStatesLeft;
     }
+    return data.states.pop(data.solution);
 }
 
-SharedVertex mergeOperator(const Vertex &a,
+// Merge operator to create a relaxed diagram
+SharedVertex mergeOperator(VertexPool &pool,
+                           const Vertex &a,
                            const Vertex &b,
                            std::uint64_t &vertexId,
                            const problem::Instance &problemInstance,
                            const cg::ConstraintGraph &dg) {
 
+    const auto aTimes = a.getTimes()->decode();
+    const auto bTimes = b.getTimes()->decode();
+
     algorithms::paths::PathTimes mergedASAPST;
-    auto aASAPST = a.getASAPST();
-    auto bASAPST = b.getASAPST();
+    const auto &aASAPST = aTimes->ASAPST;
+    const auto &bASAPST = bTimes->ASAPST;
     mergedASAPST.reserve(aASAPST.size());
     std::transform(aASAPST.begin(),
                    aASAPST.end(),
@@ -891,8 +1070,8 @@ SharedVertex mergeOperator(const Vertex &a,
                    [](auto x, auto y) { return std::min(x, y); });
 
     algorithms::paths::PathTimes mergedALAPST;
-    auto aALAPST = a.getALAPST();
-    auto bALAPST = b.getALAPST();
+    const auto &aALAPST = aTimes->ALAPST;
+    const auto &bALAPST = bTimes->ALAPST;
     mergedALAPST.reserve(aALAPST.size());
     std::transform(aALAPST.begin(),
                    aALAPST.end(),
@@ -916,65 +1095,59 @@ SharedVertex mergeOperator(const Vertex &a,
     std::vector<problem::JobId> mergedJobOrder =
             {}; // relaxation clears job order and then allows overtaking
 
-    cg::VerticesIds mergedScheduledOps;
+    // The operations of each job that are scheduled in a state are the ones before its completion
+    // index, so the union of the scheduled operations matches the maximum of the completions. The
+    // operations are kept in scheduling order in the vertices and must be sorted first.
     auto aScheduledOps = a.scheduledOps();
     auto bScheduledOps = b.scheduledOps();
-    std::set_intersection(aScheduledOps.begin(),
-                          aScheduledOps.end(),
-                          bScheduledOps.begin(),
-                          bScheduledOps.end(),
-                          std::back_inserter(mergedScheduledOps));
-
-    cg::VerticesIds mergedEncounteredOps;
-    auto aEncounteredOps = a.encounteredOps();
-    auto bEncounteredOps = b.encounteredOps();
-    std::set_union(aEncounteredOps.begin(),
-                   aEncounteredOps.end(),
-                   bEncounteredOps.begin(),
-                   bEncounteredOps.end(),
-                   std::back_inserter(mergedEncounteredOps));
-
-    MachineToVertex mergedLastOperation; // TO DO - make this more efficient than loop and check
-    // for each machine, it is the maximum asapst of things already encountered on that machine
-    for (auto vId : mergedEncounteredOps) {
-        const auto mId = problemInstance.getMachine(dg.getVertex(vId).operation);
-        if (mergedLastOperation.find(mId) == mergedLastOperation.end()) {
-            mergedLastOperation[mId] = vId;
-            continue;
-        }
-        if (mergedASAPST[vId] > mergedASAPST[mergedLastOperation[mId]]) {
-            mergedLastOperation[mId] = vId;
+    std::sort(aScheduledOps.begin(), aScheduledOps.end());
+    std::sort(bScheduledOps.begin(), bScheduledOps.end());
+    cg::VerticesIds mergedScheduledOps;
+    std::set_union(aScheduledOps.begin(),
+                   aScheduledOps.end(),
+                   bScheduledOps.begin(),
+                   bScheduledOps.end(),
+                   std::back_inserter(mergedScheduledOps));
+
+    // A machine is available as soon as it is available in one of the states. If it has not been
+    // used in one of them, it is available from the start.
+    MachineToVertex mergedLastOperation;
+    const auto &bLastOperation = b.getLastOperation();
+    for (const auto &[mId, aVId] : a.getLastOperation()) {
+        const auto it = bLastOperation.find(mId);
+        if (it == bLastOperation.end()) {
             continue;
         }
+        const auto bVId = it->second;
+        mergedLastOperation[mId] =
+                mergedASAPST[aVId] + problemInstance.getProcessingTime(aVId)
+                                <= mergedASAPST[bVId] + problemInstance.getProcessingTime(bVId)
+                        ? aVId
+                        : bVId;
     }
 
-    auto mergedDepth = mergedEncounteredOps.size();
-
-    std::uint64_t mergedID = ++vertexId;
-
-    auto mergedVertex = std::make_shared<Vertex>(mergedID,
-                                                 a.parentId(),
-                                                 std::move(mergedMachinesSequences),
-                                                 std::move(mergedASAPST),
-                                                 std::move(mergedALAPST),
-                                                 std::move(mergedJobsCompletion),
-                                                 std::move(mergedJobOrder),
-                                                 std::move(mergedLastOperation),
-                                                 std::move(mergedScheduledOps),
-                                                 mergedDepth,
-                                                 std::move(mergedEncounteredOps));
+    auto mergedDepth = std::max(a.vertexDepth(), b.vertexDepth());
+
+    std::uint64_t mergedID = vertexId++;
+
+    auto mergedVertex = pool.make(Vertex(mergedID,
+                                         a.parentId(),
+                                         std::move(mergedMachinesSequences),
+                                         StateTimes::create(a.getTimes(),
+                                                            std::move(mergedASAPST),
+                                                            std::move(mergedALAPST)),
+                                         std::move(mergedJobsCompletion),
+                                         std::move(mergedJobOrder),
+                                         std::move(mergedLastOperation),
+                                         std::move(mergedScheduledOps),
+                                         mergedDepth));
     mergedVertex->setReadyOperations(
             problemInstance, true); // something clumsy about always having to do this extra step
+    mergedVertex->setRelaxed(true);
+    mergedVertex->setTranspositionHash(zobrist::hash(*mergedVertex));
     return mergedVertex;
 }
 
-std::uint32_t chooseVertexToMerge(std::uint32_t size) {
-    // chooses randomly for now
-    // other heuristics should be tried out
-    // return rand() % size;
-    return 0;
-}
-
 solvers::ResumableSolverOutput solveResumable(problem::Instance &problemInstance,
                                               problem::ProblemUpdate problemUpdate,
                                               const cli::CLIArgs &args,
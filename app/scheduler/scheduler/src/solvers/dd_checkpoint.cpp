@@ -0,0 +1,592 @@
+#include "fms/pch/containers.hpp"
+#include "fms/pch/utils.hpp"
+
+#include "fms/solvers/dd_checkpoint.hpp"
+
+#include "fms/cg/builder.hpp"
+#include "fms/scheduler_exception.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <type_traits>
+
+using namespace fms;
+using namespace fms::solvers::dd;
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'F', 'M', 'S', 'D', 'D', 'C', 'P', '\0'};
+constexpr std::uint32_t kVersion = 1;
+
+/// Index of the times of a state without parent times
+constexpr std::uint64_t kNoParent = std::numeric_limits<std::uint64_t>::max();
+
+/// @brief Consecutive vertices [first, first + count) whose time changed by diff
+struct Run {
+    std::uint64_t first;
+    std::uint64_t count;
+    /// Difference modulo 2^64, like in @ref StateTimes
+    std::uint64_t diff;
+};
+
+class Writer {
+public:
+    explicit Writer(std::ostream &out) : m_out(out) {}
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    void write(T value) {
+        m_out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename Tag, typename T> void write(utils::StrongType<Tag, T> value) {
+        write(value.value);
+    }
+
+    void write(std::string_view value) {
+        write<std::uint64_t>(value.size());
+        m_out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    template <typename T> void write(const std::vector<T> &values) {
+        write<std::uint64_t>(values.size());
+        for (const auto &value : values) {
+            write(value);
+        }
+    }
+
+    void write(const problem::Operation &op) {
+        write(op.jobId);
+        write(op.operationId);
+        write(op.maintId.has_value());
+        write(op.maintId.value_or(0));
+    }
+
+private:
+    std::ostream &m_out;
+};
+
+class Reader {
+public:
+    Reader(std::istream &in, const std::filesystem::path &file) : m_in(in), m_file(file) {}
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    [[nodiscard]] T read() {
+        T value{};
+        m_in.read(reinterpret_cast<char *>(&value), sizeof(T));
+        check();
+        return value;
+    }
+
+    template <typename T>
+        requires requires { typename T::ValueType; }
+    [[nodiscard]] T read() {
+        return T{read<typename T::ValueType>()};
+    }
+
+    template <typename T>
+        requires std::is_same_v<T, std::string>
+    [[nodiscard]] T read() {
+        std::string value(readSize(), '\0');
+        m_in.read(value.data(), static_cast<std::streamsize>(value.size()));
+        check();
+        return value;
+    }
+
+    template <typename T>
+        requires std::is_same_v<T, problem::Operation>
+    [[nodiscard]] T read() {
+        problem::Operation op{read<problem::JobId>(), read<problem::OperationId>(), std::nullopt};
+        const auto hasMaint = read<bool>();
+        const auto maintId = read<problem::MaintType>();
+        if (hasMaint) {
+            op.maintId = maintId;
+        }
+        return op;
+    }
+
+    /// @brief Reads a block of raw bytes preceded by its size
+    [[nodiscard]] std::vector<std::uint8_t> readBytes() {
+        std::vector<std::uint8_t> value(readSize());
+        m_in.read(reinterpret_cast<char *>(value.data()),
+                  static_cast<std::streamsize>(value.size()));
+        check();
+        return value;
+    }
+
+    template <typename T> [[nodiscard]] std::vector<T> readVector() {
+        std::vector<T> values(readSize());
+        for (auto &value : values) {
+            value = read<T>();
+        }
+        return values;
+    }
+
+    /// @brief Reads a number of elements, guarding against allocating garbage sizes
+    [[nodiscard]] std::size_t readSize() {
+        const auto size = read<std::uint64_t>();
+        if (size > kMaxSize) {
+            fail("is corrupted");
+        }
+        return size;
+    }
+
+    [[noreturn]] void fail(std::string_view reason) const {
+        throw FmsSchedulerException(
+                fmt::format("DD checkpoint {} {}", m_file.string(), reason));
+    }
+
+private:
+    static constexpr std::uint64_t kMaxSize = std::uint64_t{1} << 32U;
+
+    void check() const {
+        if (!m_in) {
+            fail("is truncated");
+        }
+    }
+
+    std::istream &m_in;
+    const std::filesystem::path &m_file;
+};
+
+void writeRuns(Writer &writer,
+               const algorithms::paths::PathTimes &parent,
+               const algorithms::paths::PathTimes &times) {
+    std::vector<Run> runs;
+    for (std::uint64_t v = 0; v < times.size(); ++v) {
+        if (times[v] == parent[v]) {
+            continue;
+        }
+        const auto diff =
+                static_cast<std::uint64_t>(times[v]) - static_cast<std::uint64_t>(parent[v]);
+        if (!runs.empty() && runs.back().first + runs.back().count == v
+            && runs.back().diff == diff) {
+            ++runs.back().count;
+        } else {
+            runs.push_back({v, 1, diff});
+        }
+    }
+
+    writer.write<std::uint64_t>(runs.size());
+    for (const auto &[first, count, diff] : runs) {
+        writer.write(first);
+        writer.write(count);
+        writer.write(diff);
+    }
+}
+
+void readRuns(Reader &reader, algorithms::paths::PathTimes &times) {
+    for (auto runs = reader.readSize(); runs > 0; --runs) {
+        const auto first = reader.read<std::uint64_t>();
+        const auto count = reader.read<std::uint64_t>();
+        const auto diff = reader.read<std::uint64_t>();
+        if (first > times.size() || count > times.size() - first) {
+            reader.fail("is corrupted");
+        }
+        for (auto v = first; v < first + count; ++v) {
+            times[v] = static_cast<delay>(static_cast<std::uint64_t>(times[v]) + diff);
+        }
+    }
+}
+
+/// @brief Numbers the times of the saved states, the parent times before their children
+class TimesTable {
+public:
+    void add(const dd::StateTimes::Ptr &times) {
+        if (times == nullptr || m_index.contains(times.get())) {
+            return;
+        }
+        add(times->parent());
+        m_index.emplace(times.get(), m_times.size());
+        m_times.push_back(times.get());
+    }
+
+    [[nodiscard]] std::uint64_t index(const dd::StateTimes::Ptr &times) const {
+        return m_index.at(times.get());
+    }
+
+    void write(Writer &writer) const {
+        writer.write<std::uint64_t>(m_times.size());
+        for (const auto *times : m_times) {
+            const auto decoded = times->decode();
+            if (times->isFull()) {
+                writer.write(kNoParent);
+                writer.write(decoded->ASAPST);
+                writer.write(decoded->ALAPST);
+                continue;
+            }
+
+            const auto &parent = times->parent();
+            const auto parentDecoded = parent->decode();
+            writer.write(index(parent));
+            writeRuns(writer, parentDecoded->ASAPST, decoded->ASAPST);
+            writeRuns(writer, parentDecoded->ALAPST, decoded->ALAPST);
+        }
+    }
+
+private:
+    std::unordered_map<const dd::StateTimes *, std::uint64_t> m_index;
+    std::vector<const dd::StateTimes *> m_times;
+};
+
+std::vector<dd::StateTimes::Ptr> readTimes(Reader &reader, std::size_t nrVertices) {
+    std::vector<dd::StateTimes::Ptr> allTimes(reader.readSize());
+    for (auto &times : allTimes) {
+        const auto parent = reader.read<std::uint64_t>();
+        if (parent == kNoParent) {
+            auto ASAPST = reader.readVector<delay>();
+            auto ALAPST = reader.readVector<delay>();
+            if (ASAPST.size() != nrVertices || ALAPST.size() != nrVertices) {
+                reader.fail("does not match the constraint graph");
+            }
+            times = dd::StateTimes::create(std::move(ASAPST), std::move(ALAPST));
+            continue;
+        }
+
+        // The parent times are always stored before their children
+        if (parent >= static_cast<std::uint64_t>(&times - allTimes.data())) {
+            reader.fail("is corrupted");
+        }
+        const auto &parentTimes = allTimes[parent];
+        const auto parentDecoded = parentTimes->decode();
+        auto ASAPST = parentDecoded->ASAPST;
+        auto ALAPST = parentDecoded->ALAPST;
+        readRuns(reader, ASAPST);
+        readRuns(reader, ALAPST);
+        times = dd::StateTimes::create(parentTimes, std::move(ASAPST), std::move(ALAPST));
+    }
+    return allTimes;
+}
+
+void writeVertex(Writer &writer, const dd::Vertex &vertex, const TimesTable &times) {
+    writer.write(vertex.id());
+    writer.write(vertex.parentId());
+    writer.write(times.index(vertex.getTimes()));
+    writer.write(vertex.vertexDepth());
+    writer.write(vertex.getTerminal());
+    writer.write(vertex.isRelaxed());
+
+    const auto &sequences = vertex.getMachinesSequences();
+    writer.write<std::uint64_t>(sequences.size());
+    for (const auto &[machine, sequence] : sequences) {
+        writer.write(machine);
+        writer.write(sequence);
+    }
+
+    writer.write(vertex.getJobsCompletion());
+    writer.write(vertex.getJobOrder());
+
+    const auto &lastOperation = vertex.getLastOperation();
+    writer.write<std::uint64_t>(lastOperation.size());
+    for (const auto &[machine, vId] : lastOperation) {
+        writer.write(machine);
+        writer.write(vId);
+    }
+
+    writer.write(vertex.scheduledOps());
+    // Empty when the encountered operations are the scheduled ones, as in the vertex
+    const auto &encounteredOps = vertex.encounteredOps();
+    writer.write(&encounteredOps == &vertex.scheduledOps() ? cg::VerticesIds{} : encounteredOps);
+}
+
+dd::Vertex readVertex(Reader &reader,
+                      const std::vector<dd::StateTimes::Ptr> &allTimes,
+                      const problem::Instance &problemInstance) {
+    const auto id = reader.read<dd::VertexId>();
+    const auto parentId = reader.read<dd::VertexId>();
+    const auto timesIndex = reader.read<std::uint64_t>();
+    if (timesIndex >= allTimes.size()) {
+        reader.fail("is corrupted");
+    }
+    const auto depth = reader.read<std::uint64_t>();
+    const auto terminal = reader.read<bool>();
+    const auto relaxed = reader.read<bool>();
+
+    dd::MachinesSequences sequences;
+    for (auto machines = reader.readSize(); machines > 0; --machines) {
+        const auto machine = reader.read<problem::MachineId>();
+        sequences[machine] = reader.readVector<problem::Operation>();
+    }
+
+    auto jobsCompletion = reader.readVector<std::size_t>();
+    if (jobsCompletion.size() != problemInstance.jobs().size()) {
+        reader.fail("does not match the jobs of the instance");
+    }
+    auto jobOrder = reader.readVector<problem::JobId>();
+
+    dd::MachineToVertex lastOperation;
+    for (auto machines = reader.readSize(); machines > 0; --machines) {
+        const auto machine = reader.read<problem::MachineId>();
+        lastOperation[machine] = reader.read<cg::VertexId>();
+    }
+
+    auto scheduledOps = reader.readVector<cg::VertexId>();
+    auto encounteredOps = reader.readVector<cg::VertexId>();
+
+    dd::Vertex vertex(id,
+                      parentId,
+                      std::move(sequences),
+                      allTimes[timesIndex],
+                      std::move(jobsCompletion),
+                      std::move(jobOrder),
+                      std::move(lastOperation),
+                      std::move(scheduledOps),
+                      depth,
+                      std::move(encounteredOps));
+    vertex.setTerminal(terminal);
+    vertex.setRelaxed(relaxed);
+    // The ready operations and the hash only depend on the other fields, so they are not stored
+    vertex.setReadyOperations(problemInstance, relaxed);
+    vertex.setTranspositionHash(dd::zobrist::hash(vertex));
+    return vertex;
+}
+
+/// @brief Describes the instance so that a checkpoint is not resumed with another one
+void writeInstance(Writer &writer,
+                   const problem::Instance &problemInstance,
+                   const cg::ConstraintGraph &dg) {
+    writer.write(problemInstance.getProblemName());
+    writer.write(problemInstance.shopType().shortName());
+    writer.write<std::uint64_t>(problemInstance.jobs().size());
+    writer.write<std::uint64_t>(problemInstance.getTotalOps());
+    writer.write<std::uint64_t>(dg.getNumberOfVertices());
+}
+
+void checkInstance(Reader &reader,
+                   const problem::Instance &problemInstance,
+                   const cg::ConstraintGraph &dg) {
+    const auto name = reader.read<std::string>();
+    const auto shopType = reader.read<std::string>();
+    const auto nrJobs = reader.read<std::uint64_t>();
+    const auto totalOps = reader.read<std::uint64_t>();
+    const auto nrVertices = reader.read<std::uint64_t>();
+    if (name != problemInstance.getProblemName()
+        || shopType != problemInstance.shopType().shortName()
+        || nrJobs != problemInstance.jobs().size() || totalOps != problemInstance.getTotalOps()
+        || nrVertices != dg.getNumberOfVertices()) {
+        reader.fail(fmt::format("was saved for instance '{}' ({} shop)", name, shopType));
+    }
+}
+
+} // namespace
+
+namespace fms::solvers::dd {
+
+void saveCheckpoint(const DDSolverData &data,
+                    const problem::Instance &problemInstance,
+                    const std::filesystem::path &file) {
+    LOG("Saving DD checkpoint to {}", file.string());
+
+    // The states of the queue and of the dominance store, each one once. They are keyed by address
+    // as in TimesTable, so that the index does not rely on the ids of the states being unique.
+    std::vector<const Vertex *> vertices;
+    std::unordered_map<const Vertex *, std::uint64_t> vertexIndex;
+    const auto addVertex = [&](const SharedVertex &vertex) {
+        if (vertexIndex.emplace(vertex.get(), vertices.size()).second) {
+            vertices.push_back(vertex.get());
+        }
+    };
+    data.states.forEach(addVertex);
+    data.activeVertices.forEach(addVertex);
+
+    TimesTable times;
+    for (const auto *vertex : vertices) {
+        times.add(vertex->getTimes());
+    }
+    const auto &terminated = data.solution.getStatesTerminated();
+    for (const auto &vertex : terminated) {
+        times.add(vertex.getTimes());
+    }
+
+    const auto tmpFile = std::filesystem::path(file).concat(".tmp");
+    {
+        std::ofstream out(tmpFile, std::ios::binary | std::ios::out | std::ios::trunc);
+        if (!out) {
+            throw FmsSchedulerException(
+                    fmt::format("Unable to write the DD checkpoint {}", tmpFile.string()));
+        }
+        Writer writer(out);
+        out.write(kMagic.data(), kMagic.size());
+        writer.write(kVersion);
+        writeInstance(writer, problemInstance, data.dg);
+        writer.write(data.explorationType.shortName());
+
+        const auto &solution = data.solution;
+        writer.write(data.nextVertexId);
+        writer.write(solution.rankFactor());
+        writer.write(solution.bestUpperBound());
+        writer.write(solution.bestLowerBound());
+        writer.write(solution.isOptimal());
+        const auto solveData = nlohmann::json::to_cbor(solution.getSolveData());
+        writer.write<std::uint64_t>(solveData.size());
+        out.write(reinterpret_cast<const char *>(solveData.data()),
+                  static_cast<std::streamsize>(solveData.size()));
+        writer.write(data.keepActiveVerticesSparse);
+        writer.write<std::uint64_t>(data.layerStatesLeft);
+        writer.write(data.discardedLowerBound);
+
+        times.write(writer);
+
+        writer.write<std::uint64_t>(terminated.size());
+        for (const auto &vertex : terminated) {
+            writeVertex(writer, vertex, times);
+        }
+
+        writer.write<std::uint64_t>(vertices.size());
+        for (const auto *vertex : vertices) {
+            writeVertex(writer, *vertex, times);
+        }
+
+        // The queue and the store are restored in the order in which they are visited
+        writer.write<std::uint64_t>(data.states.size());
+        data.states.forEach(
+                [&](const SharedVertex &vertex) { writer.write(vertexIndex.at(vertex.get())); });
+        writer.write<std::uint64_t>(data.activeVertices.size());
+        data.activeVertices.forEach(
+                [&](const SharedVertex &vertex) { writer.write(vertexIndex.at(vertex.get())); });
+
+        out.close();
+        if (!out) {
+            throw FmsSchedulerException(
+                    fmt::format("Unable to write the DD checkpoint {}", tmpFile.string()));
+        }
+    }
+    std::filesystem::rename(tmpFile, file);
+}
+
+DDSolverDataPtr loadCheckpoint(const std::filesystem::path &file,
+                               const cli::CLIArgs &args,
+                               problem::Instance &problemInstance) {
+    LOG("Resuming DD search from checkpoint {}", file.string());
+
+    std::ifstream in(file, std::ios::binary | std::ios::in);
+    if (!in) {
+        throw FmsSchedulerException(
+                fmt::format("Unable to open the DD checkpoint {}", file.string()));
+    }
+    Reader reader(in, file);
+
+    std::array<char, kMagic.size()> magic{};
+    in.read(magic.data(), magic.size());
+    if (!in || magic != kMagic) {
+        reader.fail("is not a DD checkpoint");
+    }
+    if (reader.read<std::uint32_t>() != kVersion) {
+        reader.fail("was written by an unsupported version");
+    }
+
+    auto dg = cg::Builder::jobShop(problemInstance);
+    problemInstance.updateDelayGraph(dg);
+    checkInstance(reader, problemInstance, dg);
+    if (reader.read<std::string>() != args.explorationType.shortName()) {
+        reader.fail("was saved with another exploration type");
+    }
+
+    const auto nextVertexId = reader.read<std::uint64_t>();
+    const auto rankFactor = reader.read<float>();
+    const auto bestUpperBound = reader.read<delay>();
+    const auto bestLowerBound = reader.read<delay>();
+    const auto optimal = reader.read<bool>();
+    const auto solveDataBytes = reader.readBytes();
+    auto solveData = nlohmann::json::from_cbor(solveDataBytes, true, false);
+    if (solveData.is_discarded()) {
+        reader.fail("is corrupted");
+    }
+    const auto keepActiveVerticesSparse = reader.read<bool>();
+    const auto layerStatesLeft = reader.read<std::uint64_t>();
+    const auto discardedLowerBound = reader.read<delay>();
+
+    const auto allTimes = readTimes(reader, dg.getNumberOfVertices());
+
+    std::vector<Vertex> terminated;
+    const auto nrTerminated = reader.readSize();
+    terminated.reserve(nrTerminated);
+    for (std::size_t i = 0; i < nrTerminated; ++i) {
+        terminated.push_back(readVertex(reader, allTimes, problemInstance));
+    }
+
+    std::vector<Vertex> vertices;
+    const auto nrVertices = reader.readSize();
+    vertices.reserve(nrVertices);
+    for (std::size_t i = 0; i < nrVertices; ++i) {
+        vertices.push_back(readVertex(reader, allTimes, problemInstance));
+    }
+
+    const bool storeAllStates =
+            std::find(args.algorithmOptions.begin(), args.algorithmOptions.end(), kStoreHistory)
+            != args.algorithmOptions.end();
+    DDSolution solution(std::chrono::steady_clock::now(),
+                        rankFactor,
+                        problemInstance.getTotalOps(),
+                        std::move(terminated),
+                        bestUpperBound,
+                        bestLowerBound,
+                        std::move(solveData),
+                        optimal);
+    auto data = std::make_unique<DDSolverData>(args.explorationType,
+                                               std::move(solution),
+                                               std::move(dg),
+                                               keepActiveVerticesSparse,
+                                               storeAllStates,
+                                               std::deque<SharedVertex>{},
+                                               nextVertexId);
+
+    // A state in both the queue and the store must stay a single vertex
+    std::vector<SharedVertex> shared(vertices.size());
+    const auto readShared = [&]() -> const SharedVertex & {
+        const auto index = reader.read<std::uint64_t>();
+        if (index >= vertices.size()) {
+            reader.fail("is corrupted");
+        }
+        auto &vertex = shared[index];
+        if (vertex == nullptr) {
+            vertex = data->pool->make(std::move(vertices[index]));
+        }
+        return vertex;
+    };
+    for (auto states = reader.readSize(); states > 0; --states) {
+        data->states.push(readShared());
+    }
+    for (auto states = reader.readSize(); states > 0; --states) {
+        data->activeVertices.insert(readShared(), problemInstance);
+    }
+
+    // The restored states start the history of the resumed search. They are stored by increasing
+    // id, like the states created afterwards.
+    if (!args.historyFile.empty()) {
+        data->history = std::make_shared<HistoryWriter>(args.historyFile);
+    }
+    std::vector<SharedVertex> restored;
+    restored.reserve(data->states.size());
+    data->states.forEach([&restored](const SharedVertex &vertex) { restored.push_back(vertex); });
+    std::sort(restored.begin(), restored.end(), [](const auto &a, const auto &b) {
+        return a->id() < b->id();
+    });
+    for (const auto &vertex : restored) {
+        data->storeState(vertex);
+    }
+    if (args.transpositionMemory > 0) {
+        data->transpositions =
+                std::make_shared<TranspositionTable>(std::size_t{args.transpositionMemory} << 20U);
+    }
+
+    if (args.explorationType.isWidthBounded()) {
+        if (args.maxWidth == 0) {
+            throw std::runtime_error("FmsScheduler::the maximum width of the DD must be positive");
+        }
+        data->maxWidth = args.maxWidth;
+        data->layerStatesLeft = layerStatesLeft;
+    }
+    data->discardedLowerBound = discardedLowerBound;
+
+    LOG("Resumed {} states with {} solutions",
+        data->states.size(),
+        data->solution.getStatesTerminated().size());
+    return data;
+}
+
+} // namespace fms::solvers::dd
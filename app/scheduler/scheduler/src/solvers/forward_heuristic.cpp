@@ -6,6 +6,7 @@
 #include "fms/algorithms/longest_path.hpp"
 #include "fms/cg/constraint_graph.hpp"
 #include "fms/cg/export_utilities.hpp"
+#include "fms/cg/graph_overlay.hpp"
 #include "fms/problem/flow_shop.hpp"
 #include "fms/solvers/maintenance_heuristic.hpp"
 #include "fms/solvers/utils.hpp"
@@ -14,12 +15,127 @@
 
 namespace fms::solvers::forward {
 
+namespace {
+/// @brief Adds the edges of an interleaving to a copy of @p base , an overlay without edits
+algorithms::paths::LongestPathResult validateInterleaving(const cg::GraphOverlay &base,
+                                                          const problem::Instance &problem,
+                                                          const cg::Edges &inputEdges,
+                                                          std::vector<delay> &ASAPST,
+                                                          const cg::VerticesCRef &sources,
+                                                          const cg::VerticesCRef &window,
+                                                          algorithms::paths::CycleReport report) {
+    const auto &dg = base.getBase();
+    const auto &maintPolicy = problem.maintenancePolicy();
+    // the edges are only added to an overlay so the shared graph is never modified
+    cg::GraphOverlay overlay(base);
+    for (const auto &i : inputEdges) {
+        if (!overlay.hasEdge(i.src, i.dst)) {
+            overlay.addEdges(i);
+        }
+        if (dg.getOperation(i.src).isMaintenance()) {
+            delay dueWeight = maintPolicy.getMaintDuration((dg.getVertex(i.src)).operation)
+                              + maintPolicy.getMinimumIdle() - 1;
+            overlay.addEdge(i.dst, i.src, -dueWeight);
+        }
+    }
+
+    // Compute the updated ASAP times and check the bounds
+    return algorithms::paths::computeASAPST(overlay, ASAPST, sources, window, report);
+}
+
+/// @brief Evaluates the options on copies of @p base , an overlay without edits
+std::vector<std::pair<PartialSolution, SchedulingOption>>
+evaluateOptionFeasibility(const cg::GraphOverlay &base,
+                          const problem::Instance &problem,
+                          const PartialSolution &solution,
+                          const std::vector<SchedulingOption> &options,
+                          const std::vector<delay> &ASAPTimes,
+                          problem::MachineId reEntrantMachine) {
+    const auto &dg = base.getBase();
+    unsigned int nrFeasibleOptions = 0;
+    unsigned int nrInfeasibleOptions = 0;
+
+    const auto firstJobId = problem.getJobsOutput().front();
+    const auto firstOp = problem.jobs(firstJobId).front();
+
+    std::vector<std::pair<PartialSolution, SchedulingOption>> newGenerationOfSolutions;
+    for (const SchedulingOption &o : options) {
+        // create a local copy that we can modify without issues
+        std::vector<delay> ASAPST = ASAPTimes;
+
+        // Add the edges from the options to the list. ASAPTimes are not (yet) valid for the updated
+        // solution... but we will use them only for the chosen edges.
+        PartialSolution ps = solution.add(reEntrantMachine, o, ASAPTimes);
+
+        // make a copy of the chosen edges
+        cg::Edges final_sequence = ps.getAllAndInferredEdges(problem);
+
+        const auto &curV = dg.getVertex(o.curO);
+        const auto &nextV = dg.getVertex(o.nextO);
+
+        LOG_D(FMT_COMPILE("Checking feasibility of interleaving {} between {} and "
+                          "{}"),
+              o.curO,
+              o.prevO,
+              o.nextO);
+        const problem::JobId jobStart = o.curO.jobId;
+
+        cg::VerticesCRef origin{dg.getVertex(firstOp)};
+        cg::VerticesCRef sourcevertices =
+                (jobStart == firstOp.jobId)
+                        ? origin
+                        : dg.getVerticesC(std::max(jobStart, problem::JobId(1)) - 1);
+        cg::VerticesCRef windowvertices = dg.getVerticesC(jobStart, o.nextO.jobId);
+
+        auto m = dg.getMaintVertices();
+        windowvertices.insert(windowvertices.end(), m.begin(), m.end());
+
+        auto result = validateInterleaving(base,
+                                           problem,
+                                           final_sequence,
+                                           ASAPST,
+                                           sourcevertices,
+                                           windowvertices,
+                                           algorithms::paths::CycleReport::VIOLATED_EDGES);
+
+        delay interleaved_starting_time = ASAPST[curV.id];
+
+        if (result.positiveCycle.empty()) {
+            PartialSolution p_sol = solution.add(reEntrantMachine, o, ASAPST);
+            p_sol.setMakespanLastScheduledJob(interleaved_starting_time);
+
+            // set the (relaxed) starting time of the interleaved operation and remaining
+            // flexibility
+            auto [avgProd, nrJobs] =
+                    computeFutureAvgProductivy(dg, ASAPST, p_sol, reEntrantMachine);
+
+            p_sol.setAverageProductivity(avgProd / nrJobs);
+            p_sol.setNrOpsInLoop(nrJobs);
+            p_sol.setEarliestStartFutureOperation(ASAPST[nextV.id]);
+
+            newGenerationOfSolutions.emplace_back(p_sol, o);
+            nrFeasibleOptions++;
+        } else {
+            LOG_D(FMT_COMPILE("Skipping infeasible option {}->{}->{} with partial makespan "),
+                  o.prevO,
+                  o.curO,
+                  o.nextO,
+                  interleaved_starting_time);
+            nrInfeasibleOptions++;
+        }
+    }
+    LOG_D(FMT_COMPILE("Infeasible: {}"), nrInfeasibleOptions);
+    return newGenerationOfSolutions;
+}
+} // namespace
+
 PartialSolution solve(problem::Instance &problemInstance, const cli::CLIArgs &args) {
     // solve the instance
     LOG("Computation of the schedule started");
 
-    auto ASAPST = SolversUtils::initProblemGraph(problemInstance, IS_LOG_D());
+    auto ASAPST = SolversUtils::initProblemGraph(problemInstance, IS_LOG_D(), args.pathThreads);
     auto dg = problemInstance.getDelayGraph();
+    cg::CSRGraph csr(dg);
     LOG("Number of vertices in the delay graph is {}", dg.getNumberOfVertices());
 
     // We only support a single re-entrant machine in the system so choose the first one
@@ -40,7 +156,8 @@ PartialSolution solve(problem::Instance &problemInstance, const cli::CLIArgs &ar
 
         // First operation is already included in the initial sequence
         for (std::size_t i = 1; i < jobOps.size(); ++i) {
-            solution = scheduleOneOperation(dg, problemInstance, solution, jobOps.at(i), args);
+            solution =
+                    scheduleOneOperation(dg, csr, problemInstance, solution, jobOps.at(i), args);
         }
     }
 
@@ -189,7 +306,7 @@ createOptions(const problem::Instance &problem,
 }
 
 std::optional<std::pair<PartialSolution, SchedulingOption>>
-evaluateOptionFeasibility(cg::ConstraintGraph &dg,
+evaluateOptionFeasibility(const cg::ConstraintGraph &dg,
                           const problem::Instance &problem,
                           const PartialSolution &solution,
                           const SchedulingOption &options,
@@ -204,81 +321,26 @@ evaluateOptionFeasibility(cg::ConstraintGraph &dg,
 }
 
 std::vector<std::pair<PartialSolution, SchedulingOption>>
-evaluateOptionFeasibility(cg::ConstraintGraph &dg,
+evaluateOptionFeasibility(const cg::ConstraintGraph &dg,
                           const problem::Instance &problem,
                           const PartialSolution &solution,
                           const std::vector<SchedulingOption> &options,
                           const std::vector<delay> &ASAPTimes,
                           problem::MachineId reEntrantMachine) {
-    unsigned int nrFeasibleOptions = 0;
-    unsigned int nrInfeasibleOptions = 0;
-
-    const auto firstJobId = problem.getJobsOutput().front();
-    const auto firstOp = problem.jobs(firstJobId).front();
-
-    std::vector<std::pair<PartialSolution, SchedulingOption>> newGenerationOfSolutions;
-    for (const SchedulingOption &o : options) {
-        // create a local copy that we can modify without issues
-        std::vector<delay> ASAPST = ASAPTimes;
-
-        // Add the edges from the options to the list. ASAPTimes are not (yet) valid for the updated
-        // solution... but we will use them only for the chosen edges.
-        PartialSolution ps = solution.add(reEntrantMachine, o, ASAPTimes);
-
-        // make a copy of the chosen edges
-        cg::Edges final_sequence = ps.getAllAndInferredEdges(problem);
-
-        const auto &curV = dg.getVertex(o.curO);
-        const auto &nextV = dg.getVertex(o.nextO);
-
-        LOG_D(FMT_COMPILE("Checking feasibility of interleaving {} between {} and "
-                          "{}"),
-              o.curO,
-              o.prevO,
-              o.nextO);
-        const problem::JobId jobStart = o.curO.jobId;
-
-        cg::VerticesCRef origin{dg.getVertex(firstOp)};
-        cg::VerticesCRef sourcevertices =
-                (jobStart == firstOp.jobId)
-                        ? origin
-                        : dg.getVerticesC(std::max(jobStart, problem::JobId(1)) - 1);
-        cg::VerticesCRef windowvertices = dg.getVerticesC(jobStart, o.nextO.jobId);
-
-        auto m = dg.getMaintVertices();
-        windowvertices.insert(windowvertices.end(), m.begin(), m.end());
-
-        auto result = validateInterleaving(
-                dg, problem, final_sequence, ASAPST, sourcevertices, windowvertices);
-
-        delay interleaved_starting_time = ASAPST[curV.id];
-
-        if (result.positiveCycle.empty()) {
-            PartialSolution p_sol = solution.add(reEntrantMachine, o, ASAPST);
-            p_sol.setMakespanLastScheduledJob(interleaved_starting_time);
-
-            // set the (relaxed) starting time of the interleaved operation and remaining
-            // flexibility
-            auto [avgProd, nrJobs] =
-                    computeFutureAvgProductivy(dg, ASAPST, p_sol, reEntrantMachine);
-
-            p_sol.setAverageProductivity(avgProd / nrJobs);
-            p_sol.setNrOpsInLoop(nrJobs);
-            p_sol.setEarliestStartFutureOperation(ASAPST[nextV.id]);
+    return evaluateOptionFeasibility(
+            cg::GraphOverlay(dg), problem, solution, options, ASAPTimes, reEntrantMachine);
+}
 
-            newGenerationOfSolutions.emplace_back(p_sol, o);
-            nrFeasibleOptions++;
-        } else {
-            LOG_D(FMT_COMPILE("Skipping infeasible option {}->{}->{} with partial makespan "),
-                  o.prevO,
-                  o.curO,
-                  o.nextO,
-                  interleaved_starting_time);
-            nrInfeasibleOptions++;
-        }
-    }
-    LOG_D(FMT_COMPILE("Infeasible: {}"), nrInfeasibleOptions);
-    return newGenerationOfSolutions;
+std::vector<std::pair<PartialSolution, SchedulingOption>>
+evaluateOptionFeasibility(const cg::ConstraintGraph &dg,
+                          const cg::CSRGraph &csr,
+                          const problem::Instance &problem,
+                          const PartialSolution &solution,
+                          const std::vector<SchedulingOption> &options,
+                          const std::vector<delay> &ASAPTimes,
+                          problem::MachineId reEntrantMachine) {
+    return evaluateOptionFeasibility(
+            cg::GraphOverlay(dg, csr), problem, solution, options, ASAPTimes, reEntrantMachine);
 }
 
 delay determineSmallestDeadline(const cg::Vertex &v) {
@@ -294,6 +356,7 @@ delay determineSmallestDeadline(const cg::Vertex &v) {
 }
 
 PartialSolution scheduleOneOperation(cg::ConstraintGraph &dg,
+                                     cg::CSRGraph &csr,
                                      problem::Instance &problem,
                                      const PartialSolution &solution,
                                      const problem::Operation &eligibleOperation,
@@ -305,14 +368,14 @@ PartialSolution scheduleOneOperation(cg::ConstraintGraph &dg,
 
     auto reEntrantMachineId = problem.getMachine(eligibleOperation);
     auto [solutions, minSolId] =
-            getFeasibleOptions(dg, problem, dg.getVertex(eligibleOperation), solution, args);
+            getFeasibleOptions(dg, csr, problem, dg.getVertex(eligibleOperation), solution, args);
 
     LOG_D(FMT_COMPILE("*** nr option: {}"), solutions.size());
 
     if (!minSolId.has_value()) { // none of the solutions were feasible...
         const auto allEdges = solution.getAllChosenEdges(problem);
         // create a local copy that we can modify without issues
-        auto result = algorithms::paths::getPositiveCycle(dg, allEdges);
+        auto result = algorithms::paths::getPositiveCycle(csr, allEdges);
         cg::exports::saveAsDot(problem,
                                solution,
                                fmt::format("infeasible_{}.dot", problem.getProblemName()),
@@ -328,6 +391,7 @@ PartialSolution scheduleOneOperation(cg::ConstraintGraph &dg,
 
     if (newDg) {
         dg = std::move(*newDg);
+        csr = cg::CSRGraph(dg);
         problem.updateDelayGraph(dg);
     }
     a_clock::time_point end = a_clock::now();
@@ -340,7 +404,7 @@ PartialSolution scheduleOneOperation(cg::ConstraintGraph &dg,
 }
 
 std::pair<delay, unsigned int>
-computeFutureAvgProductivy(cg::ConstraintGraph &dg,
+computeFutureAvgProductivy(const cg::ConstraintGraph &dg,
                            const std::vector<delay> &ASAPST,
                            const PartialSolution &ps,
                            const problem::MachineId reEntrantMachineId) {
@@ -361,35 +425,27 @@ computeFutureAvgProductivy(cg::ConstraintGraph &dg,
     return {used_buffer_time, nrOps};
 }
 
-algorithms::paths::LongestPathResult validateInterleaving(cg::ConstraintGraph &dg,
+algorithms::paths::LongestPathResult validateInterleaving(const cg::ConstraintGraph &dg,
                                                           const problem::Instance &problem,
                                                           const cg::Edges &inputEdges,
                                                           std::vector<delay> &ASAPST,
                                                           const cg::VerticesCRef &sources,
-                                                          const cg::VerticesCRef &window) {
-    const auto &maintPolicy = problem.maintenancePolicy();
-    cg::Edges edges;
-    // insert the edges to the graph
-    for (const auto &i : inputEdges) {
-        if (!dg.hasEdge(i.src, i.dst)) {
-            dg.addEdges(i);
-            edges.emplace_back(i);
-        }
-        if (dg.getOperation(i.src).isMaintenance()) {
-            delay dueWeight = maintPolicy.getMaintDuration((dg.getVertex(i.src)).operation)
-                              + maintPolicy.getMinimumIdle() - 1;
-            edges.emplace_back(dg.addEdge(i.dst, i.src, -dueWeight));
-        }
-    }
-
-    // Compute the updated ASAP times and check the bounds
-    auto result = algorithms::paths::computeASAPST(dg, ASAPST, sources, window);
-
-    for (const auto &i : edges) {
-        dg.removeEdge(i);
-    }
+                                                          const cg::VerticesCRef &window,
+                                                          algorithms::paths::CycleReport report) {
+    return validateInterleaving(
+            cg::GraphOverlay(dg), problem, inputEdges, ASAPST, sources, window, report);
+}
 
-    return result;
+algorithms::paths::LongestPathResult validateInterleaving(const cg::ConstraintGraph &dg,
+                                                          const cg::CSRGraph &csr,
+                                                          const problem::Instance &problem,
+                                                          const cg::Edges &inputEdges,
+                                                          std::vector<delay> &ASAPST,
+                                                          const cg::VerticesCRef &sources,
+                                                          const cg::VerticesCRef &window,
+                                                          algorithms::paths::CycleReport report) {
+    return validateInterleaving(
+            cg::GraphOverlay(dg, csr), problem, inputEdges, ASAPST, sources, window, report);
 }
 std::optional<std::size_t> rankSolutionsASAP(
         std::vector<
@@ -518,6 +574,7 @@ std::optional<std::size_t> rankSolutions(
 std::tuple<std::vector<std::tuple<PartialSolution, std::shared_ptr<cg::ConstraintGraph>>>,
            std::optional<std::size_t>>
 getFeasibleOptions(cg::ConstraintGraph &dg,
+                   const cg::CSRGraph &csr,
                    problem::Instance &problem,
                    const cg::Vertex &eligibleOperation,
                    const PartialSolution &solution,
@@ -534,14 +591,14 @@ getFeasibleOptions(cg::ConstraintGraph &dg,
     std::vector<delay> ASAPTimes = solution.getASAPST();
 
     algorithms::paths::computeASAPST(
-            dg,
+            csr,
             ASAPTimes,
             dg.getVerticesC(std::max(job_start, problem::JobId(1U)) - 1),
             dg.getVerticesC(job_start, lastPotentiallyFeasibleOption.jobId));
 
     std::vector<std::pair<PartialSolution, SchedulingOption>> generationOfSolutions =
             evaluateOptionFeasibility(
-                    dg, problem, solution, options, ASAPTimes, reEntrantMachineId);
+                    dg, csr, problem, solution, options, ASAPTimes, reEntrantMachineId);
     std::vector<std::tuple<PartialSolution, SchedulingOption, std::shared_ptr<cg::ConstraintGraph>>>
             newGenerationOfSolutions;
 
@@ -3,9 +3,13 @@
 #include "fms/solvers/maintenance_heuristic.hpp"
 
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
+#include "fms/cg/graph_overlay.hpp"
 #include "fms/problem/indices.hpp"
 #include "fms/solvers/repair_schedule.hpp"
 
+#include <optional>
+
 namespace fms::solvers::maintenance {
 
 /*
@@ -261,20 +265,24 @@ algorithms::paths::LongestPathResult
 recomputeSchedule(const problem::Instance &problemInstance,
                   PartialSolution &schedule,
                   const problem::MaintenancePolicy &maintPolicy,
-                  cg::ConstraintGraph &dg,
+                  const cg::ConstraintGraph &dg,
                   const Sequence &inputSequence,
                   std::vector<delay> &ASAPST,
                   const cg::VerticesCRef &sources,
                   const cg::VerticesCRef &window) {
     problem::MachineId machine = problemInstance.getMachine(inputSequence[0]);
-    std::vector<cg::Edge> addedEdges;
+    // The graph has just been given a maintenance vertex, so no earlier snapshot of it can be
+    // reused. Sweeping the whole graph pays for taking one, a window only visits a few jobs.
+    const auto csr = window.empty() ? std::optional<cg::CSRGraph>(dg) : std::nullopt;
+    // the sequence is only added to an overlay so the graph is never modified
+    cg::GraphOverlay overlay = csr ? cg::GraphOverlay(dg, *csr) : cg::GraphOverlay(dg);
 
-    std::reference_wrapper<cg::Vertex> previous = dg.getSource(machine);
+    std::reference_wrapper<const cg::Vertex> previous = dg.getSource(machine);
     for (std::size_t i = 0; i < inputSequence.size(); i++) {
         const auto &op = inputSequence[i];
-        auto &v = dg.getVertex(op);
+        const auto &v = dg.getVertex(op);
 
-        if (!dg.hasEdge(previous, v)) {
+        if (!overlay.hasEdge(previous.get().id, v.id)) {
             delay weight{};
             if (op.isMaintenance()) {
                 // Adding a maintenance operation extends the duration between the previous
@@ -287,15 +295,13 @@ recomputeSchedule(const problem::Instance &problemInstance,
             } else {
                 weight = problemInstance.query(previous, v);
             }
-            cg::Edge e = dg.addEdge(previous.get(), v, weight);
-            addedEdges.push_back(e);
+            overlay.addEdge(previous.get(), v, weight);
         }
 
         if (previous.get().operation.isMaintenance()) {
             delay dueWeight = maintPolicy.getMaintDuration(previous.get().operation)
                               + maintPolicy.getMinimumIdle() - 1;
-            cg::Edge dueEdge = dg.addEdge(v, previous, -dueWeight);
-            addedEdges.push_back(dueEdge);
+            overlay.addEdge(v, previous.get(), -dueWeight);
         }
 
         previous = v;
@@ -304,15 +310,11 @@ recomputeSchedule(const problem::Instance &problemInstance,
     algorithms::paths::LongestPathResult result;
 
     if (window.empty()) {
-        result = algorithms::paths::computeASAPST(dg, ASAPST);
+        result = algorithms::paths::computeASAPST(overlay, ASAPST);
     } else {
-        result = algorithms::paths::computeASAPST(dg, ASAPST, sources, window);
+        result = algorithms::paths::computeASAPST(overlay, ASAPST, sources, window);
     }
     schedule.setASAPST(ASAPST);
-
-    for (const auto &i : addedEdges) {
-        dg.removeEdge(i);
-    }
     return result;
 }
 
@@ -6,8 +6,10 @@
 #include "fms/algorithms/longest_path.hpp"
 #include "fms/cg/builder.hpp"
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
 #include "fms/cg/edge.hpp"
 #include "fms/cg/export_utilities.hpp"
+#include "fms/cg/graph_overlay.hpp"
 #include "fms/problem/flow_shop.hpp"
 #include "fms/problem/indices.hpp"
 #include "fms/problem/operation.hpp"
@@ -16,6 +18,12 @@
 #include "fms/solvers/forward_heuristic.hpp"
 #include "fms/solvers/maintenance_heuristic.hpp"
 #include "fms/solvers/utils.hpp"
+#include "fms/utils/task_workers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <span>
 
 using namespace fms;
 using namespace fms::solvers;
@@ -84,6 +92,163 @@ Sequence obtainInitialSequenceInternal(problem::Instance &problem,
     }
 }
 
+/**
+ * @brief Evaluates the insertions of an operation from the times of the sequence before them
+ * @details Taillard's acceleration of NEH on the constraint graph: the candidate sequences of an
+ * insertion share their edges up to the insertion point, so the longest paths of the graph with
+ * these edges are kept in a @ref Prefix that is extended edge by edge while the insertion point
+ * moves forward. A candidate only propagates its remaining edges from these times, which are a
+ * lower bound of its own because its graph contains all their edges.
+ *
+ * The edges are propagated in the order of the sequence and the times only increase, so the time
+ * of the last sequenced operation plus its tail, the longest path to the last operation along the
+ * rest of the sequence, bounds the makespan of the candidate. It is abandoned as soon as this
+ * bound exceeds the cutoff.
+ */
+class InsertionEvaluator {
+public:
+    /// @brief Times of the graph with the fixed edges and the first edges of a sequence
+    struct Prefix {
+        cg::GraphOverlay graph;
+        algorithms::paths::PathTimes ASAPST;
+        /// Number of edges of the sequence in the graph
+        std::size_t length;
+        bool feasible;
+    };
+
+    /// @param fixedEdges Edges shared by all the candidates, e.g. the inferred input sequence
+    InsertionEvaluator(const problem::Instance &problem,
+                       const cg::ConstraintGraph &dg,
+                       const cg::Edges &fixedEdges) :
+        m_graph(dg) {
+        m_graph.addEdges(fixedEdges);
+        m_ASAPST = algorithms::paths::initializeASAPST(dg);
+        m_feasible = !algorithms::paths::computeASAPST(m_graph, m_ASAPST).hasPositiveCycle();
+
+        const auto lastOp = problem.jobs(problem.getJobsOutput().back()).back();
+        m_last = dg.getVertex(lastOp).id;
+        m_lastProcessingTime = problem.processingTimes(lastOp);
+
+        // The latest start times relative to the last operation are the opposite of the tails
+        auto ALAPST = algorithms::paths::initializeALAPST(dg, {}, false);
+        ALAPST[m_last] = 0;
+        const auto result = algorithms::paths::computeALAPST(m_graph, ALAPST, {m_last});
+        m_feasible = m_feasible && !result.hasPositiveCycle();
+
+        m_tails.resize(ALAPST.size(), kNoTail);
+        for (std::size_t v = 0; v < ALAPST.size(); ++v) {
+            if (ALAPST[v] != algorithms::paths::kALAPStartValue) {
+                m_tails[v] = -ALAPST[v];
+            }
+        }
+    }
+
+    [[nodiscard]] Prefix createPrefix() const { return {m_graph, m_ASAPST, 0, m_feasible}; }
+
+    /// @brief Adds the edges of @p edges to @p prefix until it contains the first @p length ones
+    void extend(Prefix &prefix, const cg::Edges &edges, std::size_t length) const {
+        for (; prefix.feasible && prefix.length < length; prefix.length++) {
+            const auto &e = edges[prefix.length];
+            if (!prefix.graph.hasEdge(e)) {
+                prefix.feasible = !algorithms::paths::addOneEdgeIncrementalASAPST(
+                        prefix.graph, e, prefix.ASAPST);
+                prefix.graph.addEdges(e);
+            }
+        }
+    }
+
+    /**
+     * @brief Tails of the destinations of @p edges , consecutive edges of a sequence
+     * @param next Edge that follows @p edges in the sequence, if any
+     * @param nextTail Tail of the destination of @p next
+     */
+    [[nodiscard]] std::vector<delay> computeTails(std::span<const cg::Edge> edges,
+                                                  const cg::Edge *next = nullptr,
+                                                  delay nextTail = kNoTail) const {
+        std::vector<delay> tails(edges.size());
+        for (std::size_t i = edges.size(); i-- > 0;) {
+            tails[i] = next != nullptr ? tail(edges[i].dst, *next, nextTail)
+                                       : m_tails[edges[i].dst];
+            next = &edges[i];
+            nextTail = tails[i];
+        }
+        return tails;
+    }
+
+    /**
+     * @brief Makespan of the graph of @p prefix with @p insertedEdges and @p shiftedEdges
+     * @param shiftedTails Tails of @p shiftedEdges , see @ref computeTails
+     * @return The makespan, or nothing if the edges create a positive cycle or the bound of the
+     * makespan exceeded @p cutoff , which may be lowered by other threads meanwhile
+     */
+    [[nodiscard]] std::optional<delay> evaluate(const Prefix &prefix,
+                                                const cg::Edges &insertedEdges,
+                                                std::span<const cg::Edge> shiftedEdges,
+                                                std::span<const delay> shiftedTails,
+                                                const std::atomic<delay> &cutoff) const {
+        if (!prefix.feasible) {
+            return std::nullopt;
+        }
+
+        const auto insertedTails =
+                shiftedEdges.empty()
+                        ? computeTails(insertedEdges)
+                        : computeTails(insertedEdges, &shiftedEdges.front(), shiftedTails.front());
+
+        // The edges of the candidate are a side list traversed after the prefix graph, which is
+        // shared by all the candidates and must not be copied for each of them
+        cg::ExtraEdges added;
+        auto ASAPST = prefix.ASAPST;
+        const auto add = [&](const cg::Edge &e, delay tail) {
+            // Like adding the edges to the graph, an edge that already exists keeps its weight
+            if (!prefix.graph.hasEdge(e) && !added.hasEdge(e.src, e.dst)) {
+                if (algorithms::paths::addOneEdgeIncrementalASAPST(
+                            prefix.graph, e, ASAPST, added)) {
+                    return false;
+                }
+                added.add(e);
+            }
+            return ASAPST[e.dst] == algorithms::paths::kASAPStartValue || tail == kNoTail
+                   || ASAPST[e.dst] + tail + m_lastProcessingTime
+                              <= cutoff.load(std::memory_order_relaxed);
+        };
+
+        for (std::size_t i = 0; i < insertedEdges.size(); ++i) {
+            if (!add(insertedEdges[i], insertedTails[i])) {
+                return std::nullopt;
+            }
+        }
+        for (std::size_t i = 0; i < shiftedEdges.size(); ++i) {
+            if (!add(shiftedEdges[i], shiftedTails[i])) {
+                return std::nullopt;
+            }
+        }
+        return ASAPST[m_last] + m_lastProcessingTime;
+    }
+
+private:
+    static constexpr delay kNoTail = algorithms::paths::kASAPStartValue;
+
+    /// @brief Tail of @p v , followed in the sequence by @p next whose destination has @p nextTail
+    [[nodiscard]] delay tail(cg::VertexId v, const cg::Edge &next, delay nextTail) const {
+        if (nextTail == kNoTail) {
+            return m_tails[v];
+        }
+        // An edge of the graph keeps its weight when the sequence adds it again
+        const auto weight = m_graph.hasEdge(next) ? m_graph.getWeight(next.src, next.dst)
+                                                  : next.weight;
+        return std::max(m_tails[v], weight + nextTail);
+    }
+
+    cg::GraphOverlay m_graph;
+    algorithms::paths::PathTimes m_ASAPST;
+    bool m_feasible;
+    cg::VertexId m_last;
+    delay m_lastProcessingTime;
+    /// Longest path from each vertex to the last operation in the graph, if there is one
+    std::vector<delay> m_tails;
+};
+
 Sequence obtainInitialSequence(problem::Instance &problem,
                                problem::MachineId reEntrantMachine,
                                const cli::CLIArgs &args) {
@@ -97,7 +262,7 @@ Sequence obtainInitialSequence(problem::Instance &problem,
 PartialSolution MNEH::solve(problem::Instance &problem, const cli::CLIArgs &args) {
     // solve the instance
     LOG("Computation of the schedule started");
-    SolversUtils::initProblemGraph(problem, IS_LOG_D());
+    SolversUtils::initProblemGraph(problem, IS_LOG_D(), args.pathThreads);
 
     // We only support a single re-entrant machine in the system so choose the first one
     problem::MachineId reEntrantMachine = problem.getReEntrantMachines().front();
@@ -220,58 +385,166 @@ std::tuple<Sequence, PartialSolution> MNEH::updateSequence(const problem::Instan
         }
     }
 
+    // Snapshot of the graph without sequence edges, only used to time the seed and the final
+    // sequence. The candidates are evaluated by the InsertionEvaluator on the prefix of their
+    // range, restarted from the checkpoint of the previous operation, and the lowest position
+    // among the best makespans is kept so the result does not depend on the threads
+    const cg::CSRGraph dgSnapshot(dg);
+
     // initialise seed sequence performance
     auto ASAPST = algorithms::paths::initializeASAPST(dg);
     PartialSolution seedSolution({{reEntrantMachine, seedSequence}}, ASAPST);
     auto finalSeedSequence = seedSolution.getAllAndInferredEdges(problem);
-    auto [resultseed, ASAPSTseed] = algorithms::paths::computeASAPST(dg, finalSeedSequence);
+    auto [resultseed, ASAPSTseed] =
+            algorithms::paths::computeASAPST(dgSnapshot, finalSeedSequence);
     seedSolution.setASAPST(ASAPSTseed);
     delay minMakespan = seedSolution.getRealMakespan(problem);
 
+    // validateSequence only accepts the sequences whose first passes are ordered by job, so all
+    // the candidates infer the same input sequence: the one of the seed sorted by job
+    Sequence sortedSeed = seedSequence;
+    std::ranges::stable_sort(sortedSeed, {}, &problem::Operation::jobId);
+    const InsertionEvaluator evaluator(
+            problem, dg, SolversUtils::getInferredEdges(problem, sortedSeed));
+
+    // The candidates are evaluated by several threads, each one over a range of consecutive
+    // positions with its own prefix. The makespans are reduced in the order of the positions,
+    // which gives the same result as a sequential evaluation whatever the number of threads
+    std::optional<utils::TaskWorkers> workers;
+    if (args.threads > 1) {
+        workers.emplace(args.threads);
+    }
+
+    // Prefix whose edges are the first ones of the sequence with the next operation appended
+    auto checkpoint = evaluator.createPrefix();
+
     for (int j = 1; j < seedSequence.size(); j++) {
         auto currO = seedSequence[j];
+        const auto rest = std::span(seedSequence).subspan(j + 1);
 
-        std::optional<Sequence> bestSequence;
-
-        for (std::ptrdiff_t i = 0; i <= builtSequence.size(); i++) {
+        const auto insertAt = [&](std::size_t i) {
             Sequence testSequence = builtSequence;
+            testSequence.insert(testSequence.begin() + static_cast<std::ptrdiff_t>(i), currO);
+            return testSequence;
+        };
+
+        // Sequence edges with the operation appended, whose first edges are shared by the
+        // candidates, and without the operation, whose last edges are shifted by the insertion
+        Sequence appended = insertAt(builtSequence.size());
+        appended.insert(appended.end(), rest.begin(), rest.end());
+        const auto appendedEdges =
+                SolversUtils::getEdgesFromSequence(problem, appended, reEntrantMachine);
+        Sequence withoutOperation = builtSequence;
+        withoutOperation.insert(withoutOperation.end(), rest.begin(), rest.end());
+        const auto shiftedEdges =
+                SolversUtils::getEdgesFromSequence(problem, withoutOperation, reEntrantMachine);
+        const auto shiftedTails = evaluator.computeTails(shiftedEdges);
+
+        // A candidate is abandoned once its makespan is known to exceed the best one found, ties
+        // are still evaluated because the earliest position wins them
+        std::atomic<delay> cutoff = minMakespan - 1;
+
+        // makespan of the sequence with the operation inserted at each position of the built
+        // sequence, if it is feasible and was not abandoned
+        std::vector<std::optional<delay>> makespans(builtSequence.size() + 1);
+
+        // More ranges than threads, the first positions propagate longer suffixes
+        const std::size_t nrPositions = makespans.size();
+        const auto nrRanges = workers ? std::min(nrPositions, std::size_t{4} * args.threads) : 1;
+
+        // Prefix of each range at its first valid position. The edges of the one at or before the
+        // chosen position are still the first ones once the operation is inserted there, so it
+        // becomes the checkpoint of the next operation
+        std::vector<std::optional<std::size_t>> snapshotPositions(nrRanges);
+        std::vector<std::optional<InsertionEvaluator::Prefix>> snapshots(nrRanges);
+
+        const auto evaluateRange = [&](std::size_t range) {
+            const auto first = range * nrPositions / nrRanges;
+            const auto last = (range + 1) * nrPositions / nrRanges;
+            std::optional<InsertionEvaluator::Prefix> prefix;
+            for (std::size_t i = first; i < last; i++) {
+                if (i < builtSequence.size()) {
+                    LOG_D(FMT_COMPILE("Inserting operation {} after {}"), currO, builtSequence[i]);
+                } else {
+                    LOG_D(FMT_COMPILE("Inserting operation {} after {}"),
+                          currO,
+                          builtSequence.back());
+                }
 
-            if (i < builtSequence.size()) {
-                // insert in position i of built sequence
-                testSequence.insert(testSequence.begin() + i, currO);
-                LOG_D(FMT_COMPILE("Inserting operation {} after {}"), currO, builtSequence[i]);
-            } else {
-                // insert at end of built sequence
-                testSequence.push_back(currO);
-                LOG_D(FMT_COMPILE("Inserting operation {} after {}"), currO, builtSequence.back());
-            }
+                // add the rest of the initial sequence
+                // mend connection
+                Sequence evaluateSequence = insertAt(i);
+                evaluateSequence.insert(evaluateSequence.end(), rest.begin(), rest.end());
+                if (!validateSequence(problem, evaluateSequence, reEntrantMachine, dg)) {
+                    continue;
+                }
 
-            // add the rest of the initial sequence
-            // mend connection
-            Sequence evaluateSequence = testSequence;
-            evaluateSequence.insert(
-                    evaluateSequence.end(), seedSequence.begin() + j + 1, seedSequence.end());
-
-            // compute if valid and better than others only accept the responsible test sequence if
-            // evaluate has minimum makespan seen so far
-            if (validateSequence(problem, evaluateSequence, reEntrantMachine, dg)) {
-                PartialSolution solution({{reEntrantMachine, std::move(evaluateSequence)}}, {});
-                auto finalSequence = solution.getAllAndInferredEdges(problem);
-                auto result = algorithms::paths::computeASAPST(dg, finalSequence);
-                solution.setASAPST(std::move(result.times));
-
-                if (!result.hasPositiveCycle()) {
-                    const delay newMakespan = solution.getRealMakespan(problem);
-                    if (newMakespan < minMakespan) {
-                        bestSequence = std::move(testSequence);
-                        minMakespan = newMakespan;
+                // The edge entering the operation before the insertion point is only shared if
+                // it does not depend on the next operation, i.e. if it is not a maintenance
+                const auto firstInserted = i > 0 ? i - 1 : 0;
+                auto insertedEdges = SolversUtils::getEdgesFromSequence(
+                        problem,
+                        evaluateSequence,
+                        reEntrantMachine,
+                        firstInserted,
+                        std::min(i + 2, evaluateSequence.size()));
+                std::size_t sharedEdges = firstInserted;
+                if (i > 0 && insertedEdges.front() == appendedEdges[i - 1]) {
+                    insertedEdges.erase(insertedEdges.begin());
+                    sharedEdges = i;
+                }
+
+                if (prefix) {
+                    evaluator.extend(*prefix, appendedEdges, sharedEdges);
+                } else {
+                    // A prefix can only be extended
+                    prefix = checkpoint.length <= sharedEdges ? checkpoint
+                                                              : evaluator.createPrefix();
+                    evaluator.extend(*prefix, appendedEdges, sharedEdges);
+                    snapshots[range] = *prefix;
+                    snapshotPositions[range] = i;
+                }
+
+                const auto firstShifted = std::min(i + 1, shiftedEdges.size());
+                makespans[i] = evaluator.evaluate(*prefix,
+                                                  insertedEdges,
+                                                  std::span(shiftedEdges).subspan(firstShifted),
+                                                  std::span(shiftedTails).subspan(firstShifted),
+                                                  cutoff);
+
+                if (makespans[i]) {
+                    auto current = cutoff.load();
+                    while (*makespans[i] < current
+                           && !cutoff.compare_exchange_weak(current, *makespans[i])) {
                     }
                 }
             }
+        };
+
+        if (workers) {
+            workers->run(nrRanges, evaluateRange);
+        } else {
+            evaluateRange(0);
+        }
+
+        // only accept the test sequence if it has the minimum makespan seen so far, the earliest
+        // position wins ties
+        std::optional<std::size_t> bestPosition;
+        for (std::size_t i = 0; i < makespans.size(); i++) {
+            if (makespans[i] && *makespans[i] < minMakespan) {
+                bestPosition = i;
+                minMakespan = *makespans[i];
+            }
         }
 
-        if (bestSequence.has_value()) {
-            builtSequence = bestSequence.value();
+        if (bestPosition.has_value()) {
+            builtSequence = insertAt(*bestPosition);
+            for (std::size_t r = nrRanges; r-- > 0;) {
+                if (snapshotPositions[r] && *snapshotPositions[r] <= *bestPosition) {
+                    checkpoint = std::move(*snapshots[r]);
+                    break;
+                }
+            }
         } else {
             builtSequence.push_back(currO);
         }
@@ -286,7 +559,7 @@ std::tuple<Sequence, PartialSolution> MNEH::updateSequence(const problem::Instan
 
     PartialSolution builtSolution({{reEntrantMachine, builtSequence}}, {});
     auto finalSequence = builtSolution.getAllAndInferredEdges(problem);
-    auto [result, ASAPSTr] = algorithms::paths::computeASAPST(dg, finalSequence);
+    auto [result, ASAPSTr] = algorithms::paths::computeASAPST(dgSnapshot, finalSequence);
     builtSolution.setASAPST(ASAPSTr);
     return {builtSequence, builtSolution};
 }
@@ -302,23 +575,23 @@ bool MNEH::validateSequence(const problem::Instance &problemInstance,
 
     std::optional<problem::JobId> lastFirstPass;
     std::optional<problem::JobId> lastSecondPass;
-    std::unordered_set<problem::JobId> doneFirstPass;
+    // The first passes are ordered by job, so the jobs done are sorted
+    std::vector<problem::JobId> doneFirstPass;
+    doneFirstPass.reserve(sequence.size());
     for (auto currOp : sequence) {
-        const auto &curr_v = dg.getVertex(currOp);
-
         // confirm order of first passes
         if (currOp.operationId == ops[0]) { // isFirstPass
             if (lastFirstPass.has_value() && currOp.jobId <= lastFirstPass.value()) {
                 return false;
             }
             lastFirstPass = currOp.jobId;
-            doneFirstPass.insert(currOp.jobId);
+            doneFirstPass.push_back(currOp.jobId);
         }
 
         // confirm order of second passes
         // confirm first second pass precedence
         if (currOp.operationId == ops[1]) { // isSecondPass
-            if (!doneFirstPass.contains(currOp.jobId)) {
+            if (!std::ranges::binary_search(doneFirstPass, currOp.jobId)) {
                 return false;
             }
             if (lastSecondPass.has_value() && currOp.jobId <= lastSecondPass.value()) {
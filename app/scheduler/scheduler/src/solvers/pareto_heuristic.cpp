@@ -35,7 +35,8 @@ std::vector<PartialSolution> ParetoHeuristic::solve(problem::Instance &problemIn
         cg::exports::saveAsTikz(problemInstance, dg, name);
     }
 
-    auto [result, ASAPST] = SolversUtils::checkSolutionAndOutputIfFails(problemInstance);
+    auto [result, ASAPST] =
+            SolversUtils::checkSolutionAndOutputIfFails(problemInstance, args.pathThreads);
 
     LOG(fmt::format("Number of vertices in the delay graph is {}", dg.getNumberOfVertices()));
 
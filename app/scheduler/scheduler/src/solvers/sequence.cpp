@@ -40,12 +40,14 @@ compute(const fms::problem::Instance &f,
 
     auto dg = f.getDelayGraph();
     const auto allEdges = solution.getAllChosenEdges(f);
-    auto result = fms::algorithms::paths::computeASAPST(dg, allEdges);
+    auto result = fms::algorithms::paths::computeASAPST(
+            dg, allEdges, fms::algorithms::paths::CycleReport::CYCLE);
 
     if (result.hasPositiveCycle()) {
-        auto result = fms::algorithms::paths::getPositiveCycle(dg, allEdges);
-        fms::cg::exports::saveAsDot(
-                dg, fmt::format("infeasible_{}.dot", problemName), allEdges, result);
+        fms::cg::exports::saveAsDot(dg,
+                                    fmt::format("infeasible_{}.dot", problemName),
+                                    allEdges,
+                                    result.positiveCycle);
         fms::LOG_E("The sequence is not valid. It contains a positive cycle.");
         throw FmsSchedulerException("The sequence is not valid");
     }
@@ -11,7 +11,7 @@ SolverOutput SimpleScheduler::solve(problem::Instance &problemInstance,
                                     const cli::CLIArgs &args) {
     LOG("SimpleScheduler: Solving problem instance");
 
-    SolversUtils::initProblemGraph(problemInstance);
+    SolversUtils::initProblemGraph(problemInstance, false, args.pathThreads);
     auto solution = SolversUtils::createTrivialSolution(problemInstance);
 
     // Return the solutions and the JSON object
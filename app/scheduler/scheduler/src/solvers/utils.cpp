@@ -6,6 +6,7 @@
 #include "fms/algorithms/longest_path.hpp"
 #include "fms/cg/builder.hpp"
 #include "fms/cg/constraint_graph.hpp"
+#include "fms/cg/csr_graph.hpp"
 #include "fms/cg/edge.hpp"
 #include "fms/cg/export_utilities.hpp"
 
@@ -17,15 +18,24 @@ SolversUtils::checkSolutionAndOutputIfFails(const std::string &fileName,
                                             cg::ConstraintGraph &dg,
                                             const cg::Edges &extraEdges,
                                             const std::string &extraMessage) {
-    auto result = algorithms::paths::computeASAPST(dg, extraEdges);
+    auto result = algorithms::paths::computeASAPST(
+            dg, extraEdges, algorithms::paths::CycleReport::CYCLE);
     checkPathResultAndOutputIfFails(fileName, dg, extraMessage, result, extraEdges);
     return result;
 }
 
 algorithms::paths::LongestPathResultWithTimes
-SolversUtils::checkSolutionAndOutputIfFails(const problem::Instance &instance) {
+SolversUtils::checkSolutionAndOutputIfFails(const problem::Instance &instance,
+                                            std::size_t nrThreads) {
     const auto &dg = instance.getDelayGraph();
-    auto result = algorithms::paths::computeASAPST(dg);
+    const cg::CSRGraph csr(dg);
+    auto ASAPST = algorithms::paths::initializeASAPST(csr);
+    using algorithms::paths::LongestPathEngine;
+    auto pathResult = nrThreads > 1
+                              ? algorithms::paths::computeASAPSTParallel(csr, ASAPST, nrThreads)
+                              : algorithms::paths::computeASAPST(
+                                        csr, ASAPST, {}, LongestPathEngine::TWO_PHASE);
+    algorithms::paths::LongestPathResultWithTimes result(std::move(pathResult), std::move(ASAPST));
 
     checkPathResultAndOutputIfFails(
             fmt::format(FMT_COMPILE("input_infeasible_{}"), instance.getProblemName()),
@@ -74,7 +84,8 @@ PartialSolution SolversUtils::createTrivialSolution(problem::Instance &problem)
 
     cg::ConstraintGraph dg = problem.getDelayGraph();
     auto extraEdges = solution.getAllChosenEdges(problem);
-    auto result = algorithms::paths::computeASAPST(dg, extraEdges);
+    auto result = algorithms::paths::computeASAPST(
+            dg, extraEdges, algorithms::paths::CycleReport::CYCLE);
     checkPathResultAndOutputIfFails(
             fmt::format(FMT_COMPILE("output_infeasible_{}"), problem.getProblemName()),
             dg,
@@ -148,13 +159,22 @@ void fms::solvers::SolversUtils::printSequenceIfDebug(const Sequence &sequence)
 cg::Edges fms::solvers::SolversUtils::getEdgesFromSequence(const problem::Instance &problem,
                                                            const Sequence &sequence,
                                                            problem::MachineId machineId) {
+    return getEdgesFromSequence(problem, sequence, machineId, 0, sequence.size());
+}
+
+cg::Edges fms::solvers::SolversUtils::getEdgesFromSequence(const problem::Instance &problem,
+                                                           const Sequence &sequence,
+                                                           problem::MachineId machineId,
+                                                           std::size_t first,
+                                                           std::size_t last) {
     cg::Edges chosenEdges;
-    chosenEdges.reserve(sequence.size());
+    chosenEdges.reserve(last - first);
 
     const auto &g = problem.getDelayGraph();
-    std::reference_wrapper<const cg::Vertex> previous = g.getSource(machineId);
+    std::reference_wrapper<const cg::Vertex> previous =
+            first == 0 ? g.getSource(machineId) : g.getVertex(sequence.at(first - 1));
 
-    for (std::size_t i = 0; i < sequence.size(); ++i) {
+    for (std::size_t i = first; i < last; ++i) {
         const auto &op = sequence.at(i);
         const auto &v = g.getVertex(op);
 
@@ -240,7 +260,8 @@ cg::Edges fms::solvers::SolversUtils::getAllEdgesPlusInferredEdges(
 }
 
 algorithms::paths::PathTimes SolversUtils::initProblemGraph(problem::Instance &problemInstance,
-                                                            bool saveGraph) {
+                                                            bool saveGraph,
+                                                            std::size_t nrThreads) {
     if (!problemInstance.isGraphInitialized()) {
         problemInstance.updateDelayGraph(cg::Builder::build(problemInstance));
     }
@@ -250,6 +271,6 @@ algorithms::paths::PathTimes SolversUtils::initProblemGraph(problem::Instance &p
         cg::exports::saveAsDot(problemInstance.getDelayGraph(), name);
     }
 
-    auto [result, ASAPST] = SolversUtils::checkSolutionAndOutputIfFails(problemInstance);
+    auto [result, ASAPST] = SolversUtils::checkSolutionAndOutputIfFails(problemInstance, nrThreads);
     return ASAPST;
 }
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+
+#include <fms/algorithms/longest_path.hpp>
+#include <fms/cg/builder.hpp>
+#include <fms/cg/constraint_graph.hpp>
+#include <fms/cg/csr_graph.hpp>
+#include <fms/problem/xml_parser.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FMS_TEST_HAS_AVX2_KERNEL
+#endif
+
+using namespace fms;
+using namespace fms::cg;
+using algorithms::paths::kASAPStartValue;
+using algorithms::paths::PathTimes;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace {
+constexpr std::array<std::string_view, 2> kPrinterCases{
+        "modular/printer_cases/bookletA/0.xml",
+        "modular/printer_cases/bookletB/10.xml",
+};
+
+struct NamedGraph {
+    std::string name;
+    ConstraintGraph dg;
+};
+
+/// Flow-shop shaped graph: job chains, sequence edges between consecutive jobs and deadlines
+ConstraintGraph buildFlowShopGraph(std::uint32_t numJobs, std::uint32_t numOps) {
+    ConstraintGraph dg;
+    const auto source = dg.addSource(static_cast<problem::MachineId>(0));
+    std::vector<VertexId> ids;
+    for (problem::JobId job(0); job.value < numJobs; ++job) {
+        for (std::uint32_t op = 0; op < numOps; ++op) {
+            ids.push_back(dg.addVertex(job, static_cast<problem::OperationId>(op)));
+        }
+    }
+
+    for (std::uint32_t j = 0; j < numJobs; ++j) {
+        dg.addEdge(source, ids[j * numOps], 0);
+        for (std::uint32_t op = 0; op < numOps; ++op) {
+            const auto v = ids[j * numOps + op];
+            const delay processing = 10 + (j + op) % 7;
+            if (op + 1 < numOps) {
+                dg.addEdge(v, ids[j * numOps + op + 1], processing);
+                dg.addEdge(ids[j * numOps + op + 1], v, -(processing + 50));
+            }
+            if (j + 1 < numJobs) {
+                dg.addEdge(v, ids[(j + 1) * numOps + op], processing + 3);
+            }
+        }
+    }
+    return dg;
+}
+
+/// Acyclic graph in which every vertex has @p inDegree incoming edges, the best case of a pull
+ConstraintGraph buildDenseGraph(std::uint32_t numVertices, std::uint32_t inDegree) {
+    ConstraintGraph dg;
+    const auto source = dg.addSource(static_cast<problem::MachineId>(0));
+    std::vector<VertexId> ids;
+    for (problem::JobId job(0); job.value < numVertices; ++job) {
+        ids.push_back(dg.addVertex(job, static_cast<problem::OperationId>(0)));
+        dg.addEdge(source, ids.back(), 0);
+    }
+
+    std::mt19937_64 rng(11);
+    for (std::uint32_t v = 1; v < numVertices; ++v) {
+        std::uniform_int_distribution<std::uint32_t> pick(0, v - 1);
+        for (std::uint32_t k = 0; k < inDegree; ++k) {
+            const auto u = pick(rng);
+            if (!dg.hasEdge(ids[u], ids[v])) {
+                dg.addEdge(ids[u], ids[v], static_cast<delay>(1 + rng() % 20));
+            }
+        }
+    }
+    return dg;
+}
+
+std::vector<NamedGraph> buildGraphs() {
+    std::vector<NamedGraph> graphs;
+    for (const auto file : kPrinterCases) {
+        problem::FORPFSSPSDXmlParser parser{std::string(file)};
+        auto line = parser.createProductionLine();
+        for (auto &[id, module] : line.modules()) {
+            graphs.push_back({fmt::format("{} module {}", file, id), Builder::FORPFSSPSD(module)});
+        }
+    }
+    graphs.push_back({"flow shop 2000x4", buildFlowShopGraph(2000, 4)});
+    graphs.push_back({"flow shop 25000x4", buildFlowShopGraph(25000, 4)});
+    graphs.push_back({"dense in-degree 16", buildDenseGraph(20000, 16)});
+    return graphs;
+}
+
+/// Scalar push sweep in vertex order, the way the Bellman-Ford sweeps of the library relax
+bool pushSweep(const CSRGraph &g, PathTimes &times) {
+    bool changed = false;
+    for (VertexId v = 0; v < g.getNumberOfVertices(); ++v) {
+        if (times[v] == kASAPStartValue) {
+            continue;
+        }
+        const auto dsts = g.getOutgoingDst(v);
+        const auto weights = g.getOutgoingWeights(v);
+        for (std::size_t i = 0; i < dsts.size(); ++i) {
+            const auto value = times[v] + weights[i];
+            if (value > times[dsts[i]]) {
+                times[dsts[i]] = value;
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+/// Scalar pull sweep: gathers the incoming edges of each vertex and max-reduces them
+bool pullSweepScalar(const CSRGraph &g, PathTimes &times) {
+    bool changed = false;
+    for (VertexId v = 0; v < g.getNumberOfVertices(); ++v) {
+        const auto srcs = g.getIncomingSrc(v);
+        const auto weights = g.getIncomingWeights(v);
+        delay best = times[v];
+        for (std::size_t i = 0; i < srcs.size(); ++i) {
+            const auto t = times[srcs[i]];
+            if (t != kASAPStartValue) {
+                best = std::max(best, t + weights[i]);
+            }
+        }
+        if (best > times[v]) {
+            times[v] = best;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+#ifdef FMS_TEST_HAS_AVX2_KERNEL
+/// Same as @ref pullSweepScalar with the gather, add and max-reduce done four edges at a time
+__attribute__((target("avx2"))) bool pullSweepAVX2(const CSRGraph &g, PathTimes &times) {
+    static_assert(sizeof(VertexId) == sizeof(long long) && sizeof(delay) == sizeof(long long));
+    const __m256i unreached = _mm256_set1_epi64x(kASAPStartValue);
+    const auto *base = reinterpret_cast<const long long *>(times.data());
+
+    bool changed = false;
+    for (VertexId v = 0; v < g.getNumberOfVertices(); ++v) {
+        const auto srcs = g.getIncomingSrc(v);
+        const auto weights = g.getIncomingWeights(v);
+        delay best = times[v];
+
+        std::size_t i = 0;
+        if (srcs.size() >= 4) {
+            __m256i acc = unreached;
+            for (; i + 4 <= srcs.size(); i += 4) {
+                const auto idx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&srcs[i]));
+                const auto w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&weights[i]));
+                const auto t = _mm256_i64gather_epi64(base, idx, 8);
+                const auto reached = _mm256_andnot_si256(_mm256_cmpeq_epi64(t, unreached),
+                                                         _mm256_set1_epi64x(-1));
+                const auto value = _mm256_blendv_epi8(unreached, _mm256_add_epi64(t, w), reached);
+                acc = _mm256_blendv_epi8(acc, value, _mm256_cmpgt_epi64(value, acc));
+            }
+            alignas(32) std::array<delay, 4> lanes{};
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes.data()), acc);
+            best = std::max({best, lanes[0], lanes[1], lanes[2], lanes[3]});
+        }
+        for (; i < srcs.size(); ++i) {
+            const auto t = times[srcs[i]];
+            if (t != kASAPStartValue) {
+                best = std::max(best, t + weights[i]);
+            }
+        }
+        if (best > times[v]) {
+            times[v] = best;
+            changed = true;
+        }
+    }
+    return changed;
+}
+#endif
+
+struct SweepResult {
+    PathTimes times;
+    std::size_t sweeps = 0;
+    double nsPerSweep = 0;
+};
+
+template <typename Sweep>
+SweepResult runSweeps(const CSRGraph &g, const PathTimes &initial, Sweep sweep) {
+    using Clock = std::chrono::steady_clock;
+    const std::size_t rounds = std::max<std::size_t>(1, 20'000'000 / (g.getNumberOfEdges() + 1));
+
+    SweepResult result;
+    const auto start = Clock::now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        result.times = initial;
+        result.sweeps = 1;
+        while (sweep(g, result.times) && result.sweeps < g.getNumberOfVertices()) {
+            ++result.sweeps;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+    result.nsPerSweep = elapsed.count() / static_cast<double>(rounds * result.sweeps);
+    return result;
+}
+} // namespace
+
+// Compares the push sweeps of the Bellman-Ford engine with a pull kernel that gathers the incoming
+// edges of each vertex and max-reduces them, in scalar and AVX2 form. Run it with
+// --gtest_also_run_disabled_tests --gtest_filter=CSRRelaxation.DISABLED_kernelCost
+TEST(CSRRelaxation, DISABLED_kernelCost) {
+#ifdef FMS_TEST_HAS_AVX2_KERNEL
+    const bool hasAVX2 = __builtin_cpu_supports("avx2") != 0;
+#else
+    const bool hasAVX2 = false;
+#endif
+
+    for (const auto &[name, dg] : buildGraphs()) {
+        const CSRGraph g(dg);
+        const auto initial = algorithms::paths::initializeASAPST(g);
+
+        const auto push = runSweeps(g, initial, pushSweep);
+        const auto pull = runSweeps(g, initial, pullSweepScalar);
+        ASSERT_EQ(push.times, pull.times) << name;
+
+        std::size_t highInDegree = 0;
+        for (VertexId v = 0; v < g.getNumberOfVertices(); ++v) {
+            highInDegree += g.getIncomingSrc(v).size() >= 4 ? 1U : 0U;
+        }
+
+        std::string line = fmt::format(
+                "{}: {} vertices, {} edges ({:.2f} per vertex), in-degree >= 4: {} vertices\n"
+                "  push scalar {} sweeps {:.0f} ns/sweep, pull scalar {} sweeps {:.0f} ns/sweep",
+                name,
+                g.getNumberOfVertices(),
+                g.getNumberOfEdges(),
+                static_cast<double>(g.getNumberOfEdges())
+                        / static_cast<double>(g.getNumberOfVertices()),
+                highInDegree,
+                push.sweeps,
+                push.nsPerSweep,
+                pull.sweeps,
+                pull.nsPerSweep);
+
+#ifdef FMS_TEST_HAS_AVX2_KERNEL
+        if (hasAVX2) {
+            const auto avx2 = runSweeps(g, initial, pullSweepAVX2);
+            ASSERT_EQ(push.times, avx2.times) << name;
+            line += fmt::format(
+                    ", pull AVX2 {} sweeps {:.0f} ns/sweep", avx2.sweeps, avx2.nsPerSweep);
+        }
+#endif
+        if (!hasAVX2) {
+            line += ", AVX2 not available";
+        }
+        std::cout << line << '\n';
+    }
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <fms/cg/builder.hpp>
+#include <fms/cg/constraint_graph.hpp>
+#include <fms/cg/operation_index.hpp>
+#include <fms/problem/xml_parser.hpp>
+#include <fms/utils/containers.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string_view>
+
+using namespace fms;
+using namespace fms::cg;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace {
+constexpr std::array<std::string_view, 5> kPrinterCases{
+        "modular/printer_cases/bookletA/0.xml",
+        "modular/printer_cases/bookletA/23.xml",
+        "modular/printer_cases/bookletABUniform/54.xml",
+        "modular/printer_cases/bookletB/10.xml",
+        "modular/printer_cases/bookletBUniform/101.xml",
+};
+
+std::vector<ConstraintGraph> buildPrinterCaseGraphs() {
+    std::vector<ConstraintGraph> graphs;
+    for (const auto file : kPrinterCases) {
+        problem::FORPFSSPSDXmlParser parser{std::string(file)};
+        auto line = parser.createProductionLine();
+        for (auto &[_, module] : line.modules()) {
+            graphs.push_back(Builder::FORPFSSPSD(module));
+        }
+    }
+    return graphs;
+}
+} // namespace
+
+TEST(OperationIndex, matchesGraphVertices) {
+    for (const auto &dg : buildPrinterCaseGraphs()) {
+        for (const auto &v : dg.getVertices()) {
+            ASSERT_TRUE(dg.hasVertex(v.operation));
+            EXPECT_EQ(dg.getVertexId(v.operation), v.id);
+        }
+        for (const Vertex &source : dg.getSources()) {
+            EXPECT_EQ(dg.getVertexId(source.operation), source.id);
+        }
+    }
+}
+
+TEST(OperationIndex, sparseFallback) {
+    OperationIndex index;
+    const problem::Operation dense{problem::JobId(3), 2, std::nullopt};
+    const problem::Operation largeJob{problem::JobId(OperationIndex::kMaxDenseJobId + 5), 1, std::nullopt};
+    const problem::Operation largeOp{problem::JobId(1), OperationIndex::kMaxDenseOperationId, std::nullopt};
+    const problem::Operation reserved{problem::JobId::max() - 6U, 4, std::nullopt};
+
+    index.insert(dense, 0);
+    index.insert(largeJob, 1);
+    index.insert(largeOp, 2);
+    index.insert(reserved, 3);
+
+    EXPECT_EQ(index.find(dense), 0U);
+    EXPECT_EQ(index.find(largeJob), 1U);
+    EXPECT_EQ(index.find(largeOp), 2U);
+    EXPECT_EQ(index.find(reserved), 3U);
+
+    EXPECT_FALSE(index.contains({problem::JobId(3), 1, std::nullopt}));
+    EXPECT_FALSE(index.contains({problem::JobId(7), 0, std::nullopt}));
+    EXPECT_FALSE(index.contains({problem::JobId::max() - 6U, 0, std::nullopt}));
+    EXPECT_FALSE(index.contains({problem::JobId(OperationIndex::kMaxDenseJobId + 6), 1, std::nullopt}));
+
+    index.insert(dense, 4);
+    EXPECT_EQ(index.find(dense), 4U);
+}
+
+// Compares the cost of the lookups with the hash map that was used before. Run it with
+// --gtest_also_run_disabled_tests --gtest_filter=OperationIndex.DISABLED_lookupCost
+TEST(OperationIndex, DISABLED_lookupCost) {
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t kRounds = 2000;
+
+    for (const auto &dg : buildPrinterCaseGraphs()) {
+        utils::containers::Map<problem::Operation, VertexId> map;
+        OperationIndex index;
+        std::vector<problem::Operation> ops;
+        for (const auto &v : dg.getVertices()) {
+            map[v.operation] = v.id;
+            index.insert(v.operation, v.id);
+            ops.push_back(v.operation);
+        }
+
+        VertexId mapSum = 0;
+        const auto mapStart = Clock::now();
+        for (std::size_t r = 0; r < kRounds; ++r) {
+            for (const auto &op : ops) {
+                mapSum += map.find(op)->second;
+            }
+        }
+        const auto mapTime = Clock::now() - mapStart;
+
+        VertexId indexSum = 0;
+        const auto indexStart = Clock::now();
+        for (std::size_t r = 0; r < kRounds; ++r) {
+            for (const auto &op : ops) {
+                indexSum += index.find(op);
+            }
+        }
+        const auto indexTime = Clock::now() - indexStart;
+
+        ASSERT_EQ(mapSum, indexSum);
+        const auto lookups = static_cast<double>(kRounds * ops.size());
+        std::cout << fmt::format(
+                "{} vertices: hash map {:.2f} ns/lookup, dense index {:.2f} ns/lookup\n",
+                ops.size(),
+                std::chrono::duration<double, std::nano>(mapTime).count() / lookups,
+                std::chrono::duration<double, std::nano>(indexTime).count() / lookups);
+    }
+}
+
+// NOLINTEND(*-magic-numbers)
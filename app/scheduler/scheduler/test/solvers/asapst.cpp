@@ -2,7 +2,9 @@
 
 #include <fms/algorithms/longest_path.hpp>
 #include <fms/cg/builder.hpp>
+#include <fms/cg/csr_graph.hpp>
 #include <fms/cg/export_utilities.hpp>
+#include <fms/cg/graph_overlay.hpp>
 #include <fms/problem/flow_shop.hpp>
 #include <fms/problem/indices.hpp>
 #include <fms/problem/xml_parser.hpp>
@@ -489,9 +491,10 @@ TEST(ASAPST, incrementalMultipleBackward) {
         EXPECT_EQ(ASAPST[id], algorithms::paths::kASAPStartValue);
     }
 
+    // The overlay and the graph entry points give the same result, neither modifies the graph
     cg::Edges edges{{ids.at(0), ids.at(1), 5}, {dg.getSource(mSrc).id, ids.at(0), 0}};
-    bool resConst = algorithms::paths::addEdgesIncrementalASAPSTConst(dg, edges, ASAPST);
-    EXPECT_FALSE(resConst);
+    bool resOverlay = algorithms::paths::addEdgesIncrementalASAPST(GraphOverlay(dg), edges, ASAPST);
+    EXPECT_FALSE(resOverlay);
     bool res = algorithms::paths::addEdgesIncrementalASAPST(dg, edges, ASAPST);
     EXPECT_FALSE(res);
     EXPECT_EQ(ASAPST[ids.at(0)], 0);
@@ -503,12 +506,97 @@ TEST(ASAPST, incrementalMultipleBackward) {
     // Add positive cycle and expect it to fail
     edges = {{ids.at(2), ids.at(0), 10}};
     auto ASAPSTCopy = ASAPST;
-    resConst = algorithms::paths::addEdgesIncrementalASAPSTConst(dg, edges, ASAPSTCopy);
-    EXPECT_TRUE(resConst);
+    resOverlay = algorithms::paths::addEdgesIncrementalASAPST(GraphOverlay(dg), edges, ASAPSTCopy);
+    EXPECT_TRUE(resOverlay);
     res = algorithms::paths::addEdgesIncrementalASAPST(dg, edges, ASAPST);
     EXPECT_TRUE(res);
 }
 
+TEST(ASAPST, incrementalMultipleSkipsExisting) {
+    auto [dg, mSrc, ids] = buildGraph();
+    dg.addEdge(dg.getSource(mSrc).id, ids.at(0), 0);
+    dg.addEdge(ids.at(0), ids.at(1), 5);
+    dg.addEdge(ids.at(1), ids.at(2), 100);
+
+    auto ASAPST = algorithms::paths::initializeASAPST(dg);
+    ASSERT_FALSE(algorithms::paths::computeASAPST(dg, ASAPST).hasPositiveCycle());
+    const auto initial = ASAPST;
+
+    // A heavier copy of an existing edge is ignored, so are the repetitions of a new edge
+    cg::Edges edges{
+            {ids.at(0), ids.at(1), 50}, {ids.at(0), ids.at(2), 10}, {ids.at(0), ids.at(2), 500}};
+    const GraphOverlay overlay(dg);
+    auto expected = initial;
+    ASSERT_FALSE(algorithms::paths::computeASAPST(overlay, expected, edges).hasPositiveCycle());
+
+    EXPECT_FALSE(algorithms::paths::addEdgesIncrementalASAPST(overlay, edges, ASAPST));
+    EXPECT_EQ(ASAPST, expected);
+    EXPECT_EQ(ASAPST, initial);
+
+    // The same holds for the graph entry point
+    edges = {{ids.at(1), ids.at(2), 100}, {ids.at(1), ids.at(2), 1000}};
+    EXPECT_FALSE(algorithms::paths::addEdgesIncrementalASAPST(dg, edges, ASAPST));
+    EXPECT_EQ(ASAPST, initial);
+}
+
+TEST(ASAPST, incrementalWithEdgesMatchesFull) {
+    problem::FORPFSSPSDXmlParser parser("modular/printer_cases/bookletA/0.xml");
+    auto line = parser.createProductionLine();
+    // Shared by all the modules, it is reset after each update even when it stops at a cycle
+    algorithms::paths::IncrementalASAPScratch scratch;
+    for (auto &[_, module] : line.modules()) {
+        const auto dg = Builder::FORPFSSPSD(module);
+        const auto &jobsOut = module.getJobsOutput();
+        auto initial = algorithms::paths::initializeASAPST(dg);
+        ASSERT_FALSE(algorithms::paths::computeASAPST(dg, initial).hasPositiveCycle());
+
+        // Delay the start of each job after the previous one. The repeated edge is ignored by
+        // both computations because it already exists.
+        Edges edges;
+        for (std::size_t i = 1; i < jobsOut.size(); ++i) {
+            edges.emplace_back(dg.getVertexId(module.jobs(jobsOut[i - 1]).front()),
+                               dg.getVertexId(module.jobs(jobsOut[i]).front()),
+                               50);
+        }
+        if (!edges.empty()) {
+            edges.emplace_back(edges.front().src, edges.front().dst, 5000);
+        }
+
+        const GraphOverlay overlay(dg);
+        auto expected = initial;
+        auto times = initial;
+        ASSERT_FALSE(algorithms::paths::computeASAPST(overlay, expected, edges).hasPositiveCycle());
+        const auto result = algorithms::paths::computeIncrementalASAPST(overlay, edges, times);
+        EXPECT_FALSE(result.positiveCycle);
+        EXPECT_EQ(times, expected);
+
+        std::size_t changed = 0;
+        for (std::size_t v = 0; v < times.size(); ++v) {
+            changed += times[v] != initial[v] ? 1 : 0;
+        }
+        EXPECT_EQ(result.touchedVertices, changed);
+
+        // Chaining the jobs backwards with a large delay creates a positive cycle
+        Edges backwards;
+        for (std::size_t i = 1; i < jobsOut.size(); ++i) {
+            backwards.emplace_back(dg.getVertexId(module.jobs(jobsOut[i]).back()),
+                                   dg.getVertexId(module.jobs(jobsOut[i - 1]).front()),
+                                   1000000);
+        }
+        times = initial;
+        EXPECT_EQ(algorithms::paths::computeIncrementalASAPST(overlay, backwards, times, scratch)
+                          .positiveCycle,
+                  jobsOut.size() > 1);
+
+        times = initial;
+        const auto reused =
+                algorithms::paths::computeIncrementalASAPST(overlay, edges, times, scratch);
+        EXPECT_FALSE(reused.positiveCycle);
+        EXPECT_EQ(reused.touchedVertices, result.touchedVertices);
+        EXPECT_EQ(times, expected);
+    }
+}
+
 TEST(ASAPST, singleNode) {
     // Load the non-terminating case
     problem::FORPFSSPSDXmlParser parser("modular/synthetic/non-terminating/problem.xml");
@@ -565,4 +653,489 @@ TEST(ASAPST, obtainCycle) {
     }
 }
 
+TEST(ASAPST, cycleReportReturnsCycle) {
+    using algorithms::paths::CycleReport;
+    const auto expectCycle = [](const Edges &cycle) {
+        ASSERT_FALSE(cycle.empty());
+        delay length = 0;
+        for (std::size_t i = 0; i < cycle.size(); ++i) {
+            // The edges go from the last one of the cycle back to the first one
+            EXPECT_EQ(cycle[i].src, cycle[(i + 1) % cycle.size()].dst);
+            length += cycle[i].weight;
+        }
+        EXPECT_GT(length, 0);
+    };
+
+    for (const auto *file : {"modular/printer_cases/bookletA/0.xml",
+                             "modular/printer_cases/bookletB/10.xml"}) {
+        problem::FORPFSSPSDXmlParser parser(file);
+        auto line = parser.createProductionLine();
+        for (auto &[_, module] : line.modules()) {
+            const auto dg = Builder::FORPFSSPSD(module);
+            const auto &jobsOut = module.getJobsOutput();
+
+            auto expected = algorithms::paths::initializeASAPST(dg);
+            auto times = expected;
+            algorithms::paths::computeASAPST(dg, expected);
+            const auto result = algorithms::paths::computeASAPST(dg, times, CycleReport::CYCLE);
+            EXPECT_FALSE(result.hasPositiveCycle());
+            EXPECT_EQ(times, expected);
+
+            Edges edges;
+            for (std::size_t i = 1; i < jobsOut.size(); ++i) {
+                edges.emplace_back(dg.getVertexId(module.jobs(jobsOut[i]).back()),
+                                   dg.getVertexId(module.jobs(jobsOut[i - 1]).front()),
+                                   1000000);
+            }
+            const auto cycle = algorithms::paths::computeASAPST(dg, edges, CycleReport::CYCLE);
+            EXPECT_EQ(cycle.hasPositiveCycle(), jobsOut.size() > 1);
+            if (cycle.hasPositiveCycle()) {
+                expectCycle(cycle.positiveCycle);
+                EXPECT_EQ(cycle.positiveCycle, algorithms::paths::getPositiveCycle(dg, edges));
+            }
+        }
+    }
+
+    // A cycle inside the window is found, an edge before the window is reported on its own
+    ConstraintGraph dg;
+    const auto src = dg.addSource(static_cast<problem::MachineId>(0U));
+    VerticesIds ids;
+    for (std::uint32_t i = 0; i < 5; ++i) {
+        ids.push_back(dg.addVertex(problem::JobId(i), problem::OperationId(0U)));
+        dg.addEdge(i == 0 ? src : ids[i - 1], ids[i], 1);
+    }
+    VerticesCRef window;
+    for (std::size_t i = 1; i < ids.size(); ++i) {
+        window.emplace_back(dg.getVertex(ids[i]));
+    }
+
+    auto initial = algorithms::paths::initializeASAPST(dg);
+    algorithms::paths::computeASAPST(dg, initial);
+
+    GraphOverlay inWindow(dg);
+    inWindow.addEdge(ids[4], ids[2], 0);
+    auto times = initial;
+    const auto windowCycle = algorithms::paths::computeASAPST(
+            inWindow, times, {dg.getVertex(ids[0])}, window, CycleReport::CYCLE);
+    expectCycle(windowCycle.positiveCycle);
+    EXPECT_EQ(windowCycle.positiveCycle.size(), 3);
+
+    GraphOverlay beforeWindow(dg);
+    beforeWindow.addEdge(ids[4], ids[0], 0);
+    times = initial;
+    const auto infeasible = algorithms::paths::computeASAPST(
+            beforeWindow, times, {dg.getVertex(ids[0])}, window, CycleReport::CYCLE);
+    EXPECT_EQ(infeasible.positiveCycle, Edges{Edge(ids[4], ids[0], 0)});
+}
+
+TEST(ASAPST, snapshotMatchesGraph) {
+    problem::FORPFSSPSDXmlParser parser("modular/printer_cases/bookletA/0.xml");
+    auto line = parser.createProductionLine();
+    const auto &module = line[static_cast<problem::ModuleId>(0)];
+
+    auto dg = Builder::FORPFSSPSD(module);
+    const CSRGraph snapshot(dg);
+    ASSERT_EQ(snapshot.getNumberOfVertices(), dg.getNumberOfVertices());
+
+    {
+        const auto expected = algorithms::paths::computeASAPST(dg);
+        const auto result = algorithms::paths::computeASAPST(snapshot);
+        EXPECT_FALSE(result.hasPositiveCycle());
+        EXPECT_EQ(result.times, expected.times);
+    }
+
+    {
+        auto [expectedResult, expected] = algorithms::paths::computeALAPST(dg);
+        auto [result, times] = algorithms::paths::computeALAPST(snapshot);
+        EXPECT_EQ(result.positiveCycle, expectedResult.positiveCycle);
+        EXPECT_EQ(times, expected);
+    }
+
+    // Chain the first operation of consecutive jobs. One edge is repeated and one already exists
+    // in the graph so they must be ignored as Graph::addEdges does.
+    const auto &jobsOut = module.getJobsOutput();
+    Edges edges;
+    for (std::size_t i = 1; i < jobsOut.size(); ++i) {
+        edges.emplace_back(dg.getVertexId(module.jobs(jobsOut[i - 1]).front()),
+                           dg.getVertexId(module.jobs(jobsOut[i]).front()),
+                           1000);
+    }
+    edges.push_back(edges.front());
+    edges.back().weight = 1;
+    const auto &firstVertex = dg.getVertex(module.jobs(jobsOut.front()).front());
+    const auto [existingDst, existingWeight] = *firstVertex.getOutgoingEdges().begin();
+    edges.emplace_back(firstVertex.id, existingDst, existingWeight + 1000);
+
+    {
+        // Building the side list edge by edge keeps the same order as building it at once
+        const ExtraEdges extra(snapshot, edges);
+        ExtraEdges added;
+        for (const auto &e : edges) {
+            if (!snapshot.hasEdge(e.src, e.dst) && !added.hasEdge(e.src, e.dst)) {
+                added.add(e);
+            }
+        }
+        EXPECT_EQ(added.getEdges(), extra.getEdges());
+        for (VertexId v = 0; v < snapshot.getNumberOfVertices(); ++v) {
+            const auto incoming = added.getIncomingEdges(v);
+            const auto expected = extra.getIncomingEdges(v);
+            EXPECT_TRUE(std::equal(
+                    incoming.begin(), incoming.end(), expected.begin(), expected.end()));
+        }
+    }
+
+    {
+        const auto expected = algorithms::paths::computeASAPST(dg, edges);
+        const auto result = algorithms::paths::computeASAPST(snapshot, edges);
+        EXPECT_FALSE(result.hasPositiveCycle());
+        EXPECT_EQ(result.times, expected.times);
+    }
+
+    // Closing the chain creates a positive cycle, both must report the same edges
+    edges.emplace_back(edges.at(jobsOut.size() - 2).dst, edges.front().src, 0);
+    {
+        const auto expected = algorithms::paths::computeASAPST(dg, edges);
+        const auto result = algorithms::paths::computeASAPST(snapshot, edges);
+        ASSERT_TRUE(result.hasPositiveCycle());
+        EXPECT_EQ(result.positiveCycle, expected.positiveCycle);
+        EXPECT_EQ(algorithms::paths::getPositiveCycle(snapshot, edges),
+                  algorithms::paths::getPositiveCycle(dg, edges));
+    }
+}
+
+TEST(ASAPST, overlayMatchesModifiedGraph) {
+    problem::FORPFSSPSDXmlParser parser("modular/printer_cases/bookletA/0.xml");
+    auto line = parser.createProductionLine();
+    const auto &module = line[static_cast<problem::ModuleId>(0)];
+
+    const auto dg = Builder::FORPFSSPSD(module);
+    const auto &jobsOut = module.getJobsOutput();
+
+    // Chain the first operation of every other job and override the weight of an existing edge
+    Edges edges;
+    for (std::size_t i = 2; i < jobsOut.size(); i += 2) {
+        edges.emplace_back(dg.getVertexId(module.jobs(jobsOut[i - 2]).front()),
+                           dg.getVertexId(module.jobs(jobsOut[i]).front()),
+                           1000);
+        ASSERT_FALSE(dg.hasEdge(edges.back()));
+    }
+    ASSERT_GT(edges.size(), 1U);
+    const auto &firstVertex = dg.getVertex(module.jobs(jobsOut.front()).front());
+    const auto [existingDst, existingWeight] = *firstVertex.getOutgoingEdges().begin();
+    const Edge overridden(firstVertex.id, existingDst, existingWeight - 1);
+
+    GraphOverlay overlay(dg);
+    EXPECT_EQ(overlay.addEdges(edges), edges);
+    EXPECT_TRUE(overlay.addEdges(edges).empty());
+    overlay.addEdges(overridden);
+
+    auto modified = dg;
+    modified.addEdges(edges);
+    modified.addEdges(overridden);
+
+    EXPECT_TRUE(overlay.hasEdge(edges.front()));
+    EXPECT_FALSE(dg.hasEdge(edges.front()));
+    EXPECT_EQ(overlay.getWeight(overridden.src, overridden.dst), overridden.weight);
+    EXPECT_EQ(dg.getWeight(overridden.src, overridden.dst), existingWeight);
+
+    {
+        auto expected = algorithms::paths::initializeASAPST(modified);
+        const auto expectedResult = algorithms::paths::computeASAPST(modified, expected);
+        auto times = algorithms::paths::initializeASAPST(dg);
+        const auto result = algorithms::paths::computeASAPST(overlay, times);
+        EXPECT_FALSE(result.hasPositiveCycle());
+        EXPECT_EQ(result.positiveCycle, expectedResult.positiveCycle);
+        EXPECT_EQ(times, expected);
+    }
+
+    {
+        auto [expectedResult, expected] = algorithms::paths::computeALAPST(modified);
+        auto times = algorithms::paths::initializeALAPST(dg);
+        const auto result = algorithms::paths::computeALAPST(overlay, times);
+        EXPECT_EQ(result.positiveCycle, expectedResult.positiveCycle);
+        EXPECT_EQ(times, expected);
+    }
+
+    // Closing the chain creates a positive cycle, both must report the same edges
+    const Edge closing(edges.back().dst, edges.front().src, 0);
+    {
+        auto expected = algorithms::paths::initializeASAPST(modified);
+        const auto expectedResult = algorithms::paths::computeASAPST(modified, expected, {closing});
+        auto times = algorithms::paths::initializeASAPST(dg);
+        const auto result = algorithms::paths::computeASAPST(overlay, times, {closing});
+        ASSERT_TRUE(result.hasPositiveCycle());
+        EXPECT_EQ(result.positiveCycle, expectedResult.positiveCycle);
+
+        auto closed = overlay;
+        closed.addEdges(closing);
+        EXPECT_EQ(algorithms::paths::getPositiveCycle(closed),
+                  algorithms::paths::getPositiveCycle(modified, {closing}));
+    }
+
+    // The edits never reach the base graph
+    EXPECT_FALSE(overlay.hasEdge(closing));
+    overlay.clear();
+    EXPECT_TRUE(overlay.empty());
+    EXPECT_FALSE(overlay.hasEdge(edges.front()));
+}
+
+TEST(ASAPST, worklistMatchesBellmanFord) {
+    using algorithms::paths::LongestPathEngine;
+
+    for (const auto *file : {"modular/printer_cases/bookletA/0.xml",
+                             "modular/printer_cases/bookletB/10.xml",
+                             "modular/printer_cases/bookletBUniform/101.xml"}) {
+        problem::FORPFSSPSDXmlParser parser(file);
+        auto line = parser.createProductionLine();
+        for (auto &[_, module] : line.modules()) {
+            const auto dg = Builder::FORPFSSPSD(module);
+            const auto &jobsOut = module.getJobsOutput();
+
+            auto expected = algorithms::paths::initializeASAPST(dg);
+            auto times = expected;
+            const auto expectedResult = algorithms::paths::computeASAPST(dg, expected);
+            const auto result =
+                    algorithms::paths::computeASAPST(dg, times, LongestPathEngine::WORKLIST);
+            EXPECT_FALSE(result.hasPositiveCycle());
+            EXPECT_EQ(times, expected);
+
+            // Chaining the jobs backwards with a large delay creates a positive cycle
+            GraphOverlay overlay(dg);
+            for (std::size_t i = 1; i < jobsOut.size(); ++i) {
+                overlay.addEdge(module.jobs(jobsOut[i]).back(),
+                                module.jobs(jobsOut[i - 1]).front(),
+                                1000000);
+            }
+            expected = algorithms::paths::initializeASAPST(dg);
+            times = expected;
+            const auto cycleExpected = algorithms::paths::computeASAPST(overlay, expected);
+            const auto cycle =
+                    algorithms::paths::computeASAPST(overlay, times, LongestPathEngine::WORKLIST);
+            EXPECT_EQ(cycle.hasPositiveCycle(), jobsOut.size() > 1);
+            EXPECT_EQ(cycle.hasPositiveCycle(), cycleExpected.hasPositiveCycle());
+            EXPECT_EQ(cycle.positiveCycle, cycleExpected.positiveCycle);
+            EXPECT_EQ(times, expected);
+        }
+    }
+}
+
+TEST(ASAPST, twoPhaseMatchesBellmanFord) {
+    using algorithms::paths::LongestPathEngine;
+
+    for (const auto *file : {"modular/printer_cases/bookletA/0.xml",
+                             "modular/printer_cases/bookletB/10.xml",
+                             "modular/printer_cases/bookletBUniform/101.xml"}) {
+        problem::FORPFSSPSDXmlParser parser(file);
+        auto line = parser.createProductionLine();
+        for (auto &[_, module] : line.modules()) {
+            const auto dg = Builder::FORPFSSPSD(module);
+            const auto &jobsOut = module.getJobsOutput();
+            const algorithms::paths::ForwardOrder order(dg);
+            ASSERT_EQ(order.getOrder().size(), dg.getNumberOfVertices());
+
+            auto expected = algorithms::paths::initializeASAPST(dg);
+            auto times = expected;
+            auto csrTimes = expected;
+            const auto expectedResult = algorithms::paths::computeASAPST(dg, expected);
+            const auto result = algorithms::paths::computeASAPST(dg, times, order);
+            EXPECT_FALSE(result.hasPositiveCycle());
+            EXPECT_EQ(times, expected);
+
+            const CSRGraph snapshot(dg);
+            const auto csrResult = algorithms::paths::computeASAPST(
+                    snapshot, csrTimes, {}, LongestPathEngine::TWO_PHASE);
+            EXPECT_FALSE(csrResult.hasPositiveCycle());
+            EXPECT_EQ(csrTimes, expected);
+
+            // Chaining the jobs backwards with a large delay creates a positive cycle
+            GraphOverlay overlay(dg);
+            for (std::size_t i = 1; i < jobsOut.size(); ++i) {
+                overlay.addEdge(module.jobs(jobsOut[i]).back(),
+                                module.jobs(jobsOut[i - 1]).front(),
+                                1000000);
+            }
+            expected = algorithms::paths::initializeASAPST(dg);
+            times = expected;
+            const auto cycleExpected = algorithms::paths::computeASAPST(overlay, expected);
+            const auto cycle = algorithms::paths::computeASAPST(overlay, times, order);
+            EXPECT_EQ(cycle.hasPositiveCycle(), jobsOut.size() > 1);
+            EXPECT_EQ(cycle.positiveCycle, cycleExpected.positiveCycle);
+            EXPECT_EQ(times, expected);
+        }
+    }
+}
+
+TEST(ALAPST, incrementalMatchesFull) {
+    for (const auto *file : {"modular/printer_cases/bookletA/0.xml",
+                             "modular/printer_cases/bookletB/10.xml",
+                             "modular/printer_cases/bookletBUniform/101.xml"}) {
+        problem::FORPFSSPSDXmlParser parser(file);
+        auto line = parser.createProductionLine();
+        for (auto &[_, module] : line.modules()) {
+            const auto dg = Builder::FORPFSSPSD(module);
+            const auto &jobsOut = module.getJobsOutput();
+            const auto [positiveCycle, ASAPST] = algorithms::paths::computeASAPST(dg);
+            ASSERT_TRUE(positiveCycle.empty());
+
+            // Fix the last operation of each job to its ASAP time, like the DD solver does
+            auto ALAPST = algorithms::paths::initializeALAPST(dg);
+            cg::VerticesIds fixed;
+            for (const auto jobId : jobsOut) {
+                const auto vId = dg.getVertexId(module.jobs(jobId).back());
+                ALAPST[vId] = ASAPST[vId];
+                fixed.push_back(vId);
+            }
+            ASSERT_FALSE(algorithms::paths::computeALAPST(dg, ALAPST).hasPositiveCycle());
+
+            Edges edges;
+            for (std::size_t i = 2; i < jobsOut.size(); ++i) {
+                edges.emplace_back(dg.getVertexId(module.jobs(jobsOut[i - 2]).front()),
+                                   dg.getVertexId(module.jobs(jobsOut[i]).front()),
+                                   1);
+            }
+
+            GraphOverlay overlay(dg);
+            overlay.addEdges(edges);
+            auto expected = ALAPST;
+            const auto expectedResult = algorithms::paths::computeALAPST(overlay, expected);
+            auto times = ALAPST;
+            EXPECT_EQ(algorithms::paths::addEdgesIncrementalALAPST(dg, edges, times),
+                      expectedResult.hasPositiveCycle());
+            EXPECT_EQ(times, expected);
+
+            // Moving the fixed operations earlier is propagated to their predecessors
+            for (const auto vId : fixed) {
+                expected[vId] -= 10;
+                times[vId] -= 10;
+            }
+            ASSERT_FALSE(algorithms::paths::computeALAPST(overlay, expected).hasPositiveCycle());
+            EXPECT_FALSE(algorithms::paths::updateIncrementalALAPST(overlay, fixed, times));
+            EXPECT_EQ(times, expected);
+
+            // Fixed vertices cannot be moved
+            if (jobsOut.size() > 1) {
+                const Edge late(fixed.front(), fixed.back(), ASAPST[fixed.back()]);
+                times = expected;
+                EXPECT_TRUE(algorithms::paths::addEdgesIncrementalALAPST(
+                        overlay, {late}, times, {fixed.front()}));
+                EXPECT_EQ(times, expected);
+
+                auto withLate = overlay;
+                withLate.addEdges(late);
+                EXPECT_TRUE(algorithms::paths::computeALAPST(withLate, expected, {fixed.front()})
+                                    .hasPositiveCycle());
+                EXPECT_EQ(times, expected);
+            }
+
+            // A scratch reused between updates does not keep the sources or paths of earlier ones
+            algorithms::paths::IncrementalALAPScratch scratch;
+            if (jobsOut.size() > 1) {
+                const Edge late(fixed.front(), fixed.back(), ASAPST[fixed.back()]);
+                times = ALAPST;
+                EXPECT_TRUE(algorithms::paths::addEdgesIncrementalALAPST(
+                        overlay, {late}, times, {fixed.front()}, scratch));
+            }
+            times = ALAPST;
+            auto reference = ALAPST;
+            EXPECT_EQ(algorithms::paths::addEdgesIncrementalALAPST(
+                              GraphOverlay(dg), edges, times, {}, scratch),
+                      algorithms::paths::addEdgesIncrementalALAPST(dg, edges, reference));
+            EXPECT_EQ(times, reference);
+        }
+    }
+}
+
+TEST(ASAPST, multiSourceMatchesSingleSource) {
+    for (const auto *file : {"modular/printer_cases/bookletA/0.xml",
+                             "modular/printer_cases/bookletB/10.xml",
+                             "modular/printer_cases/bookletBUniform/101.xml"}) {
+        problem::FORPFSSPSDXmlParser parser(file);
+        auto line = parser.createProductionLine();
+        for (auto &[_, module] : line.modules()) {
+            const auto dg = Builder::FORPFSSPSD(module);
+            const CSRGraph snapshot(dg);
+            const auto &jobsOut = module.getJobsOutput();
+
+            VerticesIds sources;
+            Edges cycle;
+            for (std::size_t i = 0; i < jobsOut.size(); ++i) {
+                sources.push_back(dg.getVertexId(module.jobs(jobsOut[i]).front()));
+                sources.push_back(dg.getVertexId(module.jobs(jobsOut[i]).back()));
+                if (i > 0) {
+                    cycle.emplace_back(dg.getVertexId(module.jobs(jobsOut[i]).back()),
+                                       dg.getVertexId(module.jobs(jobsOut[i - 1]).front()),
+                                       1000000);
+                }
+            }
+
+            // The chained jobs make a positive cycle, the lanes must still match
+            for (const auto &edges : {Edges{}, cycle}) {
+                const ExtraEdges extra(snapshot, edges);
+                const auto batch = algorithms::paths::computeASAPSTFromNodes(
+                        snapshot, sources, extra);
+                ASSERT_EQ(batch.nrSources, sources.size());
+                for (std::size_t k = 0; k < sources.size(); ++k) {
+                    EXPECT_EQ(batch.getSource(k),
+                              algorithms::paths::computeASAPSTFromNode(
+                                      snapshot, sources[k], extra));
+                }
+            }
+        }
+    }
+}
+
+TEST(ASAPST, parallelMatchesBellmanFord) {
+    // Jobs with deadlines between their operations that are processed one after the other, large
+    // enough to be shared between the threads
+    constexpr std::uint32_t kJobs = 600;
+    constexpr std::uint32_t kOpsPerJob = 4;
+    ConstraintGraph dg;
+    const auto src = dg.addSource(static_cast<problem::MachineId>(0));
+    VertexId previous = src;
+    for (std::uint32_t j = 0; j < kJobs; ++j) {
+        VertexId first = 0;
+        for (std::uint32_t k = 0; k < kOpsPerJob; ++k) {
+            const auto v = dg.addVertex(problem::JobId(j), static_cast<problem::OperationId>(k));
+            if (k == 0) {
+                first = v;
+                dg.addEdge(src, v, 0);
+                dg.addEdge(previous, v, 3);
+            } else {
+                dg.addEdge(v - 1, v, static_cast<delay>(10 + (j + k) % 7));
+                dg.addEdge(v, v - 1, -40);
+            }
+        }
+        dg.addEdge(first + kOpsPerJob - 1, first, -60 - static_cast<delay>(j % 5));
+        previous = first + kOpsPerJob - 1;
+    }
+
+    for (const std::size_t nrThreads : {1, 2, 4}) {
+        auto expected = algorithms::paths::initializeASAPST(dg);
+        auto times = expected;
+        const auto expectedResult = algorithms::paths::computeASAPST(dg, expected);
+        const auto result = algorithms::paths::computeASAPSTParallel(dg, times, nrThreads);
+        EXPECT_FALSE(result.hasPositiveCycle());
+        EXPECT_EQ(times, expected);
+
+        // An edge back from the end of a later job closes a positive cycle
+        GraphOverlay overlay(dg);
+        overlay.addEdge(previous, dg.getVertexId({problem::JobId(kJobs / 2), 0, std::nullopt}), 0);
+        expected = algorithms::paths::initializeASAPST(dg);
+        times = expected;
+        const auto cycleExpected = algorithms::paths::computeASAPST(overlay, expected);
+        const auto cycle = algorithms::paths::computeASAPSTParallel(overlay, times, nrThreads);
+        ASSERT_TRUE(cycle.hasPositiveCycle());
+        EXPECT_EQ(cycle.positiveCycle, cycleExpected.positiveCycle);
+        EXPECT_EQ(times, expected);
+
+        const CSRGraph snapshot(dg);
+        const ExtraEdges extra(snapshot, overlay.getEdges());
+        times = algorithms::paths::initializeASAPST(snapshot);
+        const auto csrCycle =
+                algorithms::paths::computeASAPSTParallel(snapshot, times, nrThreads, extra);
+        EXPECT_EQ(csrCycle.positiveCycle, cycleExpected.positiveCycle);
+        EXPECT_EQ(times, expected);
+    }
+}
+
 // NOLINTEND(*-magic-numbers)
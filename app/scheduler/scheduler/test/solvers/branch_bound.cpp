@@ -4,10 +4,16 @@
 
 #include <fms/cg/builder.hpp>
 #include <fms/cg/constraint_graph.hpp>
+#include <fms/cg/csr_graph.hpp>
 #include <fms/cg/export_utilities.hpp>
 #include <fms/problem/flow_shop.hpp>
 #include <fms/scheduler.hpp>
+#include <fms/scheduler_exception.hpp>
 #include <fms/solvers/branch_bound.hpp>
+#include <fms/solvers/branch_bound_tree.hpp>
+#include <fms/solvers/forward_heuristic.hpp>
+
+#include <set>
 
 using namespace fms;
 using namespace fms::solvers;
@@ -19,7 +25,7 @@ TEST(BranchBound, TinyHomogeneousCase) {
     f.updateDelayGraph(cg::Builder::FORPFSSPSD(f));
     ASSERT_TRUE(Scheduler::checkConsistency(f).first);
 
-    auto solutions = solvers::branch_bound::solve(f, cli::CLIArgs{});
+    auto [solution, data] = solvers::branch_bound::solve(f, cli::CLIArgs{});
 }
 
 TEST(BranchBound, SmallHomogeneousCase) {
@@ -29,7 +35,7 @@ TEST(BranchBound, SmallHomogeneousCase) {
 
     cli::CLIArgs args;
     args.timeOut = std::chrono::seconds(f.getNumberOfJobs());
-    auto best_solution = solvers::branch_bound::solve(f, args);
+    auto [best_solution, data] = solvers::branch_bound::solve(f, args);
     std::cout << best_solution.getMakespan() << std::endl;
     std::cout << branch_bound::createTrivialCompletionLowerBound(f) << std::endl;
     EXPECT_GT(best_solution.getMakespan(), branch_bound::createTrivialCompletionLowerBound(f));
@@ -44,7 +50,7 @@ TEST(BranchBound, NoInterleavingPossible) {
 
     cli::CLIArgs args;
     args.timeOut = std::chrono::seconds(f.getNumberOfJobs());
-    auto solution = solvers::branch_bound::solve(f, args);
+    auto [solution, data] = solvers::branch_bound::solve(f, args);
     // 1 + 50 * 2 + 1 - 1 (starting time of last operation)
     ASSERT_EQ(solution.getMakespan(), 101);
 }
@@ -57,7 +63,7 @@ TEST(BranchBound, NoInterleavingPossibleSmall) {
 
     cli::CLIArgs args;
     args.timeOut = std::chrono::seconds(f.getNumberOfJobs());
-    auto solution = solvers::branch_bound::solve(f, args);
+    auto [solution, data] = solvers::branch_bound::solve(f, args);
     // 1 + 5 * 2 + 1 - 1 (starting time of last operation)
     ASSERT_EQ(solution.getMakespan(), 11);
 }
@@ -70,7 +76,7 @@ TEST(BranchBound, AllFirstPassBeforeSecondPass) {
 
     cli::CLIArgs args;
     args.timeOut = std::chrono::seconds(f.getNumberOfJobs());
-    auto solutions = solvers::branch_bound::solve(f, args);
+    auto [solutions, data] = solvers::branch_bound::solve(f, args);
     // 1 + 13 * 10 * 2 + 10 (starting time of last operation)
     ASSERT_EQ(solutions.getMakespan(), 281);
 }
@@ -84,7 +90,7 @@ TEST(BranchBound, LongHomogeneousCaseFitsExactlyInMinBuffer) {
 
     cli::CLIArgs args;
     args.timeOut = std::chrono::seconds(f.getNumberOfJobs());
-    auto solutions = solvers::branch_bound::solve(f, args);
+    auto [solutions, data] = solvers::branch_bound::solve(f, args);
     // (starting time of last operation) = 1041 = 1 + 52 * 10 * 2
     ASSERT_EQ(solutions.getMakespan(), 1041);
 }
@@ -98,9 +104,309 @@ TEST(BranchBound, LongHomogeneousCase) {
 
     cli::CLIArgs args;
     args.timeOut = std::chrono::seconds(f.getNumberOfJobs());
-    auto solutions = solvers::branch_bound::solve(f, args);
+    auto [solutions, data] = solvers::branch_bound::solve(f, args);
     // (starting time of last operation) = 441 = 1 + 22 * 10 * 2
     ASSERT_GE(solutions.getMakespan(), 441);
 }
 
+TEST(BranchBound, ParallelSearchFindsTheOptimum) {
+    auto f = createHomogeneousCase(1, 10, 10, 1, 100, 150, 14);
+    f.updateDelayGraph(cg::Builder::FORPFSSPSD(f));
+    ASSERT_TRUE(Scheduler::checkConsistency(f).first);
+
+    cli::CLIArgs args;
+    args.timeOut = std::chrono::seconds(f.getNumberOfJobs());
+    auto [sequential, sequentialData] = solvers::branch_bound::solve(f, args);
+
+    args.threads = 4;
+    auto [parallel, parallelData] = solvers::branch_bound::solve(f, args);
+    ASSERT_EQ(parallel.getMakespan(), sequential.getMakespan());
+    EXPECT_EQ(parallelData["terminationReason"], sequentialData["terminationReason"]);
+    EXPECT_EQ(parallelData["threads"], 4);
+    EXPECT_EQ(parallelData["expandedNodesPerThread"].size(), 4U);
+    EXPECT_EQ(parallelData["lowerBound"], parallelData["upperBound"]);
+    EXPECT_LE(parallelData["bestSolutionTime"], parallelData["searchTime"]);
+}
+
+TEST(BranchBound, IncrementalNodesMatchFullEvaluation) {
+    auto f = createHomogeneousCase(1, 10, 10, 1, 100, 150, 14);
+    f.updateDelayGraph(cg::Builder::FORPFSSPSD(f));
+    auto dg = f.getDelayGraph();
+    const cg::CSRGraph csr(dg);
+
+    const auto machine = f.getReEntrantMachines().front();
+    const auto &ops = f.getOperationsMappedOnMachine().at(machine);
+    const auto trivialLowerBound = branch_bound::createTrivialCompletionLowerBound(f);
+
+    auto ASAPST = algorithms::paths::initializeASAPST(dg);
+    ASSERT_TRUE(algorithms::paths::computeASAPST(dg, ASAPST).positiveCycle.empty());
+    branch_bound::BranchBoundNode node(
+            f,
+            dg,
+            csr,
+            PartialSolution({{machine, forward::createInitialSequence(f, machine)}}, ASAPST),
+            trivialLowerBound);
+
+    // Follow the most promising child down to a complete schedule, scheduling the second pass of
+    // the first job that can still be interleaved like the search does
+    bool complete = false;
+    while (!complete) {
+        auto parentASAPST = std::make_shared<const algorithms::paths::PathTimes>(
+                node.getASAPST(f, dg, csr));
+        PartialSolution solution = node.getSolution();
+        solution.setASAPST(*parentASAPST);
+
+        std::size_t position = 0;
+        const auto firstPossibleOp = *solution.firstPossibleOp(machine);
+        while (!dg.isSource(firstPossibleOp)
+               && f.getJobAtOutputPosition(position) <= firstPossibleOp.jobId) {
+            position++;
+        }
+        ASSERT_LT(position + 1, f.getNumberOfJobs());
+        complete = position + 2 == f.getNumberOfJobs();
+
+        const auto children = branch_bound::scheduleOneOperation(
+                dg,
+                csr,
+                f,
+                solution,
+                dg.getVertex({f.getJobAtOutputPosition(position), ops.at(1), std::nullopt}));
+        ASSERT_FALSE(children.empty());
+        std::optional<branch_bound::BranchBoundNode> next;
+        for (const auto &child : children) {
+            // Some interleavings are infeasible, both evaluations have to reject them
+            std::optional<branch_bound::BranchBoundNode> full;
+            try {
+                full.emplace(f, dg, csr, child, trivialLowerBound);
+            } catch (const FmsSchedulerException &) {
+                EXPECT_THROW(branch_bound::BranchBoundNode(
+                                     f, dg, csr, node, parentASAPST, child, trivialLowerBound),
+                             FmsSchedulerException);
+                continue;
+            }
+            branch_bound::BranchBoundNode incremental(
+                    f, dg, csr, node, parentASAPST, child, trivialLowerBound);
+
+            EXPECT_TRUE(incremental.getTouchedVertices().has_value());
+            EXPECT_FALSE(full->getTouchedVertices().has_value());
+            EXPECT_EQ(incremental.getASAPST(f, dg, csr), full->getASAPST(f, dg, csr));
+            EXPECT_EQ(incremental.getLowerbound(), full->getLowerbound());
+            EXPECT_EQ(incremental.getMakespan(), full->getMakespan());
+            next.emplace(std::move(incremental));
+        }
+        ASSERT_TRUE(next.has_value());
+        node = std::move(*next);
+    }
+}
+
+TEST(BranchBound, NodeSelectionPoliciesFindTheOptimum) {
+    auto f = createHomogeneousCase(1, 10, 10, 1, 100, 150, 14);
+    f.updateDelayGraph(cg::Builder::FORPFSSPSD(f));
+    ASSERT_TRUE(Scheduler::checkConsistency(f).first);
+
+    for (const cli::NodeSelectionType selection : {cli::NodeSelectionType::DEPTH,
+                                                   cli::NodeSelectionType::BEST,
+                                                   cli::NodeSelectionType::HYBRID}) {
+        cli::CLIArgs args;
+        args.timeOut = std::chrono::seconds(f.getNumberOfJobs());
+        args.nodeSelection = selection;
+        auto [solution, data] = solvers::branch_bound::solve(f, args);
+        // 1 + 13 * 10 * 2 + 10 (starting time of last operation)
+        EXPECT_EQ(solution.getMakespan(), 281);
+        EXPECT_EQ(data["nodeSelection"], std::string{selection.shortName()});
+        EXPECT_EQ(data["terminationReason"], "optimal");
+    }
+}
+
+TEST(BranchBound, ParallelSearchRejectsNodeSelection) {
+    auto f = createHomogeneousCase(1, 10, 10, 1, 100, 150, 5);
+    f.updateDelayGraph(cg::Builder::FORPFSSPSD(f));
+
+    cli::CLIArgs args;
+    args.threads = 2;
+    args.nodeSelection = cli::NodeSelectionType::BEST;
+    EXPECT_THROW(solvers::branch_bound::solve(f, args), FmsSchedulerException);
+
+    args.nodeSelection = cli::NodeSelectionType::DEPTH;
+    args.nodeMemory = 1;
+    EXPECT_THROW(solvers::branch_bound::solve(f, args), FmsSchedulerException);
+}
+
+TEST(BranchBound, NodeTreeRestoresItsNodes) {
+    auto f = createHomogeneousCase(1, 10, 10, 1, 100, 150, 14);
+    f.updateDelayGraph(cg::Builder::FORPFSSPSD(f));
+    auto dg = f.getDelayGraph();
+    const cg::CSRGraph csr(dg);
+
+    const auto machine = f.getReEntrantMachines().front();
+    const auto &ops = f.getOperationsMappedOnMachine().at(machine);
+    const auto trivialLowerBound = branch_bound::createTrivialCompletionLowerBound(f);
+
+    auto ASAPST = algorithms::paths::initializeASAPST(dg);
+    ASSERT_TRUE(algorithms::paths::computeASAPST(dg, ASAPST).positiveCycle.empty());
+    const branch_bound::BranchBoundNode root(
+            f,
+            dg,
+            csr,
+            PartialSolution({{machine, forward::createInitialSequence(f, machine)}}, ASAPST),
+            trivialLowerBound);
+
+    // Without budget the times of the root are dropped when the first child is taken, and its
+    // children are evaluated from scratch
+    for (const std::size_t budget : {std::numeric_limits<std::size_t>::max(), std::size_t{0}}) {
+        branch_bound::NodeTree tree(f, root, cli::NodeSelectionType::BEST, budget);
+        const auto rootIndex = tree.pop();
+        ASSERT_TRUE(rootIndex.has_value());
+        const auto node = tree.restore(*rootIndex);
+        EXPECT_EQ(node.getSolution().getMachineSequence(machine),
+                  root.getSolution().getMachineSequence(machine));
+
+        auto times = std::make_shared<const algorithms::paths::PathTimes>(
+                node.getASAPST(f, dg, csr));
+        PartialSolution solution = node.getSolution();
+        solution.setASAPST(*times);
+        tree.setTimes(*rootIndex, times);
+
+        std::size_t position = 0;
+        const auto firstPossibleOp = *solution.firstPossibleOp(machine);
+        while (!dg.isSource(firstPossibleOp)
+               && f.getJobAtOutputPosition(position) <= firstPossibleOp.jobId) {
+            position++;
+        }
+        const auto children = branch_bound::scheduleOneOperation(
+                dg,
+                csr,
+                f,
+                solution,
+                dg.getVertex({f.getJobAtOutputPosition(position), ops.at(1), std::nullopt}));
+
+        std::vector<branch_bound::BranchBoundNode> nodes;
+        for (const auto &child : children) {
+            try {
+                nodes.emplace_back(f, dg, csr, node, times, child, trivialLowerBound);
+            } catch (const FmsSchedulerException &) {
+                continue;
+            }
+            tree.addChild(*rootIndex, solution, nodes.back());
+        }
+        tree.release(*rootIndex);
+        ASSERT_FALSE(nodes.empty());
+        EXPECT_EQ(tree.openNodes(), nodes.size());
+
+        const auto bestChild = std::ranges::min_element(
+                nodes, {}, [](const auto &n) { return n.getLowerbound(); });
+        EXPECT_EQ(tree.lowerBound(), bestChild->getLowerbound());
+
+        delay previous = 0;
+        while (const auto index = tree.pop()) {
+            const auto restored = tree.restore(*index);
+            EXPECT_LE(previous, restored.getLowerbound());
+            previous = restored.getLowerbound();
+
+            const auto &sequence = restored.getSolution().getMachineSequence(machine);
+            const auto child = std::ranges::find_if(nodes, [&](const auto &n) {
+                return n.getSolution().getMachineSequence(machine) == sequence;
+            });
+            ASSERT_NE(child, nodes.end());
+            EXPECT_EQ(restored.getLastInsertedOperation(), child->getLastInsertedOperation());
+            EXPECT_EQ(restored.getMakespan(), child->getMakespan());
+            EXPECT_EQ(restored.getASAPST(f, dg, csr), child->getASAPST(f, dg, csr));
+            tree.release(*index);
+        }
+        EXPECT_EQ(tree.openNodes(), 0U);
+        EXPECT_EQ(tree.evictions(), budget == 0 ? 1U : 0U);
+    }
+}
+
+TEST(BranchBound, HybridSelectionReturnsToBestFirst) {
+    auto f = createHomogeneousCase(1, 10, 10, 1, 100, 1000, 12);
+    f.updateDelayGraph(cg::Builder::FORPFSSPSD(f));
+    auto dg = f.getDelayGraph();
+    const cg::CSRGraph csr(dg);
+
+    const auto machine = f.getReEntrantMachines().front();
+    const auto &ops = f.getOperationsMappedOnMachine().at(machine);
+    const auto trivialLowerBound = branch_bound::createTrivialCompletionLowerBound(f);
+
+    auto ASAPST = algorithms::paths::initializeASAPST(dg);
+    ASSERT_TRUE(algorithms::paths::computeASAPST(dg, ASAPST).positiveCycle.empty());
+    const branch_bound::BranchBoundNode root(
+            f,
+            dg,
+            csr,
+            PartialSolution({{machine, forward::createInitialSequence(f, machine)}}, ASAPST),
+            trivialLowerBound);
+
+    // Expands the whole tree without pruning in the order of the node selection policy, and
+    // returns the makespans of the complete schedules
+    const auto search = [&](branch_bound::NodeTree &tree) {
+        std::multiset<delay> makespans;
+        while (const auto index = tree.pop()) {
+            const auto node = tree.restore(*index);
+            auto times = std::make_shared<const algorithms::paths::PathTimes>(
+                    node.getASAPST(f, dg, csr));
+            PartialSolution solution = node.getSolution();
+            solution.setASAPST(*times);
+            tree.setTimes(*index, times);
+
+            // The second pass of the last job is already in the initial sequence
+            std::size_t position = 0;
+            const auto firstPossibleOp = *solution.firstPossibleOp(machine);
+            while (position + 1 < f.getNumberOfJobs() && !dg.isSource(firstPossibleOp)
+                   && f.getJobAtOutputPosition(position) <= firstPossibleOp.jobId) {
+                position++;
+            }
+            const bool complete = position + 2 == f.getNumberOfJobs();
+            std::vector<PartialSolution> children;
+            try {
+                children = branch_bound::scheduleOneOperation(
+                        dg,
+                        csr,
+                        f,
+                        solution,
+                        dg.getVertex({f.getJobAtOutputPosition(position), ops.at(1), std::nullopt}));
+            } catch (const FmsSchedulerException &) {
+                // No feasible position for the operation, the node is a dead end
+            }
+
+            for (const auto &child : children) {
+                std::optional<branch_bound::BranchBoundNode> childNode;
+                try {
+                    childNode.emplace(f, dg, csr, node, times, child, trivialLowerBound);
+                } catch (const FmsSchedulerException &) {
+                    continue;
+                }
+                if (complete) {
+                    makespans.insert(childNode->getMakespan());
+                } else {
+                    tree.addChild(*index, solution, *childNode);
+                }
+            }
+            tree.release(*index);
+        }
+        return makespans;
+    };
+
+    constexpr auto kUnlimited = std::numeric_limits<std::size_t>::max();
+    branch_bound::NodeTree depthFirst(f, root, cli::NodeSelectionType::DEPTH, kUnlimited);
+    const auto makespans = search(depthFirst);
+    branch_bound::NodeTree bestFirst(f, root, cli::NodeSelectionType::BEST, kUnlimited);
+    EXPECT_EQ(search(bestFirst), makespans);
+    ASSERT_LT(2 * depthFirst.peakBytes(), bestFirst.peakBytes());
+
+    // With a budget closer to the memory of the depth-first search a dive must end within the
+    // budget and go back to best-first, which then exceeds the budget again
+    branch_bound::NodeTree hybrid(
+            f,
+            root,
+            cli::NodeSelectionType::HYBRID,
+            depthFirst.peakBytes() + (bestFirst.peakBytes() - depthFirst.peakBytes()) / 4);
+    EXPECT_EQ(search(hybrid), makespans);
+    EXPECT_GT(hybrid.dives(), 1U);
+    EXPECT_EQ(hybrid.openNodes(), 0U);
+    EXPECT_LT(hybrid.peakBytes(), bestFirst.peakBytes());
+    // Only the live nodes and entries are counted, so the estimate drops once they are released
+    EXPECT_LT(hybrid.bytes(), hybrid.peakBytes() / 10);
+}
+
 // NOLINTEND(*-magic-numbers)
@@ -2,6 +2,19 @@
 
 #include "test_utils/runner.hpp"
 
+#include <fms/dd/state_history.hpp>
+#include <fms/dd/state_queue.hpp>
+#include <fms/dd/state_times.hpp>
+#include <fms/dd/transposition_table.hpp>
+#include <fms/dd/vertex_pool.hpp>
+#include <fms/scheduler.hpp>
+#include <fms/scheduler_exception.hpp>
+#include <fms/solvers/broadcast_line_solver.hpp>
+#include <fms/solvers/dd.hpp>
+
+#include <filesystem>
+#include <random>
+
 
 TEST(DD, simple0FixedOrder) {
     fms::cli::CLIArgs args;
@@ -59,4 +72,468 @@ TEST(DD, simple0SeedJobShop) {
     EXPECT_GT(solutions.size(), 0);
 }
 
+TEST(DD, stateTimesDecodeToStoredTimes) {
+    using fms::algorithms::paths::kASAPStartValue;
+    using fms::algorithms::paths::PathTimes;
+    using fms::dd::StateTimes;
+
+    constexpr std::size_t kVertices = 200;
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<std::size_t> vertexDist(0, kVertices - 1);
+    std::uniform_int_distribution<fms::delay> shiftDist(1, 1000);
+
+    PathTimes ASAPST(kVertices, kASAPStartValue);
+    PathTimes ALAPST(kVertices, 100000);
+    ASAPST.front() = 0;
+
+    std::vector<std::tuple<StateTimes::Ptr, PathTimes, PathTimes>> states;
+    states.emplace_back(StateTimes::create(ASAPST, ALAPST), ASAPST, ALAPST);
+    for (std::size_t i = 0; i < 3 * StateTimes::kMaxChainLength; ++i) {
+        // Branch from a random earlier state, as the DD does
+        std::uniform_int_distribution<std::size_t> parentDist(0, states.size() - 1);
+        const auto &[parent, parentASAPST, parentALAPST] = states[parentDist(rng)];
+        ASAPST = parentASAPST;
+        ALAPST = parentALAPST;
+
+        // Delay a range of vertices, and sometimes most of the graph
+        const auto first = vertexDist(rng);
+        const auto last = i % 10 == 0 ? kVertices : std::min(kVertices, first + 5);
+        const auto shift = shiftDist(rng);
+        for (auto v = first; v < last; ++v) {
+            ASAPST[v] = ASAPST[v] == kASAPStartValue ? shift : ASAPST[v] + shift;
+        }
+        ALAPST[vertexDist(rng)] -= shift;
+
+        auto times = StateTimes::create(parent, ASAPST, ALAPST);
+        EXPECT_EQ(times->lowerBound(), ASAPST.back());
+        states.emplace_back(std::move(times), ASAPST, ALAPST);
+    }
+
+    // Decode in the reverse order so that most of the times are not in the cache anymore
+    for (auto it = states.rbegin(); it != states.rend(); ++it) {
+        const auto &[times, expectedASAPST, expectedALAPST] = *it;
+        const auto decoded = times->decode();
+        EXPECT_EQ(decoded->ASAPST, expectedASAPST);
+        EXPECT_EQ(decoded->ALAPST, expectedALAPST);
+    }
+}
+
+TEST(DD, vertexPoolReleasesExhaustedDepths) {
+    using fms::dd::JobIdxToOpIdx;
+    using fms::dd::MachineToVertex;
+    using fms::dd::SharedVertex;
+    using fms::dd::StateTimes;
+    using fms::dd::Vertex;
+    using fms::dd::VertexPool;
+
+    auto pool = VertexPool::create();
+    const auto times = StateTimes::create({0, 1, 2}, {5, 5, 5});
+    auto makeVertex = [&](fms::dd::VertexId id, std::uint64_t depth) {
+        return pool->make(Vertex(id,
+                                 0,
+                                 fms::solvers::MachinesSequences{},
+                                 times,
+                                 JobIdxToOpIdx{},
+                                 {},
+                                 MachineToVertex{},
+                                 {},
+                                 depth));
+    };
+
+    std::vector<SharedVertex> depth1;
+    std::vector<SharedVertex> depth2;
+    for (fms::dd::VertexId i = 0; i < 3 * VertexPool::kMinSlabSize; ++i) {
+        depth1.push_back(makeVertex(i, 1));
+        depth2.push_back(makeVertex(i + 1000, 2));
+    }
+    EXPECT_EQ(pool->liveVertices(), depth1.size() + depth2.size());
+    EXPECT_EQ(depth1.back()->id(), 3 * VertexPool::kMinSlabSize - 1);
+    EXPECT_EQ(depth2.front()->vertexDepth(), 2);
+
+    // Copies share the vertex
+    SharedVertex copy = depth1.front();
+    EXPECT_EQ(copy.useCount(), 2);
+    depth1.front().reset();
+    EXPECT_EQ(copy->id(), 0);
+
+    const auto bytesBefore = pool->reservedBytes();
+    copy.reset();
+    depth1.clear();
+    EXPECT_EQ(pool->liveVertices(), depth2.size());
+    EXPECT_LT(pool->reservedBytes(), bytesBefore);
+
+    // Freed slots of a depth are reused
+    const auto bytesDepth2 = pool->reservedBytes();
+    depth2.pop_back();
+    depth2.push_back(makeVertex(2000, 2));
+    EXPECT_EQ(pool->reservedBytes(), bytesDepth2);
+    EXPECT_EQ(depth2.back()->id(), 2000);
+
+    // Vertices can outlive the owner of the pool
+    pool.reset();
+    EXPECT_EQ(depth2.back()->id(), 2000);
+    depth2.clear();
+}
+
+TEST(DD, bestStateQueuePopsLowestBoundDeepestFirst) {
+    using fms::dd::SharedVertex;
+    using fms::dd::StateQueue;
+    using fms::dd::StateTimes;
+    using fms::dd::Vertex;
+    using fms::dd::VertexPool;
+
+    auto pool = VertexPool::create();
+    auto makeVertex = [&](fms::dd::VertexId id, std::uint64_t depth, fms::delay lowerBound) {
+        return pool->make(Vertex(id,
+                                 0,
+                                 fms::solvers::MachinesSequences{},
+                                 StateTimes::create({0, lowerBound}, {lowerBound, lowerBound}),
+                                 fms::dd::JobIdxToOpIdx{},
+                                 {},
+                                 fms::dd::MachineToVertex{},
+                                 {},
+                                 depth));
+    };
+
+    StateQueue queue(fms::cli::DDExplorationType::BEST);
+    queue.push(makeVertex(0, 1, 10));
+    queue.push(makeVertex(1, 2, 10));
+    queue.push(makeVertex(2, 2, 5));
+    queue.push(makeVertex(3, 1, 5));
+    EXPECT_EQ(queue.size(), 4);
+    EXPECT_EQ(queue.minLowerBound(), 5);
+
+    const fms::dd::DDSolution solution(std::chrono::steady_clock::now(), 0, 2);
+    std::vector<fms::dd::VertexId> order;
+    while (!queue.empty()) {
+        order.push_back(queue.pop(solution)->id());
+        if (order.size() == 2) {
+            EXPECT_EQ(queue.minLowerBound(), 10);
+        }
+    }
+    EXPECT_EQ(order, (std::vector<fms::dd::VertexId>{2, 3, 1, 0}));
+}
+
+TEST(DD, jobsCompletionHashDependsOnValues) {
+    const std::hash<fms::dd::JobIdxToOpIdx> hasher;
+    EXPECT_NE(hasher({0, 0, 0}), hasher({1, 0, 0}));
+    EXPECT_NE(hasher({1, 0, 0}), hasher({0, 1, 0}));
+    EXPECT_NE(hasher({2, 1}), hasher({1, 2}));
+    EXPECT_EQ(hasher({3, 1, 4}), hasher({3, 1, 4}));
+}
+
+TEST(DD, parallelExpansionMatchesSequential) {
+    const auto bestMakespan = [](std::uint32_t threads) {
+        fms::cli::CLIArgs args;
+        args.algorithm = fms::cli::AlgorithmType::DD;
+        args.explorationType = fms::cli::DDExplorationType::BEST;
+        args.threads = threads;
+
+        const auto [solutions, problem, data] = TestUtils::runShopFullDetails(args, "simple/2.xml");
+        EXPECT_EQ(data["terminationReason"], fms::solvers::dd::TerminationStrings::kOptimal);
+        if (solutions.empty()) {
+            return fms::delay{-1};
+        }
+        return std::min_element(solutions.begin(),
+                                solutions.end(),
+                                [](const auto &a, const auto &b) {
+                                    return a.getMakespan() < b.getMakespan();
+                                })
+                ->getMakespan();
+    };
+
+    EXPECT_EQ(bestMakespan(4), bestMakespan(1));
+}
+
+TEST(DD, timeOutIsWallTime) {
+    fms::cli::CLIArgs args;
+    args.algorithm = fms::cli::AlgorithmType::DD;
+    args.threads = 4;
+    args.timeOut = std::chrono::milliseconds(300);
+
+    // With CPU time the threads would use up the time-out in a fraction of it
+    const auto [solutions, problem, data] =
+            TestUtils::runShopFullDetails(args, "maintenance/result1_1.xml");
+    EXPECT_EQ(data["terminationReason"], fms::solvers::dd::TerminationStrings::kTimeOut);
+    EXPECT_GE(data["searchTime"].get<float>(), 0.3F);
+}
+
+TEST(DD, widthBoundedDiagramsBoundTheOptimum) {
+    const auto run = [](fms::cli::DDExplorationType explorationType) {
+        fms::cli::CLIArgs args;
+        args.algorithm = fms::cli::AlgorithmType::DD;
+        args.explorationType = explorationType;
+        args.maxWidth = 2;
+
+        auto [solutions, problem, data] = TestUtils::runShopFullDetails(args, "simple/2.xml");
+        auto best = std::numeric_limits<fms::delay>::max();
+        for (const auto &solution : solutions) {
+            best = std::min(best, solution.getMakespan());
+        }
+        return std::make_tuple(best, data["lowerBound"].get<fms::delay>());
+    };
+
+    const auto [optimum, optimumLowerBound] = run(fms::cli::DDExplorationType::BEST);
+    EXPECT_EQ(optimum, optimumLowerBound);
+
+    const auto [restrictedBest, restrictedLowerBound] =
+            run(fms::cli::DDExplorationType::RESTRICTED);
+    EXPECT_GE(restrictedBest, optimum);
+    EXPECT_NE(restrictedBest, std::numeric_limits<fms::delay>::max());
+    EXPECT_LE(restrictedLowerBound, optimum);
+
+    const auto [relaxedBest, relaxedLowerBound] = run(fms::cli::DDExplorationType::RELAXED);
+    EXPECT_GE(relaxedBest, optimum);
+    EXPECT_LE(relaxedLowerBound, optimum);
+
+    // The merged states take their ids from the same counter as the expanded ones
+    fms::cli::CLIArgs args;
+    args.algorithm = fms::cli::AlgorithmType::DD;
+    args.explorationType = fms::cli::DDExplorationType::RELAXED;
+    args.maxWidth = 1;
+    args.algorithmOptions = {fms::solvers::dd::kStoreHistory};
+    auto parser = TestUtils::checkArguments(args, "simple/2.xml");
+    auto problem = fms::Scheduler::loadFlowShopInstance(args, parser);
+    auto [solutions, _, solverData] = fms::solvers::dd::solveWrap(problem, args, nullptr);
+    const auto data =
+            fms::solvers::castSolverData<fms::solvers::dd::DDSolverData>(std::move(solverData));
+
+    ASSERT_GT(data->allStates.size(), 1);
+    bool merged = false;
+    for (std::size_t i = 1; i < data->allStates.size(); ++i) {
+        EXPECT_LT(data->allStates[i - 1]->id(), data->allStates[i]->id());
+        merged = merged || data->allStates[i]->isRelaxed();
+    }
+    EXPECT_TRUE(merged);
+    EXPECT_GT(data->nextVertexId, data->allStates.back()->id());
+
+    // Every terminal state comes from a merge, so there is no solution to return but the bounds
+    // are still reported
+    EXPECT_TRUE(solutions.empty());
+    const auto [noSolutions, relaxedProblem, relaxedData] = TestUtils::runShopFullDetails(args, "simple/2.xml");
+    EXPECT_TRUE(noSolutions.empty());
+    EXPECT_EQ(relaxedData["terminationReason"], fms::solvers::dd::TerminationStrings::kNoSolution);
+    EXPECT_EQ(relaxedData["discardedLowerBound"], data->discardedLowerBound);
+    EXPECT_LE(relaxedData["lowerBound"].get<fms::delay>(), optimum);
+    EXPECT_FALSE(relaxedData.contains("upperBound"));
+
+    // A run stopped by the iteration limit keeps its data too
+    args.maxIterations = 1;
+    const auto [stopped, stoppedProblem, stoppedData] = TestUtils::runShopFullDetails(args, "simple/2.xml");
+    EXPECT_TRUE(stopped.empty());
+    EXPECT_EQ(stoppedData["terminationReason"], fms::solvers::dd::TerminationStrings::kTimeOut);
+    EXPECT_TRUE(stoppedData.contains("lowerBound"));
+}
+
+TEST(DD, widthBoundedModularRunsReportTheMissingSolution) {
+    for (const auto modularAlgorithm :
+         {fms::cli::ModularAlgorithmType::BROADCAST, fms::cli::ModularAlgorithmType::COCKTAIL}) {
+        fms::cli::CLIArgs args;
+        args.algorithm = fms::cli::AlgorithmType::DD;
+        args.algorithms = {fms::cli::AlgorithmType::DD};
+        args.modularAlgorithm = modularAlgorithm;
+        args.explorationType = fms::cli::DDExplorationType::RELAXED;
+        args.maxWidth = 2;
+
+        auto [solutions, data] = TestUtils::runLine(args, "modular/printer_cases/bookletA/0.xml");
+        EXPECT_TRUE(solutions.empty());
+        EXPECT_EQ(data["error"],
+                  fms::solvers::BroadcastLineSolver::ErrorStrings::kNoLocalSolution);
+    }
+}
+
+TEST(DD, resumedSearchMatchesUninterruptedSearch) {
+    const auto checkpoint = std::filesystem::temp_directory_path() / "fms-dd-checkpoint-test.bin";
+    std::filesystem::remove(checkpoint);
+
+    const auto run = [](fms::cli::CLIArgs args) {
+        args.algorithm = fms::cli::AlgorithmType::DD;
+        args.shopType = fms::cli::ShopType::FIXEDORDERSHOP;
+        args.explorationType = fms::cli::DDExplorationType::BEST;
+        auto [solutions, problem, data] = TestUtils::runShopFullDetails(args, "simple/0.xml");
+        std::vector<fms::delay> makespans;
+        for (const auto &solution : solutions) {
+            makespans.push_back(solution.getMakespan());
+        }
+        return std::make_tuple(makespans, data["terminationReason"].get<std::string>());
+    };
+
+    const auto [expected, expectedReason] = run({});
+    EXPECT_EQ(expectedReason, fms::solvers::dd::TerminationStrings::kOptimal);
+
+    fms::cli::CLIArgs interrupted;
+    interrupted.maxIterations = 50;
+    interrupted.checkpointFile = checkpoint.string();
+    const auto [partial, partialReason] = run(interrupted);
+    EXPECT_EQ(partialReason, fms::solvers::dd::TerminationStrings::kTimeOut);
+    ASSERT_TRUE(std::filesystem::exists(checkpoint));
+
+    fms::cli::CLIArgs resumed;
+    resumed.resumeFile = checkpoint.string();
+    const auto [makespans, reason] = run(resumed);
+    EXPECT_EQ(makespans, expected);
+    EXPECT_EQ(reason, expectedReason);
+
+    // The queue order depends on the exploration type, so it cannot change on resume
+    resumed.explorationType = fms::cli::DDExplorationType::BREADTH;
+    resumed.algorithm = fms::cli::AlgorithmType::DD;
+    resumed.shopType = fms::cli::ShopType::FIXEDORDERSHOP;
+    EXPECT_THROW(TestUtils::runShopFullDetails(resumed, "simple/0.xml"), FmsSchedulerException);
+
+    // A checkpoint cut at any point is rejected instead of resuming a different search
+    resumed.explorationType = fms::cli::DDExplorationType::BEST;
+    const auto size = std::filesystem::file_size(checkpoint);
+    const auto step = std::max<std::uintmax_t>(size / 64, 1);
+    for (auto truncated = size - 1; truncated > step; truncated -= step) {
+        std::filesystem::resize_file(checkpoint, truncated);
+        EXPECT_THROW(TestUtils::runShopFullDetails(resumed, "simple/0.xml"), FmsSchedulerException)
+                << "Checkpoint truncated to " << truncated << " bytes";
+    }
+
+    std::filesystem::remove(checkpoint);
+}
+
+TEST(DD, historyFileRecordsEveryCreatedState) {
+    const auto file = std::filesystem::temp_directory_path() / "fms-dd-history-test.ddh";
+
+    fms::cli::CLIArgs args;
+    args.algorithm = fms::cli::AlgorithmType::DD;
+    args.explorationType = fms::cli::DDExplorationType::BREADTH;
+    args.algorithmOptions = {fms::solvers::dd::kStoreHistory};
+    args.historyFile = file.string();
+    auto [solutions, problem, _] = TestUtils::runShopFullDetails(args, "simple/2.xml");
+
+    // Solve again to get the states kept in memory
+    auto [__, ___, solverData] = fms::solvers::dd::solveWrap(problem, args, nullptr);
+    const auto data =
+            fms::solvers::castSolverData<fms::solvers::dd::DDSolverData>(std::move(solverData));
+
+    fms::dd::HistoryReader history(file);
+    ASSERT_EQ(history.size(), data->allStates.size());
+    ASSERT_GT(history.size(), 1);
+    std::size_t discarded = 0;
+    for (std::size_t i = 0; i < history.size(); ++i) {
+        const auto record = history.at(i);
+        const auto &state = data->allStates.at(i);
+        EXPECT_EQ(record.id, state->id());
+        EXPECT_EQ(record.parentId, state->parentId());
+        EXPECT_EQ(record.depth, state->vertexDepth());
+        EXPECT_EQ(record.lowerBound, state->lowerBound());
+        EXPECT_EQ(record.lastOperation.has_value(), i > 0);
+        discarded += record.fate != fms::dd::StateFate::QUEUED ? 1 : 0;
+    }
+    EXPECT_GT(discarded, 0);
+
+    const auto &last = data->allStates.back();
+    EXPECT_EQ(history.find(last->id())->parentId, last->parentId());
+    EXPECT_FALSE(history.find(data->nextVertexId).has_value());
+
+    std::filesystem::remove(file);
+}
+
+TEST(DD, historyTreeAcceptsMissingIds) {
+    const auto file = std::filesystem::temp_directory_path() / "fms-dd-history-tree-test.ddh";
+    const auto checkpoint =
+            std::filesystem::temp_directory_path() / "fms-dd-history-tree-test.bin";
+
+    // Every record is either a root or the child of a recorded state
+    const auto readTree = [](fms::dd::HistoryReader &history) {
+        auto tree = fms::dd::HistoryTree::build(
+                history.size(), [&history](std::size_t position) { return history.at(position); });
+        EXPECT_EQ(tree.positions.size(), history.size());
+        std::size_t nrChildren = 0;
+        for (const auto &[parentId, children] : tree.children) {
+            EXPECT_TRUE(history.find(parentId).has_value());
+            nrChildren += children.size();
+        }
+        EXPECT_EQ(nrChildren + tree.roots.size(), history.size());
+        for (const auto rootId : tree.roots) {
+            const auto root = history.find(rootId).value();
+            EXPECT_TRUE(root.parentId == rootId || !history.find(root.parentId).has_value());
+        }
+        return tree;
+    };
+
+    // The ids of the pairwise merges are not recorded, only the one of the final merged state
+    fms::cli::CLIArgs relaxed;
+    relaxed.algorithm = fms::cli::AlgorithmType::DD;
+    relaxed.explorationType = fms::cli::DDExplorationType::RELAXED;
+    relaxed.maxWidth = 1;
+    relaxed.historyFile = file.string();
+    auto parser = TestUtils::checkArguments(relaxed, "simple/0.xml");
+    auto problem = fms::Scheduler::loadFlowShopInstance(relaxed, parser);
+    std::ignore = fms::solvers::dd::solveWrap(problem, relaxed, nullptr);
+    {
+        fms::dd::HistoryReader history(file);
+        ASSERT_GT(history.size(), 1);
+        EXPECT_GT(history.at(history.size() - 1).id, history.size() - 1);
+        const auto tree = readTree(history);
+        EXPECT_EQ(tree.roots, std::vector<fms::dd::VertexId>{0});
+        for (const auto &[id, position] : tree.positions) {
+            EXPECT_EQ(history.at(position).id, id);
+        }
+    }
+
+    // A resumed search only records the states created after the checkpoint
+    fms::cli::CLIArgs args;
+    args.algorithm = fms::cli::AlgorithmType::DD;
+    args.shopType = fms::cli::ShopType::FIXEDORDERSHOP;
+    args.explorationType = fms::cli::DDExplorationType::BEST;
+    args.maxIterations = 50;
+    args.checkpointFile = checkpoint.string();
+    std::ignore = TestUtils::runShop(args, "simple/0.xml");
+    ASSERT_TRUE(std::filesystem::exists(checkpoint));
+
+    args.maxIterations = std::numeric_limits<std::uint64_t>::max();
+    args.checkpointFile.clear();
+    args.resumeFile = checkpoint.string();
+    args.historyFile = file.string();
+    std::ignore = TestUtils::runShop(args, "simple/0.xml");
+    {
+        fms::dd::HistoryReader history(file);
+        ASSERT_GT(history.size(), 0);
+        EXPECT_GT(history.at(0).id, 0);
+        const auto tree = readTree(history);
+        EXPECT_FALSE(tree.roots.empty());
+        EXPECT_TRUE(history.find(tree.roots.front()).value().lastOperation.has_value());
+    }
+
+    std::filesystem::remove(file);
+    std::filesystem::remove(checkpoint);
+}
+
+TEST(DD, transpositionTableKeepsTheOptimum) {
+    const auto run = [](std::uint32_t transpositionMemory) {
+        fms::cli::CLIArgs args;
+        args.algorithm = fms::cli::AlgorithmType::DD;
+        args.shopType = fms::cli::ShopType::FIXEDORDERSHOP;
+        args.explorationType = fms::cli::DDExplorationType::BEST;
+        args.algorithmOptions = {fms::solvers::dd::kStoreHistory};
+        args.transpositionMemory = transpositionMemory;
+        auto [solutions, problem, _] = TestUtils::runShopFullDetails(args, "simple/0.xml");
+
+        auto [__, dataJSON, solverData] = fms::solvers::dd::solveWrap(problem, args, nullptr);
+        const auto data =
+                fms::solvers::castSolverData<fms::solvers::dd::DDSolverData>(std::move(solverData));
+        EXPECT_EQ(dataJSON["terminationReason"], fms::solvers::dd::TerminationStrings::kOptimal);
+
+        // The hashes kept while creating the states match the ones computed from scratch
+        for (const auto &state : data->allStates) {
+            EXPECT_EQ(state->transpositionHash(), fms::dd::zobrist::hash(*state));
+        }
+        return std::make_tuple(data->solution.bestUpperBound(), dataJSON, data->allStates.size());
+    };
 
+    const auto [expected, expectedJSON, expectedStates] = run(0);
+    EXPECT_FALSE(expectedJSON.contains("transpositionTable"));
+
+    const auto [best, dataJSON, states] = run(16);
+    EXPECT_EQ(best, expected);
+    ASSERT_TRUE(dataJSON.contains("transpositionTable"));
+    const auto &table = dataJSON["transpositionTable"];
+    EXPECT_GT(table["hits"].get<std::uint64_t>(), 0);
+    EXPECT_GT(table["entries"].get<std::size_t>(), 0);
+    EXPECT_LE(table["bytes"].get<std::size_t>(), std::size_t{16} << 20U);
+    // The states dropped by the table are not expanded
+    EXPECT_LT(states, expectedStates);
+}
@@ -2,6 +2,175 @@
 
 #include "test_utils/runner.hpp"
 
+#include <fms/algorithms/longest_path.hpp>
+#include <fms/scheduler.hpp>
+#include <fms/solvers/maintenance_heuristic.hpp>
+#include <fms/solvers/partial_solution.hpp>
+#include <fms/solvers/utils.hpp>
+
+#include <fmt/format.h>
+
+#include <optional>
+#include <set>
+
+using namespace fms;
+using namespace fms::solvers;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace {
+
+/// @brief Makespan of @p sequence from the longest paths of the whole graph, if it is feasible
+std::optional<delay> computeMakespan(const problem::Instance &problem,
+                                     problem::MachineId machine,
+                                     const Sequence &sequence,
+                                     const cg::ConstraintGraph &dg) {
+    PartialSolution solution({{machine, sequence}}, {});
+    auto result = algorithms::paths::computeASAPST(dg, solution.getAllAndInferredEdges(problem));
+    if (result.hasPositiveCycle()) {
+        return std::nullopt;
+    }
+    solution.setASAPST(std::move(result.times));
+    return solution.getRealMakespan(problem);
+}
+
+/// @brief First passes ordered by job, second passes ordered by job and after their first pass
+bool isValidSequence(const problem::Instance &problem,
+                     problem::MachineId machine,
+                     const Sequence &sequence) {
+    const auto &ops = problem.getMachineOperations(machine);
+    std::optional<problem::JobId> lastFirstPass;
+    std::optional<problem::JobId> lastSecondPass;
+    std::set<problem::JobId> doneFirstPass;
+    for (const auto &op : sequence) {
+        if (op.operationId == ops[0]) {
+            if (lastFirstPass && op.jobId <= *lastFirstPass) {
+                return false;
+            }
+            lastFirstPass = op.jobId;
+            doneFirstPass.insert(op.jobId);
+        }
+        if (op.operationId == ops[1]) {
+            if (!doneFirstPass.contains(op.jobId)
+                || (lastSecondPass && op.jobId <= *lastSecondPass)) {
+                return false;
+            }
+            lastSecondPass = op.jobId;
+        }
+    }
+    return true;
+}
+
+/// @brief NEH insertion pass that evaluates every candidate on the whole graph
+Sequence referenceUpdateSequence(const problem::Instance &problem,
+                                 problem::MachineId machine,
+                                 const Sequence &seedSequence,
+                                 const cg::ConstraintGraph &dg) {
+    Sequence builtSequence = {seedSequence.front()};
+    delay minMakespan = computeMakespan(problem, machine, seedSequence, dg).value();
+
+    for (std::size_t j = 1; j < seedSequence.size(); ++j) {
+        std::optional<Sequence> bestSequence;
+        for (std::size_t i = 0; i <= builtSequence.size(); ++i) {
+            Sequence testSequence = builtSequence;
+            testSequence.insert(testSequence.begin() + static_cast<std::ptrdiff_t>(i),
+                                seedSequence[j]);
+
+            Sequence evaluateSequence = testSequence;
+            evaluateSequence.insert(evaluateSequence.end(),
+                                    seedSequence.begin() + static_cast<std::ptrdiff_t>(j + 1),
+                                    seedSequence.end());
+            if (!isValidSequence(problem, machine, evaluateSequence)) {
+                continue;
+            }
+
+            const auto makespan = computeMakespan(problem, machine, evaluateSequence, dg);
+            if (makespan && *makespan < minMakespan) {
+                bestSequence = std::move(testSequence);
+                minMakespan = *makespan;
+            }
+        }
+
+        if (bestSequence) {
+            builtSequence = std::move(*bestSequence);
+        } else {
+            builtSequence.push_back(seedSequence[j]);
+        }
+    }
+    return builtSequence;
+}
+
+/// @brief Same steps as MNEH::solve with the trivial seed, on top of @ref referenceUpdateSequence
+PartialSolution referenceSolve(problem::Instance &problem, const cli::CLIArgs &args) {
+    SolversUtils::initProblemGraph(problem, false, args.pathThreads);
+    const auto machine = problem.getReEntrantMachines().front();
+    auto dg = problem.getDelayGraph();
+
+    // MINEH repairs the sequences of every pass, MINEHSIM only the chosen one
+    const bool maintenance = args.algorithm == cli::AlgorithmType::MINEH;
+    const bool finalMaintenance = maintenance || args.algorithm == cli::AlgorithmType::MINEHSIM;
+    const auto computeRealMakespan = [&](const Sequence &sequence) {
+        PartialSolution solution({{machine, sequence}}, {});
+        auto result =
+                algorithms::paths::computeASAPST(dg, solution.getAllAndInferredEdges(problem));
+        solution.setASAPST(std::move(result.times));
+        if (maintenance) {
+            auto [maintSolution, maintDg] =
+                    maintenance::triggerMaintenance(dg, problem, machine, solution, args);
+            solution = maintSolution;
+        }
+        return solution.getRealMakespan(problem);
+    };
+
+    const auto seedSequence =
+            SolversUtils::createTrivialSolution(problem).getMachineSequence(machine);
+    auto builtSequence = referenceUpdateSequence(problem, machine, seedSequence, dg);
+    auto builtMakespan = computeRealMakespan(builtSequence);
+    auto currMakespan = computeRealMakespan(seedSequence);
+    auto bestSequence = builtSequence;
+    while (builtMakespan < currMakespan) {
+        currMakespan = builtMakespan;
+        bestSequence = builtSequence;
+        builtSequence = referenceUpdateSequence(problem, machine, builtSequence, dg);
+        builtMakespan = computeRealMakespan(builtSequence);
+    }
+
+    PartialSolution solution({{machine, bestSequence}}, {});
+    auto result = algorithms::paths::computeASAPST(dg, solution.getAllAndInferredEdges(problem));
+    EXPECT_FALSE(result.hasPositiveCycle());
+    solution.setASAPST(std::move(result.times));
+    if (finalMaintenance) {
+        std::tie(solution, dg) =
+                maintenance::triggerMaintenance(dg, problem, machine, solution, args);
+        problem.updateDelayGraph(dg);
+    }
+    return solution;
+}
+
+/// @brief Checks that MNEH chooses the same sequence as @ref referenceSolve for each thread count
+void expectMatchesFullEvaluation(const cli::CLIArgs &args,
+                                 std::string_view fileName,
+                                 std::initializer_list<unsigned int> threads) {
+    auto referenceArgs = args;
+    auto parser = TestUtils::checkArguments(referenceArgs, fileName);
+    auto referenceProblem = Scheduler::loadFlowShopInstance(referenceArgs, parser);
+    const auto reference = referenceSolve(referenceProblem, referenceArgs);
+
+    for (const auto nrThreads : threads) {
+        SCOPED_TRACE(fmt::format("{} threads", nrThreads));
+        auto mnehArgs = args;
+        mnehArgs.threads = nrThreads;
+        const auto [solutions, problem, _] = TestUtils::runShopFullDetails(mnehArgs, fileName);
+        ASSERT_EQ(solutions.size(), 1);
+        EXPECT_EQ(solutions[0].getChosenSequencesPerMachine(),
+                  reference.getChosenSequencesPerMachine());
+        EXPECT_EQ(solutions[0].getRealMakespan(problem),
+                  reference.getRealMakespan(referenceProblem));
+    }
+}
+
+} // namespace
+
 TEST(MNEH, simple0) {
     fms::cli::CLIArgs args{.algorithm = fms::cli::AlgorithmType::MNEH};
     const auto [solutions, problem, _] = TestUtils::runShopFullDetails(args, "simple/0.xml");
@@ -10,3 +179,51 @@ TEST(MNEH, simple0) {
     const auto makespan = solutions[0].getRealMakespan(problem);
     EXPECT_EQ(makespan, 540);
 }
+
+TEST(MNEH, parallelInsertionMatchesSequential) {
+    fms::cli::CLIArgs args;
+    args.algorithm = fms::cli::AlgorithmType::MNEH;
+    const auto [sequential, problem, _] = TestUtils::runShopFullDetails(args, "simple/0.xml");
+
+    args.threads = 4;
+    const auto [parallel, parallelProblem, parallelData] =
+            TestUtils::runShopFullDetails(args, "simple/0.xml");
+    ASSERT_GT(sequential.size(), 0);
+    ASSERT_GT(parallel.size(), 0);
+
+    EXPECT_EQ(parallel[0].getRealMakespan(parallelProblem), 540);
+    EXPECT_EQ(parallel[0].getChosenSequencesPerMachine(),
+              sequential[0].getChosenSequencesPerMachine());
+
+    // With many jobs each thread evaluates several ranges of positions
+    fms::cli::CLIArgs manyJobsArgs;
+    manyJobsArgs.algorithm = fms::cli::AlgorithmType::MNEH;
+    const auto [manyJobsSequential, manyJobsProblem, manyJobsData] =
+            TestUtils::runShopFullDetails(manyJobsArgs, "maintenance/result1_1.xml");
+    ASSERT_GT(manyJobsSequential.size(), 0);
+    for (const auto nrThreads : {2U, 3U, 8U}) {
+        SCOPED_TRACE(fmt::format("{} threads", nrThreads));
+        manyJobsArgs.threads = nrThreads;
+        const auto [solutions, solvedProblem, data] =
+                TestUtils::runShopFullDetails(manyJobsArgs, "maintenance/result1_1.xml");
+        ASSERT_GT(solutions.size(), 0);
+        EXPECT_EQ(solutions[0].getChosenSequencesPerMachine(),
+                  manyJobsSequential[0].getChosenSequencesPerMachine());
+    }
+}
+
+TEST(MNEH, insertionsMatchFullEvaluation) {
+    fms::cli::CLIArgs args;
+    args.algorithm = fms::cli::AlgorithmType::MNEH;
+    expectMatchesFullEvaluation(args, "simple/0.xml", {1, 4});
+    expectMatchesFullEvaluation(args, "simple/1.xml", {1, 4});
+}
+
+TEST(MNEH, maintenanceInsertionsMatchFullEvaluation) {
+    fms::cli::CLIArgs args;
+    args.algorithm = fms::cli::AlgorithmType::MINEHSIM;
+    args.maintPolicyFile = "maintenance/maintproperties.xml";
+    expectMatchesFullEvaluation(args, "maintenance/result1_1.xml", {1, 3});
+}
+
+// NOLINTEND(*-magic-numbers)